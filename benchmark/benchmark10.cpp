@@ -0,0 +1,119 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/json_writer.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#if defined(__has_include)
+# if __has_include(<boost/json.hpp>)
+#  include <boost/json.hpp>
+#  define HAS_BOOST_JSON
+# endif
+#endif
+
+using V = boost::variant2::variant<boost::variant2::monostate, bool, long long, double, std::string>;
+
+template<class F> void test_( char const* name, std::vector<V> const& v, int M, F f )
+{
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    std::size_t s = 0;
+
+    for( int j = 0; j < M; ++j )
+    {
+        s += f( v );
+    }
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << name << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms; S=" << s << "\n";
+}
+
+int main()
+{
+    std::size_t const N = 100'000;
+    int const M = 100;
+
+    std::vector<V> v;
+
+    for( std::size_t i = 0; i < N; ++i )
+    {
+        switch( i % 5 )
+        {
+        case 0: v.emplace_back(); break;
+        case 1: v.emplace_back( i % 2 == 0 ); break;
+        case 2: v.emplace_back( static_cast<long long>( i * 7919 ) ); break;
+        case 3: v.emplace_back( static_cast<double>( i ) / 7 ); break;
+        default: v.emplace_back( "record " + std::to_string( i ) ); break;
+        }
+    }
+
+    std::cout << "N=" << N << ", M=" << M << ":\n";
+
+#if defined(HAS_BOOST_JSON)
+
+    test_( "serialize( value_from( v ) ): ", v, M, []( std::vector<V> const& v )
+    {
+        std::size_t s = 0;
+
+        for( auto const& x: v )
+        {
+            s += boost::json::serialize( boost::json::value_from( x ) ).size();
+        }
+
+        return s;
+    });
+
+#endif
+
+    test_( "       write_json, new string: ", v, M, []( std::vector<V> const& v )
+    {
+        std::size_t s = 0;
+
+        for( auto const& x: v )
+        {
+            std::string r;
+            boost::variant2::write_json( r, x );
+            s += r.size();
+        }
+
+        return s;
+    });
+
+    test_( "    write_json, reused string: ", v, M, []( std::vector<V> const& v )
+    {
+        static std::string r;
+        std::size_t s = 0;
+
+        for( auto const& x: v )
+        {
+            r.clear();
+            boost::variant2::write_json( r, x );
+            s += r.size();
+        }
+
+        return s;
+    });
+
+    test_( "      write_json, char buffer: ", v, M, []( std::vector<V> const& v )
+    {
+        char buffer[ 64 ];
+        std::size_t s = 0;
+
+        for( auto const& x: v )
+        {
+            s += boost::variant2::write_json( buffer, sizeof( buffer ), x );
+        }
+
+        return s;
+    });
+}
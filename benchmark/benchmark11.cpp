@@ -0,0 +1,141 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#if defined(__has_include)
+# if __has_include(<fmt/format.h>)
+#  define FMT_HEADER_ONLY
+#  include <fmt/format.h>
+# endif
+#endif
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/format.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using V = boost::variant2::variant<boost::variant2::monostate, long long, double, std::string>;
+
+template<class F> void test_( char const* name, std::vector<V> const& v, int M, F f )
+{
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    std::size_t s = 0;
+
+    for( int j = 0; j < M; ++j )
+    {
+        s += f( v );
+    }
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << name << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms; S=" << s << "\n";
+}
+
+int main()
+{
+    std::size_t const N = 100'000;
+    int const M = 100;
+
+    std::vector<V> v;
+
+    for( std::size_t i = 0; i < N; ++i )
+    {
+        switch( i % 4 )
+        {
+        case 0: v.emplace_back(); break;
+        case 1: v.emplace_back( static_cast<long long>( i * 7919 ) ); break;
+        case 2: v.emplace_back( static_cast<double>( i ) / 8 ); break;
+        default: v.emplace_back( "record " + std::to_string( i ) ); break;
+        }
+    }
+
+    std::cout << "N=" << N << ", M=" << M << ":\n";
+
+    test_( "          ostream, new stream: ", v, M, []( std::vector<V> const& v )
+    {
+        std::size_t s = 0;
+
+        for( auto const& x: v )
+        {
+            std::ostringstream os;
+            os << x;
+            s += os.str().size();
+        }
+
+        return s;
+    });
+
+    test_( "       ostream, reused stream: ", v, M, []( std::vector<V> const& v )
+    {
+        static std::ostringstream os;
+        std::size_t s = 0;
+
+        for( auto const& x: v )
+        {
+            os.str( std::string() );
+            os << x;
+            s += static_cast<std::size_t>( os.tellp() );
+        }
+
+        return s;
+    });
+
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+
+    test_( "               std::format_to: ", v, M, []( std::vector<V> const& v )
+    {
+        static std::string r;
+        std::size_t s = 0;
+
+        for( auto const& x: v )
+        {
+            r.clear();
+            std::format_to( std::back_inserter( r ), "{}", x );
+            s += r.size();
+        }
+
+        return s;
+    });
+
+#endif
+
+#if defined(FMT_VERSION)
+
+    test_( "                  fmt::format: ", v, M, []( std::vector<V> const& v )
+    {
+        std::size_t s = 0;
+
+        for( auto const& x: v )
+        {
+            s += fmt::format( "{}", x ).size();
+        }
+
+        return s;
+    });
+
+    test_( "fmt::format_to, memory_buffer: ", v, M, []( std::vector<V> const& v )
+    {
+        static fmt::memory_buffer r;
+        std::size_t s = 0;
+
+        for( auto const& x: v )
+        {
+            r.clear();
+            fmt::format_to( std::back_inserter( r ), "{}", x );
+            s += r.size();
+        }
+
+        return s;
+    });
+
+#endif
+}
@@ -0,0 +1,110 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/atomic_variant.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace boost::variant2;
+
+struct Config;
+
+using V = variant<monostate, int, double, Config const*>;
+
+// a variant guarded by a mutex
+
+class locked_variant
+{
+private:
+
+    mutable std::mutex mx_;
+    V v_;
+
+public:
+
+    V load() const
+    {
+        std::lock_guard<std::mutex> lock( mx_ );
+        return v_;
+    }
+
+    void store( V const& v )
+    {
+        std::lock_guard<std::mutex> lock( mx_ );
+        v_ = v;
+    }
+};
+
+// every thread performs K operations, one store in every 16
+
+template<class A> std::size_t worker( A& a, int k, int t )
+{
+    std::size_t s = 0;
+
+    for( int i = 0; i < k; ++i )
+    {
+        if( ( i & 15 ) == 0 )
+        {
+            if( i & 16 )
+            {
+                a.store( V( t + i ) );
+            }
+            else
+            {
+                a.store( V( 0.5 * i ) );
+            }
+        }
+        else
+        {
+            s += a.load().index();
+        }
+    }
+
+    return s;
+}
+
+template<class A> void test_( char const* name, int N, int K )
+{
+    A a;
+
+    std::vector<std::thread> th;
+    std::vector<std::size_t> r( N );
+
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    for( int t = 0; t < N; ++t )
+    {
+        th.emplace_back( [&, t]{ r[ t ] = worker( a, K, t ); } );
+    }
+
+    for( auto& x: th ) x.join();
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    std::size_t s = 0;
+    for( auto x: r ) s += x;
+
+    std::cout << name << std::setw( 2 ) << N << " threads: " << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms; S=" << s << "\n";
+}
+
+int main()
+{
+    int const M = 16'000'000; // total operations
+
+    std::cout << "sizeof(V)=" << sizeof(V) << ", atomic_variant is lock-free: " << std::boolalpha << atomic_variant<monostate, int, double, Config const*>::is_always_lock_free << "\n\n";
+
+    for( int N = 1; N <= 64; N *= 2 )
+    {
+        test_<locked_variant>( "      std::mutex, ", N, M / N );
+        test_<atomic_variant<monostate, int, double, Config const*>>( "  atomic_variant, ", N, M / N );
+    }
+}
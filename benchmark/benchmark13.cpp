@@ -0,0 +1,139 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/shared_variant.hpp>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__has_include)
+# if __has_include(<shared_mutex>) && __cplusplus >= 201703L
+#  include <shared_mutex>
+#  define HAS_SHARED_MUTEX
+# endif
+#endif
+
+using namespace boost::variant2;
+
+struct Quote
+{
+    long long seq;
+    double bid;
+    double ask;
+    long long volume[ 4 ];
+};
+
+struct Trade
+{
+    long long seq;
+    double price;
+    long long size;
+};
+
+using V = variant<monostate, Quote, Trade>;
+
+template<class Mx, class Lk> class locked_variant
+{
+private:
+
+    mutable Mx mx_;
+    V v_;
+
+public:
+
+    V load() const
+    {
+        Lk lock( mx_ );
+        return v_;
+    }
+
+    void store( V const& v )
+    {
+        std::lock_guard<Mx> lock( mx_ );
+        v_ = v;
+    }
+};
+
+struct seq_L
+{
+    long long operator()( monostate ) const { return 0; }
+    template<class T> long long operator()( T const& t ) const { return t.seq; }
+};
+
+// N readers poll the variant K times each, while one writer publishes new values
+
+template<class S> void test_( char const* name, int N, int K )
+{
+    S s;
+
+    std::atomic<int> active( N );
+    long long writes = 0;
+
+    std::vector<std::thread> th;
+    std::vector<long long> r( N );
+
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    for( int t = 0; t < N; ++t )
+    {
+        th.emplace_back( [&, t]{
+
+            long long x = 0;
+
+            for( int i = 0; i < K; ++i )
+            {
+                x += visit( seq_L(), s.load() );
+            }
+
+            r[ t ] = x;
+            --active;
+        });
+    }
+
+    while( active.load() > 0 )
+    {
+        ++writes;
+
+        if( writes % 4 == 0 )
+        {
+            s.store( Trade{ writes, 1.5, 100 } );
+        }
+        else
+        {
+            s.store( Quote{ writes, 1.0, 2.0, { 1, 2, 3, 4 } } );
+        }
+    }
+
+    for( auto& x: th ) x.join();
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << name << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms; " << writes << " writes\n";
+}
+
+int main()
+{
+    int const N = 32;
+    int const K = 1'000'000;
+
+    std::cout << "sizeof(V)=" << sizeof(V) << ", " << N << " readers, " << K << " reads each:\n";
+
+    test_< locked_variant<std::mutex, std::lock_guard<std::mutex>> >( "        std::mutex: ", N, K );
+
+#if defined(HAS_SHARED_MUTEX)
+
+    test_< locked_variant<std::shared_mutex, std::shared_lock<std::shared_mutex>> >( " std::shared_mutex: ", N, K );
+
+#endif
+
+    test_< shared_variant<monostate, Quote, Trade> >( "    shared_variant: ", N, K );
+}
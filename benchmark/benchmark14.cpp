@@ -0,0 +1,151 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/mailbox.hpp>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace boost::variant2;
+
+struct Tick
+{
+    int instrument;
+    double price;
+};
+
+struct Order
+{
+    int id;
+    int quantity;
+    double limit;
+};
+
+struct Cancel
+{
+    int id;
+};
+
+using V = variant<Tick, Order, Cancel>;
+
+// the baseline, a std::deque guarded by a mutex
+
+class locked_queue
+{
+private:
+
+    std::mutex mx_;
+    std::deque<V> q_;
+
+public:
+
+    explicit locked_queue( std::size_t /*capacity*/ )
+    {
+    }
+
+    template<class U> bool try_push( U&& u )
+    {
+        std::lock_guard<std::mutex> lock( mx_ );
+        q_.emplace_back( std::forward<U>(u) );
+        return true;
+    }
+
+    template<class F> std::size_t drain( F& f )
+    {
+        std::deque<V> q;
+
+        {
+            std::lock_guard<std::mutex> lock( mx_ );
+            q.swap( q_ );
+        }
+
+        for( auto& v: q )
+        {
+            visit( f, v );
+        }
+
+        return q.size();
+    }
+};
+
+struct handler
+{
+    long long s = 0;
+
+    void operator()( Tick const& t ) { s += t.instrument; }
+    void operator()( Order const& o ) { s += o.quantity; }
+    void operator()( Cancel const& c ) { s -= c.id; }
+};
+
+// each producer sends runs of 8 ticks followed by an order or a cancel
+
+template<class Q> void producer( Q& q, int k )
+{
+    for( int i = 0; i < k; ++i )
+    {
+        int j = i % 9;
+
+        if( j < 8 )
+        {
+            while( !q.try_push( Tick{ j, 1.0 } ) ) std::this_thread::yield();
+        }
+        else if( i % 2 )
+        {
+            while( !q.try_push( Order{ i, 1, 1.0 } ) ) std::this_thread::yield();
+        }
+        else
+        {
+            while( !q.try_push( Cancel{ 1 } ) ) std::this_thread::yield();
+        }
+    }
+}
+
+template<class Q> void test_( char const* name, int N, int K )
+{
+    Q q( 4096 );
+
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> th;
+
+    for( int t = 0; t < N; ++t )
+    {
+        th.emplace_back( [&]{ producer( q, K ); } );
+    }
+
+    handler h;
+    long long n = 0;
+
+    while( n < static_cast<long long>( N ) * K )
+    {
+        std::size_t m = q.drain( h );
+        if( m == 0 ) std::this_thread::yield();
+        n += m;
+    }
+
+    for( auto& x: th ) x.join();
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << name << std::setw( 2 ) << N << " producers: " << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms; S=" << h.s << "\n";
+}
+
+int main()
+{
+    int const M = 9'000'000; // total messages
+
+    for( int N = 1; N <= 16; N *= 2 )
+    {
+        test_<locked_queue>( "std::deque + std::mutex, ", N, M / N );
+        test_<mailbox<Tick, Order, Cancel>>( "                mailbox, ", N, M / N );
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/parallel.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+using namespace boost::variant2;
+
+struct Trade
+{
+    double price;
+    double quantity;
+};
+
+struct Quote
+{
+    double bid;
+    double ask;
+    int level;
+};
+
+struct Fee
+{
+    double amount;
+};
+
+using V = variant<Trade, Quote, Fee, long long>;
+
+struct value_F
+{
+    double operator()( Trade const& t ) const { return t.price * t.quantity; }
+    double operator()( Quote const& q ) const { return ( q.ask - q.bid ) * q.level; }
+    double operator()( Fee const& f ) const { return -f.amount; }
+    double operator()( long long x ) const { return static_cast<double>( x % 7 ); }
+};
+
+struct plus_Op
+{
+    double operator()( double x, double y ) const { return x + y; }
+};
+
+template<class F> void test_( char const* name, std::vector<V> const& v, int M, F f )
+{
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    double s = 0;
+
+    for( int j = 0; j < M; ++j )
+    {
+        s += f( v );
+    }
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << name << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms; S=" << std::setprecision( 12 ) << s << "\n";
+}
+
+int main()
+{
+    std::size_t const N = 20'000'000;
+    int const M = 5;
+
+    std::vector<V> v;
+    v.reserve( N );
+
+    unsigned x = 1;
+
+    for( std::size_t i = 0; i < N; ++i )
+    {
+        x = x * 1103515245u + 12345u;
+
+        switch( ( x >> 16 ) % 4 )
+        {
+        case 0: v.emplace_back( Trade{ 1.0 + i % 100, 2.0 } ); break;
+        case 1: v.emplace_back( Quote{ 1.0, 1.5, static_cast<int>( i % 5 ) } ); break;
+        case 2: v.emplace_back( Fee{ 0.25 } ); break;
+        default: v.emplace_back( static_cast<long long>( i ) ); break;
+        }
+    }
+
+    std::cout << "N=" << N << ", M=" << M << ", " << std::thread::hardware_concurrency() << " hardware threads:\n";
+
+    test_( "                 sequential visit: ", v, M, []( std::vector<V> const& v )
+    {
+        double s = 0;
+
+        for( auto const& x: v )
+        {
+            s += visit( value_F(), x );
+        }
+
+        return s;
+    });
+
+    for( std::size_t k: { 1, 2, 4, 0 } )
+    {
+        std::string name = "parallel_visit_reduce, threads=" + std::to_string( k ) + ": ";
+
+        test_( name.c_str(), v, M, [k]( std::vector<V> const& v )
+        {
+            return parallel_visit_reduce( v.data(), v.size(), 0.0, plus_Op(), value_F(), k );
+        });
+    }
+}
@@ -0,0 +1,106 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/pmr.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using namespace boost::variant2;
+
+template<class S, class I> struct size_L
+{
+    std::size_t operator()( long long x ) const { return static_cast<std::size_t>( x ); }
+    std::size_t operator()( S const& s ) const { return s.size(); }
+    std::size_t operator()( I const& v ) const { return v.size(); }
+};
+
+// each request builds N values, visits them, and throws them away
+
+template<class Vec, class S, class I> std::size_t request( Vec& v, int N, int k )
+{
+    for( int i = 0; i < N; ++i )
+    {
+        switch( ( i + k ) % 3 )
+        {
+        case 0: v.emplace_back( static_cast<long long>( i ) ); break;
+        case 1: v.emplace_back( in_place_index_t<1>(), 40 + i % 16, 'x' ); break;
+        default: v.emplace_back( in_place_index_t<2>(), 4 + i % 8, i ); break;
+        }
+    }
+
+    std::size_t r = 0;
+
+    for( auto const& x: v )
+    {
+        r += visit( size_L<S, I>(), x );
+    }
+
+    return r;
+}
+
+std::size_t test_heap( int N, int K )
+{
+    using S = std::string;
+    using I = std::vector<int>;
+
+    std::size_t r = 0;
+
+    for( int k = 0; k < K; ++k )
+    {
+        std::vector< variant<long long, S, I> > v;
+        r += request<decltype(v), S, I>( v, N, k );
+    }
+
+    return r;
+}
+
+std::size_t test_pmr( int N, int K )
+{
+    using S = std::pmr::string;
+    using I = std::pmr::vector<int>;
+
+    std::size_t r = 0;
+
+    std::vector<unsigned char> buffer( 1 << 20 );
+
+    for( int k = 0; k < K; ++k )
+    {
+        std::pmr::monotonic_buffer_resource mr( buffer.data(), buffer.size() );
+
+        std::pmr::vector< pmr::variant<long long, S, I> > v( &mr );
+        r += request<decltype(v), S, I>( v, N, k );
+    }
+
+    return r;
+}
+
+template<class F> void test( char const* name, F f, int N, int K )
+{
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    std::size_t r = f( N, K );
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << name << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms; r=" << r << "\n";
+}
+
+int main()
+{
+    int const N = 1000;
+    int const K = 20'000;
+
+    std::cout << K << " requests of " << N << " values:\n";
+
+    test( "          std::vector + variant: ", test_heap, N, K );
+    test( "std::pmr::vector + pmr::variant: ", test_pmr, N, K );
+}
@@ -0,0 +1,145 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/recursive.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+
+using namespace boost::variant2;
+
+// expression trees whose nodes come from the heap
+
+struct BinaryH;
+
+using ExprH = variant<long, std::unique_ptr<BinaryH>>;
+
+struct BinaryH
+{
+    char op;
+    ExprH lhs;
+    ExprH rhs;
+};
+
+// expression trees whose nodes come from an arena
+
+struct BinaryA;
+
+using ExprA = variant<long, recursive<BinaryA>>;
+
+struct BinaryA
+{
+    char op;
+    ExprA lhs;
+    ExprA rhs;
+};
+
+ExprH make_heap( int depth, long& next )
+{
+    if( depth == 0 ) return ++next;
+
+    ExprH lhs = make_heap( depth - 1, next );
+    ExprH rhs = make_heap( depth - 1, next );
+
+    return std::unique_ptr<BinaryH>( new BinaryH{ depth % 2? '+': '^', std::move( lhs ), std::move( rhs ) } );
+}
+
+ExprA make_arena( bump_arena& a, int depth, long& next )
+{
+    if( depth == 0 ) return ++next;
+
+    ExprA lhs = make_arena( a, depth - 1, next );
+    ExprA rhs = make_arena( a, depth - 1, next );
+
+    return recursive<BinaryA>( a, BinaryA{ depth % 2? '+': '^', std::move( lhs ), std::move( rhs ) } );
+}
+
+struct eval_F
+{
+    long operator()( long x ) const
+    {
+        return x;
+    }
+
+    template<class B> long eval( B const& b ) const
+    {
+        long x = visit( *this, b.lhs );
+        long y = visit( *this, b.rhs );
+
+        return b.op == '+'? x + y: x ^ y;
+    }
+
+    long operator()( std::unique_ptr<BinaryH> const& p ) const
+    {
+        return eval( *p );
+    }
+
+    long operator()( BinaryA const& b ) const
+    {
+        return eval( b );
+    }
+};
+
+// each query builds a tree of 2^D - 1 nodes, evaluates it, and discards it
+
+long test_heap( int D, int K )
+{
+    long r = 0;
+
+    for( int k = 0; k < K; ++k )
+    {
+        long next = k;
+        ExprH e = make_heap( D, next );
+
+        r += visit( eval_F(), e );
+    }
+
+    return r;
+}
+
+long test_arena( int D, int K )
+{
+    long r = 0;
+
+    bump_arena a;
+
+    for( int k = 0; k < K; ++k )
+    {
+        long next = k;
+        ExprA e = make_arena( a, D, next );
+
+        r += visit( eval_F(), e );
+
+        a.release();
+    }
+
+    return r;
+}
+
+template<class F> void test( char const* name, F f, int D, int K )
+{
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    long r = f( D, K );
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << name << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms; r=" << r << "\n";
+}
+
+int main()
+{
+    int const D = 16;
+    int const K = 200;
+
+    std::cout << K << " trees of " << ( 1 << D ) - 1 << " nodes:\n";
+
+    test( "          unique_ptr: ", test_heap, D, K );
+    test( "recursive/bump_arena: ", test_arena, D, K );
+}
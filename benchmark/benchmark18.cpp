@@ -0,0 +1,98 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace boost::variant2;
+
+// a potentially throwing move constructor makes the variant double-buffered
+
+struct Y
+{
+    Y() {}
+    Y( Y const& ) {}
+    Y( Y&& ) noexcept( false ) {}
+
+    Y& operator=( Y const& ) { return *this; }
+    Y& operator=( Y&& ) { return *this; }
+};
+
+using V1 = variant<int, std::string>;
+using V2 = variant<int, std::string, Y>;
+
+struct op_assign
+{
+    template<class V> void operator()( V& v, std::string const& s ) const
+    {
+        v = s;
+    }
+};
+
+struct op_assign_same
+{
+    template<class V> void operator()( V& v, std::string const& s ) const
+    {
+        v.assign_same_or_emplace( s );
+    }
+};
+
+// a table of variants whose string cells are repeatedly overwritten
+
+template<class V, class Op> std::size_t test( std::vector<std::string> const& src, int N, int K )
+{
+    std::vector<V> v( N, V( src[ 0 ] ) );
+
+    std::size_t r = 0;
+
+    for( int k = 0; k < K; ++k )
+    {
+        for( int i = 0; i < N; ++i )
+        {
+            Op()( v[ i ], src[ ( i + k ) % src.size() ] );
+        }
+
+        r += get<std::string>( v[ k % N ] ).size();
+    }
+
+    return r;
+}
+
+template<class F> void test( char const* name, F f, std::vector<std::string> const& src, int N, int K )
+{
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    std::size_t r = f( src, N, K );
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << name << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms; r=" << r << "\n";
+}
+
+int main()
+{
+    int const N = 1000;
+    int const K = 20'000;
+
+    std::vector<std::string> src;
+
+    for( int i = 0; i < 7; ++i )
+    {
+        src.push_back( std::string( 32 + i * 8, 'a' + i ) );
+    }
+
+    std::cout << K << " passes over " << N << " strings:\n";
+
+    test( "                 single buffer, operator=: ", test<V1, op_assign>, src, N, K );
+    test( "    single buffer, assign_same_or_emplace: ", test<V1, op_assign_same>, src, N, K );
+    test( "                 double buffer, operator=: ", test<V2, op_assign>, src, N, K );
+    test( "    double buffer, assign_same_or_emplace: ", test<V2, op_assign_same>, src, N, K );
+}
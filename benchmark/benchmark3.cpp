@@ -0,0 +1,113 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/variant_vector.hpp>
+#include <type_traits>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <string>
+#include <stdexcept>
+
+template<class T> struct is_numeric: std::integral_constant<bool, std::is_integral<T>::value || std::is_floating_point<T>::value>
+{
+};
+
+template<class T, class U> struct have_addition: std::integral_constant<bool, is_numeric<T>::value && is_numeric<U>::value>
+{
+};
+
+template<class T, class U, class E = std::enable_if_t<have_addition<T, U>::value>> auto add( T const& t, U const& u )
+{
+    return t + u;
+}
+
+template<class T, class U, class E = std::enable_if_t<!have_addition<T, U>::value>> double add( T const& /*t*/, U const& /*u*/ )
+{
+    throw std::logic_error( "Invalid addition" );
+}
+
+template<class V> void fill( V& w, long long N )
+{
+    for( long long i = 0; i < N; ++i )
+    {
+        if( i % 7 == 0 )
+        {
+            w.push_back( i / 7 );
+        }
+        else
+        {
+            w.push_back( i / 7.0 );
+        }
+    }
+}
+
+template<class... T> void test_vector( long long N )
+{
+    std::vector<boost::variant2::variant<T...>> w;
+    // lack of reserve is deliberate
+
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    fill( w, N );
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    double s = 0.0;
+
+    for( long long i = 0; i < N; ++i )
+    {
+        s = visit( [&]( auto const& x ){ return add( s, x ); }, w[ i ] );
+    }
+
+    auto tp3 = std::chrono::high_resolution_clock::now();
+
+    std::cout << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms fill, ";
+    std::cout << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp3 - tp2 ).count() << " ms visit; S=" << s << "\n";
+}
+
+template<class... T> void test_variant_vector( long long N )
+{
+    boost::variant2::variant_vector<T...> w;
+    // lack of reserve is deliberate
+
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    fill( w, N );
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    double s = 0.0;
+
+    for_each_visit( [&]( auto const& x ){ s = add( s, x ); }, w );
+
+    auto tp3 = std::chrono::high_resolution_clock::now();
+
+    std::cout << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms fill, ";
+    std::cout << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp3 - tp2 ).count() << " ms visit; S=" << s << "\n";
+}
+
+template<class... T> void test( long long N )
+{
+    std::cout << "N=" << N << ", sizeof(variant)=" << sizeof( boost::variant2::variant<T...> ) << ":\n";
+
+    std::cout << "  std::vector<variant>: "; test_vector<T...>( N );
+    std::cout << "        variant_vector: "; test_variant_vector<T...>( N );
+
+    std::cout << '\n';
+}
+
+int main()
+{
+    long long const N = 10'000'000LL;
+
+    test<long long, double>( N );
+    test<std::nullptr_t, long long, double, std::string, std::vector<std::string>, std::map<std::string, std::string>>( N );
+}
@@ -0,0 +1,92 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <cstdint>
+
+template<int K> struct X
+{
+    int v_;
+};
+
+using V = boost::variant2::variant<X<0>, X<1>, X<2>, X<3>, X<4>, X<5>, X<6>, X<7>>;
+
+struct binary_op
+{
+    template<int K1, int K2> long long operator()( X<K1> const& x1, X<K2> const& x2 ) const
+    {
+        return ( K1 + 1 ) * x1.v_ - ( K2 + 1 ) * x2.v_;
+    }
+};
+
+long long eval_flat( V const& v1, V const& v2 )
+{
+    return visit( binary_op(), v1, v2 );
+}
+
+long long eval_nested( V const& v1, V const& v2 )
+{
+    return visit( [&]( auto const& x1 ){ return visit( [&]( auto const& x2 ){ return binary_op()( x1, x2 ); }, v2 ); }, v1 );
+}
+
+template<class F> void test_( char const* name, std::vector<V> const& w1, std::vector<V> const& w2, F f, int M )
+{
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    long long s = 0;
+
+    for( int j = 0; j < M; ++j )
+    {
+        for( std::size_t i = 0, n = w1.size(); i < n; ++i )
+        {
+            s += f( w1[ i ], w2[ i ] );
+        }
+    }
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << name << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms; S=" << s << "\n";
+}
+
+template<int K> V make( int k, int v )
+{
+    return k == K? V( X<K>{ v } ): make<K + 1>( k, v );
+}
+
+template<> V make<8>( int /*k*/, int v )
+{
+    return V( X<0>{ v } );
+}
+
+int main()
+{
+    int const N = 1'000'000;
+    int const M = 100;
+
+    std::mt19937 rng;
+    std::uniform_int_distribution<int> dist( 0, 7 );
+
+    std::vector<V> w1, w2;
+
+    for( int i = 0; i < N; ++i )
+    {
+        w1.push_back( make<0>( dist( rng ), i ) );
+        w2.push_back( make<0>( dist( rng ), i % 1000 ) );
+    }
+
+    std::cout << "N=" << N << ", M=" << M << ", BOOST_VARIANT2_MAX_FLAT_VISIT=" << BOOST_VARIANT2_MAX_FLAT_VISIT << ":\n";
+
+    test_( "  visit( f, v1, v2 ): ", w1, w2, eval_flat, M );
+    test_( "   nested visit( f ): ", w1, w2, eval_nested, M );
+
+    std::cout << '\n';
+}
@@ -0,0 +1,164 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+
+template<int K, class S> struct X
+{
+    int v_;
+};
+
+template<class S> using V = boost::variant2::variant<X<0, S>, X<1, S>, X<2, S>, X<3, S>, X<4, S>, X<5, S>, X<6, S>, X<7, S>, X<8, S>, X<9, S>, X<10, S>, X<11, S>>;
+
+namespace boost
+{
+namespace variant2
+{
+
+template<class S> struct variant_dispatch_strategy< V<S> >
+{
+    using type = S;
+};
+
+} // namespace variant2
+} // namespace boost
+
+struct F
+{
+    template<int K, class S> long long operator()( X<K, S> const& x ) const
+    {
+        return ( K + 1 ) * x.v_;
+    }
+};
+
+template<int K, class S> struct maker
+{
+    static V<S> make( int k, int v )
+    {
+        return k == K? V<S>( X<K, S>{ v } ): maker<K + 1, S>::make( k, v );
+    }
+};
+
+template<class S> struct maker<12, S>
+{
+    static V<S> make( int /*k*/, int v )
+    {
+        return V<S>( X<0, S>{ v } );
+    }
+};
+
+template<class S, bool L = false> void test( char const* name, std::vector<int> const& ks, int M )
+{
+    std::vector<V<S>> w;
+
+    for( std::size_t i = 0; i < ks.size(); ++i )
+    {
+        w.push_back( maker<0, S>::make( ks[ i ], static_cast<int>( i % 17 ) ) );
+    }
+
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    long long s = 0;
+
+    for( int j = 0; j < M; ++j )
+    {
+        for( std::size_t i = 0, n = w.size(); i < n; ++i )
+        {
+            s += L? boost::variant2::visit_likely<0>( F(), w[ i ] ): visit( F(), w[ i ] );
+        }
+    }
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << name << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms; S=" << s << "\n";
+}
+
+void test_all( std::vector<int> const& ks, int M )
+{
+    test<boost::variant2::switch_dispatch>( "  switch:         ", ks, M );
+    test<boost::variant2::jump_table_dispatch>( "  jump table:     ", ks, M );
+    test<boost::variant2::binary_search_dispatch>( "  binary search:  ", ks, M );
+    test<boost::variant2::linear_dispatch<>>( "  linear:         ", ks, M );
+    test<boost::variant2::linear_dispatch<11, 10>>( "  linear<11, 10>: ", ks, M );
+    test<boost::variant2::switch_dispatch, true>( "  visit_likely<0>:", ks, M );
+}
+
+int main()
+{
+    int const N = 1'000'000;
+    int const M = 100;
+
+    std::mt19937 rng;
+
+    {
+        std::uniform_int_distribution<int> dist( 0, 11 );
+
+        std::vector<int> ks;
+
+        for( int i = 0; i < N; ++i )
+        {
+            ks.push_back( dist( rng ) );
+        }
+
+        std::cout << "Uniform distribution over 12 alternatives:\n";
+        test_all( ks, M );
+        std::cout << '\n';
+    }
+
+    {
+        // 95% first alternative, 4% second, 1% spread over the rest
+        std::uniform_int_distribution<int> dist( 0, 99 );
+        std::uniform_int_distribution<int> dist2( 2, 11 );
+
+        std::vector<int> ks;
+
+        for( int i = 0; i < N; ++i )
+        {
+            int r = dist( rng );
+            ks.push_back( r < 95? 0: r < 99? 1: dist2( rng ) );
+        }
+
+        std::cout << "Skewed distribution over 12 alternatives:\n";
+        test_all( ks, M );
+        std::cout << '\n';
+    }
+
+    {
+        // 95% last alternative, 4% second to last, 1% spread over the rest
+        std::uniform_int_distribution<int> dist( 0, 99 );
+        std::uniform_int_distribution<int> dist2( 0, 9 );
+
+        std::vector<int> ks;
+
+        for( int i = 0; i < N; ++i )
+        {
+            int r = dist( rng );
+            ks.push_back( r < 95? 11: r < 99? 10: dist2( rng ) );
+        }
+
+        std::cout << "Skewed distribution towards the last alternatives:\n";
+        test_all( ks, M );
+        std::cout << '\n';
+    }
+
+    {
+        std::vector<int> ks;
+
+        for( int i = 0; i < N; ++i )
+        {
+            ks.push_back( 0 );
+        }
+
+        std::cout << "Single alternative:\n";
+        test_all( ks, M );
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/algorithm.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <random>
+#include <cstddef>
+
+using V = boost::variant2::variant<int, float, double, long long, char, short, unsigned, bool>;
+
+template<class F> void test( char const* name, std::vector<V> const& w, F f, int M )
+{
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    std::size_t s = 0;
+
+    for( int j = 0; j < M; ++j )
+    {
+        std::array<std::size_t, 8> c = f( w );
+        s += c[ j % 8 ];
+    }
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << name << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms; S=" << s << "\n";
+}
+
+std::array<std::size_t, 8> count_visit( std::vector<V> const& w )
+{
+    std::array<std::size_t, 8> c = {{}};
+
+    for( auto const& v: w )
+    {
+        visit( [&]( auto const& x ){ ++c[ V( x ).index() ]; }, v );
+    }
+
+    return c;
+}
+
+std::array<std::size_t, 8> count_index( std::vector<V> const& w )
+{
+    std::array<std::size_t, 8> c = {{}};
+
+    for( auto const& v: w )
+    {
+        ++c[ v.index() ];
+    }
+
+    return c;
+}
+
+std::array<std::size_t, 8> count_by_index( std::vector<V> const& w )
+{
+    return boost::variant2::count_by_index( w.data(), w.size() );
+}
+
+int main()
+{
+    int const N = 100'000;
+    int const M = 5'000;
+
+    std::mt19937 rng;
+
+    for( int k = 0; k < 2; ++k )
+    {
+        std::vector<V> w;
+
+        if( k == 0 )
+        {
+            std::uniform_int_distribution<int> dist( 0, 7 );
+
+            for( int i = 0; i < N; ++i )
+            {
+                switch( dist( rng ) )
+                {
+                case 0: w.push_back( 0 ); break;
+                case 1: w.push_back( 1.0f ); break;
+                case 2: w.push_back( 2.0 ); break;
+                case 3: w.push_back( 3LL ); break;
+                case 4: w.push_back( 'x' ); break;
+                case 5: w.push_back( static_cast<short>( 5 ) ); break;
+                case 6: w.push_back( 6u ); break;
+                default: w.push_back( true ); break;
+                }
+            }
+
+            std::cout << "N=" << N << ", M=" << M << ", random indices:\n";
+        }
+        else
+        {
+            for( int i = 0; i < N; ++i )
+            {
+                w.push_back( V( i ) );
+            }
+
+            std::cout << "N=" << N << ", M=" << M << ", single alternative:\n";
+        }
+
+        test( "              visit: ", w, count_visit, M );
+        test( "     ++c[ index() ]: ", w, count_index, M );
+        test( "     count_by_index: ", w, count_by_index, M );
+
+        std::cout << '\n';
+    }
+}
@@ -0,0 +1,103 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/boxed_value.hpp>
+#include <type_traits>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdexcept>
+
+struct Object
+{
+    double v;
+};
+
+template<class T> struct is_numeric: std::integral_constant<bool, std::is_integral<T>::value || std::is_floating_point<T>::value>
+{
+};
+
+template<class T, class U> struct have_addition: std::integral_constant<bool, is_numeric<T>::value && is_numeric<U>::value>
+{
+};
+
+template<class T, class U, class E = std::enable_if_t<have_addition<T, U>::value>> auto add( T const& t, U const& u )
+{
+    return t + u;
+}
+
+inline double add( double t, Object* p )
+{
+    return t + p->v;
+}
+
+template<class T, class U, class E = std::enable_if_t<!have_addition<T, U>::value>> double add( T const& /*t*/, U const& /*u*/ )
+{
+    throw std::logic_error( "Invalid addition" );
+}
+
+template<class V> void test_( long long N, Object* p )
+{
+    std::vector<V> w;
+    // lack of reserve is deliberate
+
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    for( long long i = 0; i < N; ++i )
+    {
+        if( i % 7 == 0 )
+        {
+            w.push_back( static_cast<int>( i / 7 ) );
+        }
+        else if( i % 7 == 1 )
+        {
+            w.push_back( p );
+        }
+        else
+        {
+            w.push_back( i / 7.0 );
+        }
+    }
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    double s = 0.0;
+
+    for( long long i = 0; i < N; ++i )
+    {
+        s = visit( [&]( auto const& x ){ return add( s, x ); }, w[ i ] );
+    }
+
+    auto tp3 = std::chrono::high_resolution_clock::now();
+
+    std::cout << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms fill, ";
+    std::cout << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp3 - tp2 ).count() << " ms visit; S=" << s << "\n";
+}
+
+template<class... T> void test( long long N )
+{
+    Object o{ 0.5 };
+
+    using V1 = boost::variant2::variant<T...>;
+    using V2 = boost::variant2::boxed_value<T...>;
+
+    std::cout << "N=" << N << ", sizeof(variant)=" << sizeof( V1 ) << ", sizeof(boxed_value)=" << sizeof( V2 ) << ":\n";
+
+    std::cout << "      variant: "; test_<V1>( N, &o );
+    std::cout << "  boxed_value: "; test_<V2>( N, &o );
+
+    std::cout << '\n';
+}
+
+int main()
+{
+    long long const N = 100'000'000LL;
+
+    test<boost::variant2::monostate, bool, int, double, Object*>( N );
+}
@@ -0,0 +1,91 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/compact_variant.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+struct Small
+{
+    long long v;
+};
+
+struct Small2
+{
+    double v;
+};
+
+struct Huge
+{
+    long long v;
+    char pad[ 504 ];
+};
+
+struct F
+{
+    long long operator()( Small const& x ) const { return x.v; }
+    long long operator()( Small2 const& x ) const { return static_cast<long long>( x.v ); }
+    long long operator()( Huge const& x ) const { return x.v; }
+};
+
+template<class V> void test_( long long N, int M )
+{
+    std::vector<V> w;
+    // lack of reserve is deliberate
+
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    for( long long i = 0; i < N; ++i )
+    {
+        if( i % 100 == 0 )
+        {
+            w.push_back( Huge{ i, {} } );
+        }
+        else if( i % 2 == 0 )
+        {
+            w.push_back( Small{ i } );
+        }
+        else
+        {
+            w.push_back( Small2{ static_cast<double>( i ) } );
+        }
+    }
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    long long s = 0;
+
+    for( int j = 0; j < M; ++j )
+    {
+        for( auto const& v: w )
+        {
+            s += visit( F(), v );
+        }
+    }
+
+    auto tp3 = std::chrono::high_resolution_clock::now();
+
+    std::cout << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms fill, ";
+    std::cout << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp3 - tp2 ).count() << " ms visit; S=" << s << "\n";
+}
+
+int main()
+{
+    long long const N = 2'000'000LL;
+    int const M = 20;
+
+    using V1 = boost::variant2::variant<Small, Small2, Huge>;
+    using V2 = boost::variant2::compact_variant<16, Small, Small2, Huge>;
+
+    std::cout << "N=" << N << ", M=" << M << ", 1% Huge:\n";
+
+    std::cout << "        variant (sizeof " << std::setw( 3 ) << sizeof( V1 ) << "): "; test_<V1>( N, M );
+    std::cout << "compact_variant (sizeof " << std::setw( 3 ) << sizeof( V2 ) << "): "; test_<V2>( N, M );
+}
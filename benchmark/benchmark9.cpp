@@ -0,0 +1,107 @@
+// Copyright 2026 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/relocate.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <vector>
+#include <new>
+
+struct Foo
+{
+    std::unique_ptr<int> p;
+    long long v;
+};
+
+// std::vector and std::unique_ptr are trivially relocatable in libstdc++,
+// libc++ and the Microsoft STL; this is asserted here for the benchmark
+
+namespace boost
+{
+namespace variant2
+{
+
+template<class T> struct is_trivially_relocatable<std::vector<T>>: std::true_type
+{
+};
+
+template<class T> struct is_trivially_relocatable<std::unique_ptr<T>>: std::true_type
+{
+};
+
+template<> struct is_trivially_relocatable<Foo>: std::true_type
+{
+};
+
+} // namespace variant2
+} // namespace boost
+
+using V = boost::variant2::variant<std::vector<int>, std::unique_ptr<int>, Foo>;
+
+static void move_and_destroy( V* first, V* last, V* d_first )
+{
+    for( ; first != last; ++first, ++d_first )
+    {
+        ::new( static_cast<void*>( d_first ) ) V( std::move( *first ) );
+        first->~V();
+    }
+}
+
+template<class F> void test_( char const* name, std::size_t N, int M, F f )
+{
+    std::allocator<V> a;
+
+    V* p1 = a.allocate( N );
+    V* p2 = a.allocate( N );
+
+    for( std::size_t i = 0; i < N; ++i )
+    {
+        switch( i % 3 )
+        {
+        case 0: ::new( p1 + i ) V( std::vector<int>( 4, static_cast<int>( i ) ) ); break;
+        case 1: ::new( p1 + i ) V( std::unique_ptr<int>( new int( static_cast<int>( i ) ) ) ); break;
+        default: ::new( p1 + i ) V( Foo{ nullptr, static_cast<long long>( i ) } ); break;
+        }
+    }
+
+    auto tp1 = std::chrono::high_resolution_clock::now();
+
+    for( int j = 0; j < M; ++j )
+    {
+        f( p1, p1 + N, p2 );
+        std::swap( p1, p2 );
+    }
+
+    auto tp2 = std::chrono::high_resolution_clock::now();
+
+    std::size_t s = 0;
+
+    for( std::size_t i = 0; i < N; ++i )
+    {
+        s += p1[ i ].index();
+        p1[ i ].~V();
+    }
+
+    a.deallocate( p1, N );
+    a.deallocate( p2, N );
+
+    std::cout << name << std::setw( 6 ) << std::chrono::duration_cast<std::chrono::milliseconds>( tp2 - tp1 ).count() << " ms; S=" << s << "\n";
+}
+
+int main()
+{
+    std::size_t const N = 1'000'000;
+    int const M = 200;
+
+    std::cout << "N=" << N << ", M=" << M << ", sizeof(V)=" << sizeof( V ) << ":\n";
+
+    test_( "          move and destroy: ", N, M, move_and_destroy );
+    test_( "    uninitialized_relocate: ", N, M, []( V* first, V* last, V* d_first ){ boost::variant2::uninitialized_relocate( first, last, d_first ); } );
+}
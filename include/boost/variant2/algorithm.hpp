@@ -0,0 +1,112 @@
+#ifndef BOOST_VARIANT2_ALGORITHM_HPP_INCLUDED
+#define BOOST_VARIANT2_ALGORITHM_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/config.hpp>
+#include <vector>
+#include <array>
+#include <cstddef>
+
+#if !defined(BOOST_NO_CXX20_HDR_SPAN)
+# include <span>
+#endif
+
+#if defined(__cpp_lib_span) && __cpp_lib_span >= 202002L
+# define BOOST_VARIANT2_HAS_SPAN
+#endif
+
+namespace boost
+{
+namespace variant2
+{
+
+// count_by_index
+
+template<class... T> std::array<std::size_t, sizeof...(T)> count_by_index( variant<T...> const* first, std::size_t n ) noexcept
+{
+    std::size_t const N = sizeof...(T);
+
+    // four partial histograms, so that consecutive elements holding the
+    // same alternative don't serialize on a single counter
+
+    std::size_t c[ 4 ][ N ] = {};
+
+    std::size_t i = 0;
+
+    for( ; i + 4 <= n; i += 4 )
+    {
+        ++c[ 0 ][ first[ i + 0 ].index() ];
+        ++c[ 1 ][ first[ i + 1 ].index() ];
+        ++c[ 2 ][ first[ i + 2 ].index() ];
+        ++c[ 3 ][ first[ i + 3 ].index() ];
+    }
+
+    for( ; i < n; ++i )
+    {
+        ++c[ 0 ][ first[ i ].index() ];
+    }
+
+    std::array<std::size_t, N> r;
+
+    for( std::size_t j = 0; j < N; ++j )
+    {
+        r[ j ] = c[ 0 ][ j ] + c[ 1 ][ j ] + c[ 2 ][ j ] + c[ 3 ][ j ];
+    }
+
+    return r;
+}
+
+// partition_by_index
+
+template<class... T> std::array<std::vector<std::size_t>, sizeof...(T)> partition_by_index( variant<T...> const* first, std::size_t n )
+{
+    std::size_t const N = sizeof...(T);
+
+    std::array<std::size_t, N> const c = variant2::count_by_index( first, n );
+    std::array<std::vector<std::size_t>, N> r;
+
+    for( std::size_t j = 0; j < N; ++j )
+    {
+        r[ j ].reserve( c[ j ] );
+    }
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        r[ first[ i ].index() ].push_back( i );
+    }
+
+    return r;
+}
+
+#if defined(BOOST_VARIANT2_HAS_SPAN)
+
+template<class... T, std::size_t E> std::array<std::size_t, sizeof...(T)> count_by_index( std::span<variant<T...> const, E> s ) noexcept
+{
+    return variant2::count_by_index( s.data(), s.size() );
+}
+
+template<class... T, std::size_t E> std::array<std::size_t, sizeof...(T)> count_by_index( std::span<variant<T...>, E> s ) noexcept
+{
+    return variant2::count_by_index( s.data(), s.size() );
+}
+
+template<class... T, std::size_t E> std::array<std::vector<std::size_t>, sizeof...(T)> partition_by_index( std::span<variant<T...> const, E> s )
+{
+    return variant2::partition_by_index( s.data(), s.size() );
+}
+
+template<class... T, std::size_t E> std::array<std::vector<std::size_t>, sizeof...(T)> partition_by_index( std::span<variant<T...>, E> s )
+{
+    return variant2::partition_by_index( s.data(), s.size() );
+}
+
+#endif
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_ALGORITHM_HPP_INCLUDED
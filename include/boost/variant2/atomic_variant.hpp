@@ -0,0 +1,517 @@
+#ifndef BOOST_VARIANT2_ATOMIC_VARIANT_HPP_INCLUDED
+#define BOOST_VARIANT2_ATOMIC_VARIANT_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/mp11.hpp>
+#include <boost/config.hpp>
+#include <atomic>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16) && defined(__SIZEOF_INT128__)
+# define BOOST_VARIANT2_HAS_CAS16
+#endif
+
+#if defined(__has_builtin)
+# if __has_builtin(__builtin_clear_padding)
+#  define BOOST_VARIANT2_HAS_CLEAR_PADDING
+# endif
+#endif
+
+namespace boost
+{
+namespace variant2
+{
+namespace detail
+{
+
+// the failure order implied by a single memory order, as in std::atomic
+
+inline std::memory_order atomic_failure_order( std::memory_order order ) noexcept
+{
+    return order == std::memory_order_acq_rel? std::memory_order_acquire: order == std::memory_order_release? std::memory_order_relaxed: order;
+}
+
+// lock-free storage of up to 8 bytes, through std::atomic
+
+template<class W, bool LockFree> class atomic_word_storage
+{
+private:
+
+    std::atomic<W> w_;
+
+public:
+
+    using word_type = W;
+
+    static constexpr bool is_always_lock_free = LockFree;
+
+    explicit atomic_word_storage( W w ) noexcept: w_( w )
+    {
+    }
+
+    bool is_lock_free() const noexcept
+    {
+        return w_.is_lock_free();
+    }
+
+    W load( std::memory_order order ) const noexcept
+    {
+        return w_.load( order );
+    }
+
+    void store( W w, std::memory_order order ) noexcept
+    {
+        w_.store( w, order );
+    }
+
+    W exchange( W w, std::memory_order order ) noexcept
+    {
+        return w_.exchange( w, order );
+    }
+
+    bool compare_exchange_weak( W& expected, W desired, std::memory_order success, std::memory_order failure ) noexcept
+    {
+        return w_.compare_exchange_weak( expected, desired, success, failure );
+    }
+
+    bool compare_exchange_strong( W& expected, W desired, std::memory_order success, std::memory_order failure ) noexcept
+    {
+        return w_.compare_exchange_strong( expected, desired, success, failure );
+    }
+};
+
+#if defined(BOOST_VARIANT2_HAS_CAS16)
+
+// lock-free storage of 16 bytes, through a 16 byte CAS; every operation is a full barrier
+
+class atomic_dword_storage
+{
+public:
+
+    using word_type = unsigned __int128;
+
+private:
+
+    alignas(16) mutable word_type w_;
+
+public:
+
+    static constexpr bool is_always_lock_free = true;
+
+    explicit atomic_dword_storage( word_type w ) noexcept: w_( w )
+    {
+    }
+
+    bool is_lock_free() const noexcept
+    {
+        return true;
+    }
+
+    word_type load( std::memory_order /*order*/ ) const noexcept
+    {
+        // a CAS that stores the value it finds
+        return __sync_val_compare_and_swap( &w_, 0, 0 );
+    }
+
+    word_type exchange( word_type w, std::memory_order /*order*/ ) noexcept
+    {
+        // a guess at the current value, whose halves are loaded atomically but
+        // not together; when the guess is torn, the first CAS fails and returns
+        // the actual value
+
+        typedef std::uint64_t __attribute__((__may_alias__)) half_type;
+        half_type const* p = reinterpret_cast<half_type const*>( &w_ );
+
+        half_type h[ 2 ] = { __atomic_load_n( p, __ATOMIC_RELAXED ), __atomic_load_n( p + 1, __ATOMIC_RELAXED ) };
+
+        word_type e;
+        std::memcpy( &e, h, sizeof(e) );
+
+        for( ;; )
+        {
+            word_type r = __sync_val_compare_and_swap( &w_, e, w );
+
+            if( r == e ) return r;
+            e = r;
+        }
+    }
+
+    void store( word_type w, std::memory_order order ) noexcept
+    {
+        this->exchange( w, order );
+    }
+
+    bool compare_exchange_strong( word_type& expected, word_type desired, std::memory_order /*success*/, std::memory_order /*failure*/ ) noexcept
+    {
+        word_type r = __sync_val_compare_and_swap( &w_, expected, desired );
+
+        if( r == expected ) return true;
+
+        expected = r;
+        return false;
+    }
+
+    bool compare_exchange_weak( word_type& expected, word_type desired, std::memory_order success, std::memory_order failure ) noexcept
+    {
+        return this->compare_exchange_strong( expected, desired, success, failure );
+    }
+};
+
+#endif
+
+// storage protected by a spinlock, when there is no CAS of the required size
+
+template<std::size_t N> struct atomic_bytes
+{
+    alignas(16) unsigned char data[ N ];
+};
+
+template<std::size_t N> class atomic_locked_storage
+{
+public:
+
+    using word_type = atomic_bytes<N>;
+
+private:
+
+    mutable std::atomic_flag f_;
+    word_type w_;
+
+    struct lock_guard
+    {
+        std::atomic_flag& f_;
+
+        explicit lock_guard( std::atomic_flag& f ) noexcept: f_( f )
+        {
+            for( unsigned k = 0; f_.test_and_set( std::memory_order_acquire ); ++k )
+            {
+                // the holder may have been preempted
+                if( k >= 16 ) std::this_thread::yield();
+            }
+        }
+
+        ~lock_guard()
+        {
+            f_.clear( std::memory_order_release );
+        }
+
+        lock_guard( lock_guard const& ) = delete;
+        lock_guard& operator=( lock_guard const& ) = delete;
+    };
+
+public:
+
+    static constexpr bool is_always_lock_free = false;
+
+    explicit atomic_locked_storage( word_type const& w ) noexcept: w_( w )
+    {
+        f_.clear();
+    }
+
+    bool is_lock_free() const noexcept
+    {
+        return false;
+    }
+
+    word_type load( std::memory_order /*order*/ ) const noexcept
+    {
+        lock_guard lock( f_ );
+        return w_;
+    }
+
+    word_type exchange( word_type const& w, std::memory_order /*order*/ ) noexcept
+    {
+        lock_guard lock( f_ );
+
+        word_type r = w_;
+        w_ = w;
+
+        return r;
+    }
+
+    void store( word_type const& w, std::memory_order /*order*/ ) noexcept
+    {
+        lock_guard lock( f_ );
+        w_ = w;
+    }
+
+    bool compare_exchange_strong( word_type& expected, word_type const& desired, std::memory_order /*success*/, std::memory_order /*failure*/ ) noexcept
+    {
+        lock_guard lock( f_ );
+
+        if( std::memcmp( w_.data, expected.data, N ) == 0 )
+        {
+            w_ = desired;
+            return true;
+        }
+
+        expected = w_;
+        return false;
+    }
+
+    bool compare_exchange_weak( word_type& expected, word_type const& desired, std::memory_order success, std::memory_order failure ) noexcept
+    {
+        return this->compare_exchange_strong( expected, desired, success, failure );
+    }
+};
+
+template<std::size_t N> using atomic_variant_storage = mp11::mp_cond<
+
+    mp11::mp_bool<N <= 1>, atomic_word_storage<std::uint8_t, ATOMIC_CHAR_LOCK_FREE == 2>,
+    mp11::mp_bool<N <= 2>, atomic_word_storage<std::uint16_t, ATOMIC_SHORT_LOCK_FREE == 2>,
+    mp11::mp_bool<N <= 4>, atomic_word_storage<std::uint32_t, ATOMIC_INT_LOCK_FREE == 2>,
+    mp11::mp_bool<N <= 8>, atomic_word_storage<std::uint64_t, ATOMIC_LLONG_LOCK_FREE == 2>,
+
+#if defined(BOOST_VARIANT2_HAS_CAS16)
+
+    mp11::mp_bool<N <= 16>, atomic_dword_storage,
+
+#endif
+
+    mp11::mp_true, atomic_locked_storage<N>
+>;
+
+// the stored form of a variant: the bytes of the contained value, followed
+// by the index, in zeroed storage; a variant is never constructed over the
+// storage, so that the bytes left over from other alternatives are zero
+
+template<class... T> struct atomic_variant_layout
+{
+    using index_type = mp11::mp_if_c<sizeof...(T) <= 256, unsigned char, unsigned short>;
+
+    static constexpr std::size_t value_size = mp11::mp_max_element<mp11::mp_list<mp11::mp_size_t<sizeof(T)>...>, mp11::mp_less>::value;
+    static constexpr std::size_t size = value_size + sizeof( index_type );
+};
+
+// whether the object representation of T has no padding bits, when they
+// can't be cleared
+
+#if defined(__cpp_lib_has_unique_object_representations) && __cpp_lib_has_unique_object_representations >= 201606L
+
+template<class T> using atomic_unique_representation = std::has_unique_object_representations<T>;
+
+#elif ( defined(BOOST_GCC) && BOOST_GCC >= 70000 ) || ( defined(BOOST_CLANG) && __clang_major__ >= 6 ) || ( defined(BOOST_MSVC) && BOOST_MSVC >= 1911 )
+
+template<class T> using atomic_unique_representation = mp11::mp_bool<__has_unique_object_representations(T)>;
+
+#else
+
+template<class T> using atomic_unique_representation = std::false_type;
+
+#endif
+
+// floating point types and pointers have no padding bits, but can have
+// several representations of a value; long double can have padding bytes
+
+template<class T> using atomic_padding_free = mp11::mp_bool<
+
+    std::is_empty<T>::value ||
+    ( std::is_scalar<T>::value && !std::is_same<typename std::remove_cv<T>::type, long double>::value ) ||
+    atomic_unique_representation<T>::value
+>;
+
+template<class W, class... T> struct atomic_to_word_L
+{
+    variant<T...> const& v;
+
+    template<class I> W operator()( I ) const noexcept
+    {
+        using layout = atomic_variant_layout<T...>;
+        using U = mp11::mp_at_c<variant<T...>, I::value>;
+
+        unsigned char buffer[ sizeof(W) ] = {};
+
+        // an empty alternative has no value; its byte is left zero
+        if( !std::is_empty<U>::value )
+        {
+            // a copy, whose padding can be cleared
+            U u( unsafe_get<I::value>( v ) );
+
+#if defined(BOOST_VARIANT2_HAS_CLEAR_PADDING)
+
+            __builtin_clear_padding( &u );
+
+#endif
+
+            std::memcpy( buffer, static_cast<void const*>( &u ), sizeof(U) );
+        }
+
+        typename layout::index_type ix = static_cast<typename layout::index_type>( I::value );
+        std::memcpy( buffer + layout::value_size, &ix, sizeof(ix) );
+
+        W w;
+        std::memcpy( static_cast<void*>( &w ), buffer, sizeof(W) );
+
+        return w;
+    }
+};
+
+template<class... T> struct atomic_from_word_L
+{
+    unsigned char const* buffer;
+
+    template<class I> variant<T...> operator()( I ) const noexcept
+    {
+        using U = mp11::mp_at_c<variant<T...>, I::value>;
+
+        alignas(U) unsigned char st[ sizeof(U) ];
+        std::memcpy( st, buffer, sizeof(U) );
+
+#if defined(__cpp_lib_launder) && __cpp_lib_launder >= 201606L
+        U const& u = *std::launder( reinterpret_cast<U const*>( st ) );
+#else
+        U const& u = *reinterpret_cast<U const*>( st );
+#endif
+
+        return variant<T...>( in_place_index_t<I::value>(), u );
+    }
+};
+
+} // namespace detail
+
+// atomic_variant
+
+template<class... T> class atomic_variant
+{
+public:
+
+    using value_type = variant<T...>;
+
+private:
+
+    static_assert( mp11::mp_all<std::is_trivially_copyable<T>...>::value, "atomic_variant requires trivially copyable alternatives" );
+    static_assert( std::is_trivially_copyable<value_type>::value, "atomic_variant requires a trivially copyable variant" );
+    static_assert( sizeof(value_type) <= 16, "atomic_variant requires a variant of at most 16 bytes" );
+
+#if !defined(BOOST_VARIANT2_HAS_CLEAR_PADDING)
+
+    // padding bits would make compare_exchange fail spuriously
+    static_assert( mp11::mp_all<detail::atomic_padding_free<T>...>::value, "atomic_variant requires alternatives without padding bits on this compiler" );
+
+#endif
+
+    using layout = detail::atomic_variant_layout<T...>;
+
+    using storage_type = detail::atomic_variant_storage<layout::size>;
+    using word_type = typename storage_type::word_type;
+
+    storage_type st_;
+
+private:
+
+    static word_type to_word( value_type const& v ) noexcept
+    {
+        return detail::with_index<value_type, sizeof...(T)>( v.index(), detail::atomic_to_word_L<word_type, T...>{ v } );
+    }
+
+    static value_type from_word( word_type const& w ) noexcept
+    {
+        unsigned char buffer[ sizeof(word_type) ];
+        std::memcpy( buffer, static_cast<void const*>( &w ), sizeof(word_type) );
+
+        typename layout::index_type ix;
+        std::memcpy( &ix, buffer + layout::value_size, sizeof(ix) );
+
+        return detail::with_index<value_type, sizeof...(T)>( ix, detail::atomic_from_word_L<T...>{ buffer } );
+    }
+
+public:
+
+    static constexpr bool is_always_lock_free = storage_type::is_always_lock_free;
+
+    // constructors
+
+    atomic_variant() noexcept( std::is_nothrow_default_constructible<value_type>::value ): st_( to_word( value_type() ) )
+    {
+    }
+
+    atomic_variant( value_type const& v ) noexcept: st_( to_word( v ) )
+    {
+    }
+
+    atomic_variant( atomic_variant const& ) = delete;
+    atomic_variant& operator=( atomic_variant const& ) = delete;
+
+    // operations
+
+    bool is_lock_free() const noexcept
+    {
+        return st_.is_lock_free();
+    }
+
+    value_type load( std::memory_order order = std::memory_order_seq_cst ) const noexcept
+    {
+        return from_word( st_.load( order ) );
+    }
+
+    operator value_type() const noexcept
+    {
+        return load();
+    }
+
+    void store( value_type const& v, std::memory_order order = std::memory_order_seq_cst ) noexcept
+    {
+        st_.store( to_word( v ), order );
+    }
+
+    value_type const& operator=( value_type const& v ) noexcept
+    {
+        store( v );
+        return v;
+    }
+
+    value_type exchange( value_type const& v, std::memory_order order = std::memory_order_seq_cst ) noexcept
+    {
+        return from_word( st_.exchange( to_word( v ), order ) );
+    }
+
+    bool compare_exchange_weak( value_type& expected, value_type const& desired, std::memory_order success, std::memory_order failure ) noexcept
+    {
+        word_type w = to_word( expected );
+
+        if( st_.compare_exchange_weak( w, to_word( desired ), success, failure ) ) return true;
+
+        expected = from_word( w );
+        return false;
+    }
+
+    bool compare_exchange_weak( value_type& expected, value_type const& desired, std::memory_order order = std::memory_order_seq_cst ) noexcept
+    {
+        return compare_exchange_weak( expected, desired, order, detail::atomic_failure_order( order ) );
+    }
+
+    bool compare_exchange_strong( value_type& expected, value_type const& desired, std::memory_order success, std::memory_order failure ) noexcept
+    {
+        word_type w = to_word( expected );
+
+        if( st_.compare_exchange_strong( w, to_word( desired ), success, failure ) ) return true;
+
+        expected = from_word( w );
+        return false;
+    }
+
+    bool compare_exchange_strong( value_type& expected, value_type const& desired, std::memory_order order = std::memory_order_seq_cst ) noexcept
+    {
+        return compare_exchange_strong( expected, desired, order, detail::atomic_failure_order( order ) );
+    }
+};
+
+#if defined(BOOST_NO_CXX17_INLINE_VARIABLES)
+
+template<class... T> constexpr bool atomic_variant<T...>::is_always_lock_free;
+
+#endif
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_ATOMIC_VARIANT_HPP_INCLUDED
@@ -0,0 +1,396 @@
+#ifndef BOOST_VARIANT2_BINARY_HPP_INCLUDED
+#define BOOST_VARIANT2_BINARY_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/mp11.hpp>
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace boost
+{
+namespace variant2
+{
+
+// binary_traits
+
+template<class T, class E = void> struct binary_traits;
+
+constexpr std::size_t binary_error = static_cast<std::size_t>( -1 );
+
+namespace detail
+{
+
+template<class T> struct is_variant: std::false_type
+{
+};
+
+template<class... T> struct is_variant<variant<T...>>: std::true_type
+{
+};
+
+template<class T> using is_binary_empty = mp11::mp_bool<
+    std::is_empty<T>::value && std::is_default_constructible<T>::value
+>;
+
+// bool has its own traits, as not every byte is a valid bool
+
+template<class T> using is_binary_memcpyable = mp11::mp_bool<
+    std::is_trivially_copyable<T>::value && std::is_default_constructible<T>::value &&
+    !std::is_empty<T>::value && !std::is_pointer<T>::value && !std::is_member_pointer<T>::value && !is_variant<T>::value &&
+    !std::is_same<T, bool>::value
+>;
+
+// varint, unsigned LEB128
+
+inline std::size_t varint_size( std::size_t n ) noexcept
+{
+    std::size_t r = 1;
+
+    while( n >= 0x80 )
+    {
+        n >>= 7;
+        ++r;
+    }
+
+    return r;
+}
+
+inline unsigned char* write_varint( unsigned char* p, std::size_t n ) noexcept
+{
+    while( n >= 0x80 )
+    {
+        *p++ = static_cast<unsigned char>( ( n & 0x7F ) | 0x80 );
+        n >>= 7;
+    }
+
+    *p++ = static_cast<unsigned char>( n );
+    return p;
+}
+
+// returns the number of bytes read, or 0 on error
+inline std::size_t read_varint( unsigned char const* first, unsigned char const* last, std::size_t& n ) noexcept
+{
+    std::size_t r = 0;
+    unsigned shift = 0;
+
+    for( unsigned char const* p = first; p != last; ++p )
+    {
+        std::size_t b = *p & 0x7F;
+
+        if( shift >= sizeof(std::size_t) * 8 || ( b << shift >> shift ) != b )
+        {
+            // overflow
+            return 0;
+        }
+
+        r |= b << shift;
+
+        if( ( *p & 0x80 ) == 0 )
+        {
+            n = r;
+            return static_cast<std::size_t>( p - first ) + 1;
+        }
+
+        shift += 7;
+    }
+
+    // truncated
+    return 0;
+}
+
+} // namespace detail
+
+// empty types
+
+template<class T> struct binary_traits<T, typename std::enable_if< detail::is_binary_empty<T>::value >::type>
+{
+    static std::size_t size( T const& ) noexcept
+    {
+        return 0;
+    }
+
+    static unsigned char* write( unsigned char* p, T const& ) noexcept
+    {
+        return p;
+    }
+
+    static std::size_t parse( unsigned char const*, unsigned char const* ) noexcept
+    {
+        return 0;
+    }
+
+    static T read( unsigned char const*, unsigned char const* ) noexcept( std::is_nothrow_default_constructible<T>::value )
+    {
+        return T();
+    }
+};
+
+// trivially copyable types, in native byte order
+
+template<class T> struct binary_traits<T, typename std::enable_if< detail::is_binary_memcpyable<T>::value >::type>
+{
+    static std::size_t size( T const& ) noexcept
+    {
+        return sizeof(T);
+    }
+
+    static unsigned char* write( unsigned char* p, T const& t ) noexcept
+    {
+        std::memcpy( p, static_cast<void const*>( &t ), sizeof(T) );
+        return p + sizeof(T);
+    }
+
+    static std::size_t parse( unsigned char const* first, unsigned char const* last ) noexcept
+    {
+        return static_cast<std::size_t>( last - first ) < sizeof(T)? binary_error: sizeof(T);
+    }
+
+    static T read( unsigned char const* first, unsigned char const* /*last*/ ) noexcept
+    {
+        T t;
+        std::memcpy( static_cast<void*>( &t ), first, sizeof(T) );
+        return t;
+    }
+};
+
+// bool, as a single byte that is 0 or 1
+
+template<> struct binary_traits<bool>
+{
+    static std::size_t size( bool ) noexcept
+    {
+        return 1;
+    }
+
+    static unsigned char* write( unsigned char* p, bool t ) noexcept
+    {
+        *p = t;
+        return p + 1;
+    }
+
+    static std::size_t parse( unsigned char const* first, unsigned char const* last ) noexcept
+    {
+        return first == last || *first > 1? binary_error: 1;
+    }
+
+    static bool read( unsigned char const* first, unsigned char const* /*last*/ ) noexcept
+    {
+        return *first != 0;
+    }
+};
+
+// strings, as a varint length followed by the characters
+
+template<class Ch, class Tr, class A> struct binary_traits<std::basic_string<Ch, Tr, A>, typename std::enable_if< detail::is_binary_memcpyable<Ch>::value >::type>
+{
+    using string_type = std::basic_string<Ch, Tr, A>;
+
+    static std::size_t size( string_type const& s ) noexcept
+    {
+        return detail::varint_size( s.size() ) + s.size() * sizeof(Ch);
+    }
+
+    static unsigned char* write( unsigned char* p, string_type const& s ) noexcept
+    {
+        p = detail::write_varint( p, s.size() );
+
+        if( !s.empty() )
+        {
+            std::memcpy( p, static_cast<void const*>( s.data() ), s.size() * sizeof(Ch) );
+        }
+
+        return p + s.size() * sizeof(Ch);
+    }
+
+    static std::size_t parse( unsigned char const* first, unsigned char const* last ) noexcept
+    {
+        std::size_t n = 0;
+        std::size_t k = detail::read_varint( first, last, n );
+
+        if( k == 0 || n > static_cast<std::size_t>( last - first - k ) / sizeof(Ch) )
+        {
+            return binary_error;
+        }
+
+        return k + n * sizeof(Ch);
+    }
+
+    static string_type read( unsigned char const* first, unsigned char const* last )
+    {
+        std::size_t n = 0;
+        std::size_t k = detail::read_varint( first, last, n );
+
+        string_type s( n, Ch() );
+
+        if( n != 0 )
+        {
+            std::memcpy( static_cast<void*>( &s[ 0 ] ), first + k, n * sizeof(Ch) );
+        }
+
+        return s;
+    }
+};
+
+// variants, as a varint index followed by the alternative
+
+namespace detail
+{
+
+template<class T> struct binary_reader
+{
+    unsigned char const* first_;
+    unsigned char const* last_;
+
+    operator T() const noexcept( noexcept( binary_traits<T>::read( first_, last_ ) ) )
+    {
+        return binary_traits<T>::read( first_, last_ );
+    }
+};
+
+struct binary_size_L
+{
+    template<class T> std::size_t operator()( T const& t ) const noexcept
+    {
+        return binary_traits<T>::size( t );
+    }
+};
+
+struct binary_write_L
+{
+    unsigned char* p;
+
+    template<class T> unsigned char* operator()( T const& t ) const noexcept
+    {
+        return binary_traits<T>::write( p, t );
+    }
+};
+
+template<class... T> struct binary_parse_L
+{
+    unsigned char const* first;
+    unsigned char const* last;
+
+    template<class I> std::size_t operator()( I ) const noexcept
+    {
+        return binary_traits< mp11::mp_at<mp11::mp_list<T...>, I> >::parse( first, last );
+    }
+};
+
+template<class... T> struct binary_read_L
+{
+    variant<T...>& v;
+
+    unsigned char const* first;
+    unsigned char const* last;
+
+    template<class I> void operator()( I ) const
+    {
+        using U = mp11::mp_at<mp11::mp_list<T...>, I>;
+        v.template emplace<I::value>( binary_reader<U>{ first, last } );
+    }
+};
+
+template<class... T> struct binary_construct_L
+{
+    unsigned char const* first;
+    unsigned char const* last;
+
+    template<class I> variant<T...> operator()( I ) const
+    {
+        using U = mp11::mp_at<mp11::mp_list<T...>, I>;
+        return variant<T...>( in_place_index_t<I::value>(), binary_reader<U>{ first, last } );
+    }
+};
+
+} // namespace detail
+
+template<class... T> struct binary_traits<variant<T...>, void>
+{
+    static std::size_t size( variant<T...> const& v ) noexcept
+    {
+        return detail::varint_size( v.index() ) + visit( detail::binary_size_L(), v );
+    }
+
+    static unsigned char* write( unsigned char* p, variant<T...> const& v ) noexcept
+    {
+        p = detail::write_varint( p, v.index() );
+        return visit( detail::binary_write_L{ p }, v );
+    }
+
+    static std::size_t parse( unsigned char const* first, unsigned char const* last ) noexcept
+    {
+        std::size_t i = 0;
+        std::size_t k = detail::read_varint( first, last, i );
+
+        if( k == 0 || i >= sizeof...(T) )
+        {
+            return binary_error;
+        }
+
+        std::size_t n = detail::with_index<variant<T...>, sizeof...(T)>( i, detail::binary_parse_L<T...>{ first + k, last } );
+
+        return n == binary_error? n: k + n;
+    }
+
+    static variant<T...> read( unsigned char const* first, unsigned char const* last )
+    {
+        std::size_t i = 0;
+        std::size_t k = detail::read_varint( first, last, i );
+
+        return detail::with_index<variant<T...>, sizeof...(T)>( i, detail::binary_construct_L<T...>{ first + k, last } );
+    }
+};
+
+// binary_size
+
+template<class... T> std::size_t binary_size( variant<T...> const& v ) noexcept
+{
+    return binary_traits<variant<T...>>::size( v );
+}
+
+// write_binary
+
+template<class... T> unsigned char* write_binary( unsigned char* p, variant<T...> const& v ) noexcept
+{
+    return binary_traits<variant<T...>>::write( p, v );
+}
+
+// read_binary
+
+template<class... T> unsigned char const* read_binary( unsigned char const* first, unsigned char const* last, variant<T...>& v )
+{
+    std::size_t i = 0;
+    std::size_t k = detail::read_varint( first, last, i );
+
+    if( k == 0 || i >= sizeof...(T) )
+    {
+        return nullptr;
+    }
+
+    first += k;
+
+    std::size_t n = detail::with_index<variant<T...>, sizeof...(T)>( i, detail::binary_parse_L<T...>{ first, last } );
+
+    if( n == binary_error )
+    {
+        return nullptr;
+    }
+
+    detail::with_index<variant<T...>, sizeof...(T)>( i, detail::binary_read_L<T...>{ v, first, first + n } );
+
+    return first + n;
+}
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_BINARY_HPP_INCLUDED
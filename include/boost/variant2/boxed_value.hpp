@@ -0,0 +1,544 @@
+#ifndef BOOST_VARIANT2_BOXED_VALUE_HPP_INCLUDED
+#define BOOST_VARIANT2_BOXED_VALUE_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// boxed_value<T...> stores one of a restricted set of alternatives in a
+// single 64 bit word, using the unused quiet NaN encodings of `double`
+// to hold the index and the payload of the non-`double` alternatives.
+//
+// A value whose upper 16 bits are 0xFFF8 or less is a `double`. Otherwise
+// the upper 16 bits are 0xFFF8 + tag, with tag in 1..7, and the lower 48
+// bits hold the payload. Negative quiet NaNs that would collide with a tag
+// are canonicalized to the positive quiet NaN on store.
+
+#include <boost/variant2/variant.hpp>
+#include <boost/mp11.hpp>
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace boost
+{
+namespace variant2
+{
+
+template<class... T> class boxed_value;
+
+// variant_size
+
+template<class... T> struct variant_size<boxed_value<T...>>: mp11::mp_size_t<sizeof...(T)>
+{
+};
+
+// variant_alternative
+
+template<std::size_t I, class... T> struct variant_alternative<I, boxed_value<T...>>: mp11::mp_defer<mp11::mp_at, mp11::mp_list<T...>, mp11::mp_size_t<I>>
+{
+};
+
+namespace detail
+{
+
+// boxed_traits
+
+template<class T> struct boxed_empty_traits
+{
+    static std::uint64_t encode( T const& ) noexcept
+    {
+        return 0;
+    }
+
+    static T decode( std::uint64_t ) noexcept
+    {
+        return T();
+    }
+};
+
+struct boxed_bool_traits
+{
+    static std::uint64_t encode( bool v ) noexcept
+    {
+        return v;
+    }
+
+    static bool decode( std::uint64_t u ) noexcept
+    {
+        return u != 0;
+    }
+};
+
+template<class T> struct boxed_int_traits
+{
+    using I = typename mp11::mp_if<std::is_enum<T>, std::underlying_type<T>, mp11::mp_identity<T>>::type;
+    using U = typename std::make_unsigned<I>::type;
+
+    static std::uint64_t encode( T v ) noexcept
+    {
+        return static_cast<U>( static_cast<I>( v ) );
+    }
+
+    static T decode( std::uint64_t u ) noexcept
+    {
+        return static_cast<T>( static_cast<I>( static_cast<U>( u ) ) );
+    }
+};
+
+struct boxed_float_traits
+{
+    static std::uint64_t encode( float v ) noexcept
+    {
+        std::uint32_t u;
+        std::memcpy( &u, &v, sizeof( u ) );
+
+        return u;
+    }
+
+    static float decode( std::uint64_t u ) noexcept
+    {
+        std::uint32_t w = static_cast<std::uint32_t>( u );
+
+        float v;
+        std::memcpy( &v, &w, sizeof( v ) );
+
+        return v;
+    }
+};
+
+template<class T> struct boxed_pointer_traits
+{
+    static std::uint64_t encode( T p ) noexcept
+    {
+        std::uint64_t u = reinterpret_cast<std::uintptr_t>( p );
+
+        // pointers must fit in the 48 bit payload
+        BOOST_ASSERT( ( u >> 48 ) == 0 );
+
+        return u;
+    }
+
+    static T decode( std::uint64_t u ) noexcept
+    {
+        return reinterpret_cast<T>( static_cast<std::uintptr_t>( u ) );
+    }
+};
+
+template<class T> using is_boxed_empty = mp11::mp_bool<
+    ( std::is_class<T>::value && std::is_empty<T>::value && std::is_trivially_copyable<T>::value && std::is_default_constructible<T>::value ) ||
+    std::is_same<T, std::nullptr_t>::value
+>;
+
+template<class T> using is_boxed_int = mp11::mp_bool<
+    ( std::is_integral<T>::value || std::is_enum<T>::value ) && !std::is_same<T, bool>::value && sizeof(T) <= 4
+>;
+
+template<class T> using is_boxed_pointer = mp11::mp_bool<
+    std::is_pointer<T>::value && std::is_object<typename std::remove_pointer<T>::type>::value
+>;
+
+template<class T> using boxed_traits = mp11::mp_cond<
+    is_boxed_empty<T>, boxed_empty_traits<T>,
+    std::is_same<T, bool>, boxed_bool_traits,
+    is_boxed_int<T>, boxed_int_traits<T>,
+    std::is_same<T, float>, boxed_float_traits,
+    is_boxed_pointer<T>, boxed_pointer_traits<T>
+>;
+
+template<class T> using is_boxable = mp11::mp_bool<
+    !std::is_const<T>::value && !std::is_volatile<T>::value && !std::is_reference<T>::value &&
+    ( std::is_same<T, double>::value || mp11::mp_valid<boxed_traits, T>::value )
+>;
+
+constexpr std::uint64_t boxed_payload_mask = ( static_cast<std::uint64_t>( 1 ) << 48 ) - 1;
+constexpr std::uint64_t boxed_nan_base = 0xFFF8;
+constexpr std::uint64_t boxed_canonical_nan = static_cast<std::uint64_t>( 0x7FF8 ) << 48;
+
+} // namespace detail
+
+template<class... T> class boxed_value
+{
+private:
+
+    using L = mp11::mp_list<T...>;
+
+    static constexpr std::size_t N = sizeof...(T);
+
+    // index of the `double` alternative, N if there isn't one
+    static constexpr std::size_t Kd = mp11::mp_find<L, double>::value;
+
+    static_assert( N > 0, "boxed_value requires at least one alternative" );
+    static_assert( mp11::mp_count<L, double>::value <= 1, "boxed_value supports at most one double alternative" );
+    static_assert( N - ( Kd < N ) <= 7, "boxed_value supports at most seven non-double alternatives" );
+    static_assert( mp11::mp_all<detail::is_boxable<T>...>::value, "boxed_value alternatives must be double, float, bool, integral or enumeration types of at most 32 bits, object pointers, std::nullptr_t, or empty trivially copyable classes" );
+
+    std::uint64_t v_;
+
+private:
+
+    static std::uint64_t encode_( mp11::mp_true, std::size_t /*I*/, double v ) noexcept
+    {
+        std::uint64_t u;
+        std::memcpy( &u, &v, sizeof( u ) );
+
+        if( BOOST_UNLIKELY( ( u >> 48 ) > detail::boxed_nan_base ) )
+        {
+            u = detail::boxed_canonical_nan;
+        }
+
+        return u;
+    }
+
+    template<class U> static std::uint64_t encode_( mp11::mp_false, std::size_t I, U const& v ) noexcept
+    {
+        std::uint64_t tag = ( I < Kd? I: I - 1 ) + 1;
+        return ( ( detail::boxed_nan_base + tag ) << 48 ) | detail::boxed_traits<U>::encode( v );
+    }
+
+    template<std::size_t I> static std::uint64_t encode( mp11::mp_size_t<I>, mp11::mp_at_c<L, I> const& v ) noexcept
+    {
+        return encode_( mp11::mp_bool<I == Kd>(), I, v );
+    }
+
+    double decode_( mp11::mp_true, mp11::mp_identity<double> ) const noexcept
+    {
+        double v;
+        std::memcpy( &v, &v_, sizeof( v ) );
+
+        return v;
+    }
+
+    template<class U> U decode_( mp11::mp_false, mp11::mp_identity<U> ) const noexcept
+    {
+        return detail::boxed_traits<U>::decode( v_ & detail::boxed_payload_mask );
+    }
+
+public:
+
+    // constructors
+
+    boxed_value() noexcept: v_( encode( mp11::mp_size_t<0>(), mp11::mp_front<L>() ) )
+    {
+    }
+
+    // boxed_value( boxed_value const& ) = default;
+    // boxed_value( boxed_value && ) = default;
+
+    template<class U,
+        class Ud = typename std::decay<U>::type,
+        class E1 = typename std::enable_if< !std::is_same<Ud, boxed_value>::value && !detail::is_in_place_index<Ud>::value && !detail::is_in_place_type<Ud>::value >::type,
+        class V = detail::resolve_overload_type<U&&, T...>,
+        class E2 = typename std::enable_if<std::is_constructible<V, U&&>::value>::type
+        >
+    boxed_value( U&& u ) noexcept: v_( encode( detail::resolve_overload_index<U&&, T...>(), V( std::forward<U>(u) ) ) )
+    {
+    }
+
+    template<class U, class... A, class I = mp11::mp_find<L, U>, class E = typename std::enable_if<std::is_constructible<U, A&&...>::value>::type>
+    explicit boxed_value( in_place_type_t<U>, A&&... a ) noexcept: v_( encode( I(), U( std::forward<A>(a)... ) ) )
+    {
+    }
+
+    template<std::size_t I, class... A, class E = typename std::enable_if<std::is_constructible<mp11::mp_at_c<L, I>, A&&...>::value>::type>
+    explicit boxed_value( in_place_index_t<I>, A&&... a ) noexcept: v_( encode( mp11::mp_size_t<I>(), mp11::mp_at_c<L, I>( std::forward<A>(a)... ) ) )
+    {
+    }
+
+    // assignment
+
+    // boxed_value& operator=( boxed_value const& ) = default;
+    // boxed_value& operator=( boxed_value && ) = default;
+
+    template<class U,
+        class E1 = typename std::enable_if<!std::is_same<typename std::decay<U>::type, boxed_value>::value>::type,
+        class V = detail::resolve_overload_type<U, T...>,
+        class E2 = typename std::enable_if<std::is_constructible<V, U&&>::value>::type
+        >
+    boxed_value& operator=( U&& u ) noexcept
+    {
+        v_ = encode( detail::resolve_overload_index<U, T...>(), V( std::forward<U>(u) ) );
+        return *this;
+    }
+
+    // modifiers
+
+    template<std::size_t I, class... A, class E = typename std::enable_if<std::is_constructible<mp11::mp_at_c<L, I>, A&&...>::value>::type>
+    variant_alternative_t<I, boxed_value> emplace( A&&... a ) noexcept
+    {
+        mp11::mp_at_c<L, I> v( std::forward<A>(a)... );
+
+        v_ = encode( mp11::mp_size_t<I>(), v );
+        return v;
+    }
+
+    template<class U, class... A, class E = typename std::enable_if< mp11::mp_count<L, U>::value == 1 && std::is_constructible<U, A&&...>::value >::type>
+    U emplace( A&&... a ) noexcept
+    {
+        using I = mp11::mp_find<L, U>;
+        return this->template emplace<I::value>( std::forward<A>(a)... );
+    }
+
+    void swap( boxed_value& r ) noexcept
+    {
+        std::swap( v_, r.v_ );
+    }
+
+    // value status
+
+    std::size_t index() const noexcept
+    {
+        std::uint64_t t = v_ >> 48;
+
+        if( t <= detail::boxed_nan_base ) return Kd;
+
+        std::size_t j = static_cast<std::size_t>( t - detail::boxed_nan_base - 1 );
+        return j < Kd? j: j + 1;
+    }
+
+    constexpr bool valueless_by_exception() const noexcept
+    {
+        return false;
+    }
+
+    // private accessors
+
+    template<std::size_t I> mp11::mp_at_c<L, I> _get_impl( mp11::mp_size_t<I> ) const noexcept
+    {
+        BOOST_ASSERT( index() == I );
+        return decode_( mp11::mp_bool<I == Kd>(), mp11::mp_identity<mp11::mp_at_c<L, I>>() );
+    }
+};
+
+// boxed_pointer
+
+template<class T> class boxed_pointer
+{
+private:
+
+    T v_;
+    bool has_;
+
+public:
+
+    constexpr boxed_pointer() noexcept: v_(), has_( false )
+    {
+    }
+
+    constexpr explicit boxed_pointer( T v ) noexcept: v_( v ), has_( true )
+    {
+    }
+
+    constexpr explicit operator bool() const noexcept
+    {
+        return has_;
+    }
+
+    T const& operator*() const noexcept
+    {
+        BOOST_ASSERT( has_ );
+        return v_;
+    }
+
+    T const* operator->() const noexcept
+    {
+        BOOST_ASSERT( has_ );
+        return &v_;
+    }
+
+    friend constexpr bool operator==( boxed_pointer const& p, std::nullptr_t ) noexcept
+    {
+        return !p.has_;
+    }
+
+    friend constexpr bool operator!=( boxed_pointer const& p, std::nullptr_t ) noexcept
+    {
+        return p.has_;
+    }
+};
+
+// holds_alternative
+
+template<class U, class... T> bool holds_alternative( boxed_value<T...> const& v ) noexcept
+{
+    static_assert( mp11::mp_contains<mp11::mp_list<T...>, U>::value, "The type must be present in the list of variant alternatives" );
+    return v.index() == mp11::mp_find<mp11::mp_list<T...>, U>::value;
+}
+
+// get (index)
+
+template<std::size_t I, class... T> variant_alternative_t<I, boxed_value<T...>> get( boxed_value<T...> const& v )
+{
+    static_assert( I < sizeof...(T), "Index out of bounds" );
+    return ( v.index() != I? detail::throw_bad_variant_access(): (void)0 ), v._get_impl( mp11::mp_size_t<I>() );
+}
+
+// get (type)
+
+template<class U, class... T> U get( boxed_value<T...> const& v )
+{
+    static_assert( mp11::mp_count<mp11::mp_list<T...>, U>::value == 1, "The type must occur exactly once in the list of variant alternatives" );
+
+    using I = mp11::mp_find<mp11::mp_list<T...>, U>;
+    return ( v.index() != I::value? detail::throw_bad_variant_access(): (void)0 ), v._get_impl( I() );
+}
+
+// unsafe_get
+
+template<std::size_t I, class... T> variant_alternative_t<I, boxed_value<T...>> unsafe_get( boxed_value<T...> const& v )
+{
+    static_assert( I < sizeof...(T), "Index out of bounds" );
+    return v._get_impl( mp11::mp_size_t<I>() );
+}
+
+// get_if
+
+template<std::size_t I, class... T> boxed_pointer<variant_alternative_t<I, boxed_value<T...>>> get_if( boxed_value<T...> const* v ) noexcept
+{
+    static_assert( I < sizeof...(T), "Index out of bounds" );
+
+    using R = boxed_pointer<variant_alternative_t<I, boxed_value<T...>>>;
+    return v && v->index() == I? R( v->_get_impl( mp11::mp_size_t<I>() ) ): R();
+}
+
+template<class U, class... T> boxed_pointer<U> get_if( boxed_value<T...> const* v ) noexcept
+{
+    static_assert( mp11::mp_count<mp11::mp_list<T...>, U>::value == 1, "The type must occur exactly once in the list of variant alternatives" );
+
+    using I = mp11::mp_find<mp11::mp_list<T...>, U>;
+    return v && v->index() == I::value? boxed_pointer<U>( v->_get_impl( I() ) ): boxed_pointer<U>();
+}
+
+// relational operators
+
+namespace detail
+{
+
+template<class... T> struct bv_eq_L
+{
+    boxed_value<T...> const& v;
+    boxed_value<T...> const& w;
+
+    template<class I> bool operator()( I i ) const
+    {
+        return v._get_impl( i ) == w._get_impl( i );
+    }
+};
+
+template<class... T> struct bv_lt_L
+{
+    boxed_value<T...> const& v;
+    boxed_value<T...> const& w;
+
+    template<class I> bool operator()( I i ) const
+    {
+        return v._get_impl( i ) < w._get_impl( i );
+    }
+};
+
+} // namespace detail
+
+template<class... T> bool operator==( boxed_value<T...> const& v, boxed_value<T...> const& w )
+{
+    return v.index() == w.index() && detail::with_index<boxed_value<T...>, sizeof...(T)>( v.index(), detail::bv_eq_L<T...>{ v, w } );
+}
+
+template<class... T> bool operator!=( boxed_value<T...> const& v, boxed_value<T...> const& w )
+{
+    return !( v == w );
+}
+
+template<class... T> bool operator<( boxed_value<T...> const& v, boxed_value<T...> const& w )
+{
+    return v.index() < w.index() || ( v.index() == w.index() && detail::with_index<boxed_value<T...>, sizeof...(T)>( v.index(), detail::bv_lt_L<T...>{ v, w } ) );
+}
+
+template<class... T> bool operator>( boxed_value<T...> const& v, boxed_value<T...> const& w )
+{
+    return w < v;
+}
+
+template<class... T> bool operator<=( boxed_value<T...> const& v, boxed_value<T...> const& w )
+{
+    return !( w < v );
+}
+
+template<class... T> bool operator>=( boxed_value<T...> const& v, boxed_value<T...> const& w )
+{
+    return !( v < w );
+}
+
+// swap
+
+template<class... T> void swap( boxed_value<T...>& v, boxed_value<T...>& w ) noexcept
+{
+    v.swap( w );
+}
+
+// visitation
+
+namespace detail
+{
+
+template<class R, class F, class... L> using BVret = mp11::mp_eval_if_not< std::is_same<R, deduced>, R, front_if_same, mp11::mp_product_q<Qret<F>, L...> >;
+
+template<class R, class F, class... T> struct bv_visit_L1
+{
+    F&& f;
+    boxed_value<T...> const& v;
+
+    template<class I> BVret<R, F, mp11::mp_list<T...>> operator()( I i ) const
+    {
+        return std::forward<F>(f)( v._get_impl( i ) );
+    }
+};
+
+template<class R, class F, class L1, class L2> struct bv_visit_L2;
+
+template<class R, class F, class... T, class... U> struct bv_visit_L2<R, F, mp11::mp_list<T...>, mp11::mp_list<U...>>
+{
+    F&& f;
+    boxed_value<T...> const& v1;
+    boxed_value<U...> const& v2;
+
+    using Ret = BVret<R, F, mp11::mp_list<T...>, mp11::mp_list<U...>>;
+
+    template<class I> struct L3
+    {
+        F&& f;
+        boxed_value<T...> const& v1;
+        boxed_value<U...> const& v2;
+
+        template<class J> Ret operator()( J j ) const
+        {
+            return std::forward<F>(f)( v1._get_impl( I() ), v2._get_impl( j ) );
+        }
+    };
+
+    template<class I> Ret operator()( I ) const
+    {
+        return detail::with_index<boxed_value<U...>, sizeof...(U)>( v2.index(), L3<I>{ std::forward<F>(f), v1, v2 } );
+    }
+};
+
+} // namespace detail
+
+template<class R = detail::deduced, class F, class... T> auto visit( F&& f, boxed_value<T...> const& v ) -> detail::BVret<R, F, mp11::mp_list<T...>>
+{
+    return detail::with_index<boxed_value<T...>, sizeof...(T)>( v.index(), detail::bv_visit_L1<R, F, T...>{ std::forward<F>(f), v } );
+}
+
+template<class R = detail::deduced, class F, class... T, class... U> auto visit( F&& f, boxed_value<T...> const& v1, boxed_value<U...> const& v2 ) -> detail::BVret<R, F, mp11::mp_list<T...>, mp11::mp_list<U...>>
+{
+    using L = detail::bv_visit_L2<R, F, mp11::mp_list<T...>, mp11::mp_list<U...>>;
+    return detail::with_index<boxed_value<T...>, sizeof...(T)>( v1.index(), L{ std::forward<F>(f), v1, v2 } );
+}
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_BOXED_VALUE_HPP_INCLUDED
@@ -0,0 +1,909 @@
+#ifndef BOOST_VARIANT2_COMPACT_VARIANT_HPP_INCLUDED
+#define BOOST_VARIANT2_COMPACT_VARIANT_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/relocate.hpp>
+#include <boost/mp11.hpp>
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <memory>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace boost
+{
+namespace variant2
+{
+
+template<std::size_t N, class A, class... T> class basic_compact_variant;
+
+template<std::size_t N, class... T> using compact_variant = basic_compact_variant<N, std::allocator<void>, T...>;
+
+// variant_size
+
+template<std::size_t N, class A, class... T> struct variant_size<basic_compact_variant<N, A, T...>>: mp11::mp_size_t<sizeof...(T)>
+{
+};
+
+// variant_alternative
+
+template<std::size_t I, std::size_t N, class A, class... T> struct variant_alternative<I, basic_compact_variant<N, A, T...>>: mp11::mp_defer<mp11::mp_at, mp11::mp_list<T...>, mp11::mp_size_t<I>>
+{
+};
+
+namespace detail
+{
+
+// allocator_traits<A>::is_always_equal, or is_empty<A> before C++17
+
+template<class A, class E = void> struct cv_is_always_equal: std::is_empty<A>
+{
+};
+
+template<class A> struct cv_is_always_equal<A, mp11::mp_void<typename std::allocator_traits<A>::is_always_equal>>: std::allocator_traits<A>::is_always_equal
+{
+};
+
+// cv_allocator<A> holds a copy of A; a stateless A isn't stored, and is
+// default constructed when needed. A stateful A is copied with
+// select_on_container_copy_construction and assigned as the propagate_on_
+// traits say, as the allocator of a container.
+
+template<class A, bool S = !cv_is_always_equal<A>::value> class cv_allocator
+{
+public:
+
+    cv_allocator() noexcept
+    {
+    }
+
+    template<class B> explicit cv_allocator( B const& ) noexcept
+    {
+    }
+
+    A get() const noexcept
+    {
+        return A();
+    }
+
+    bool equals( cv_allocator const& ) const noexcept
+    {
+        return true;
+    }
+};
+
+template<class A> class cv_allocator<A, true>
+{
+private:
+
+    using traits = std::allocator_traits<A>;
+
+    A a_;
+
+    void assign( mp11::mp_true, A const& a ) noexcept
+    {
+        a_ = a;
+    }
+
+    void assign( mp11::mp_false, A const& ) noexcept
+    {
+    }
+
+public:
+
+    cv_allocator() noexcept( std::is_nothrow_default_constructible<A>::value ): a_()
+    {
+    }
+
+    template<class B> explicit cv_allocator( B const& b ) noexcept: a_( b )
+    {
+    }
+
+    cv_allocator( cv_allocator const& r ): a_( traits::select_on_container_copy_construction( r.a_ ) )
+    {
+    }
+
+    cv_allocator( cv_allocator&& r ) noexcept: a_( r.a_ )
+    {
+    }
+
+    cv_allocator& operator=( cv_allocator const& r ) noexcept
+    {
+        assign( typename traits::propagate_on_container_copy_assignment(), r.a_ );
+        return *this;
+    }
+
+    cv_allocator& operator=( cv_allocator&& r ) noexcept
+    {
+        assign( typename traits::propagate_on_container_move_assignment(), r.a_ );
+        return *this;
+    }
+
+    A const& get() const noexcept
+    {
+        return a_;
+    }
+
+    bool equals( cv_allocator const& r ) const noexcept
+    {
+        return a_ == r.a_;
+    }
+};
+
+// cv_box<T, A> owns a T allocated from its copy of A
+//
+// A move transfers the node and leaves the source without one. When T is
+// default constructible, such a box holds a value-initialized T, which is
+// only allocated when it's modified; otherwise, it can only be assigned to
+// or destroyed.
+
+template<class T, class A> class cv_box: private cv_allocator<typename std::allocator_traits<A>::template rebind_alloc<T>>
+{
+public:
+
+    using value_type = T;
+
+    // makes the box a uses-allocator type
+    using allocator_type = typename std::allocator_traits<A>::template rebind_alloc<T>;
+
+private:
+
+    using traits = std::allocator_traits<allocator_type>;
+
+    using holder_type = cv_allocator<allocator_type>;
+
+    static_assert( std::is_same<typename traits::pointer, T*>::value, "The allocator of a compact_variant must use raw pointers" );
+
+    using can_be_empty = std::is_default_constructible<T>;
+
+    // a move assignment that can take the node of the source
+    using steals_on_move = mp11::mp_bool< traits::propagate_on_container_move_assignment::value || cv_is_always_equal<allocator_type>::value >;
+
+    struct guard
+    {
+        allocator_type& a_;
+        T* p_;
+
+        ~guard()
+        {
+            if( p_ ) traits::deallocate( a_, p_, 1 );
+        }
+    };
+
+    T* p_;
+
+private:
+
+    template<class... Args> T* create( Args&&... args ) const
+    {
+        allocator_type a( holder_type::get() );
+
+        T* p = traits::allocate( a, 1 );
+        guard g{ a, p };
+
+        traits::construct( a, p, std::forward<Args>(args)... );
+
+        g.p_ = 0;
+        return p;
+    }
+
+    void destroy() noexcept
+    {
+        if( p_ )
+        {
+            allocator_type a( holder_type::get() );
+
+            traits::destroy( a, p_ );
+            traits::deallocate( a, p_, 1 );
+
+            p_ = 0;
+        }
+    }
+
+    T* node( mp11::mp_true )
+    {
+        if( !p_ ) p_ = create();
+        return p_;
+    }
+
+    T* node( mp11::mp_false ) noexcept
+    {
+        BOOST_ASSERT( p_ != 0 );
+        return p_;
+    }
+
+    T const* cnode( mp11::mp_true ) const noexcept( std::is_nothrow_default_constructible<T>::value )
+    {
+        if( p_ ) return p_;
+
+        static T const empty{};
+        return &empty;
+    }
+
+    T const* cnode( mp11::mp_false ) const noexcept
+    {
+        BOOST_ASSERT( p_ != 0 );
+        return p_;
+    }
+
+    static constexpr bool nothrow_cnode = !can_be_empty::value || std::is_nothrow_default_constructible<T>::value;
+
+    void move_assign( mp11::mp_true, cv_box& r ) noexcept
+    {
+        destroy();
+
+        holder_type::operator=( static_cast<holder_type&&>( r ) );
+
+        p_ = r.p_;
+        r.p_ = 0;
+    }
+
+    // the allocators differ and don't propagate; the value is moved
+    void move_assign( mp11::mp_false, cv_box& r )
+    {
+        if( holder_type::equals( r ) )
+        {
+            move_assign( mp11::mp_true(), r );
+        }
+        else if( r.p_ == 0 )
+        {
+            destroy();
+        }
+        else
+        {
+            assign( std::move( *r.p_ ) );
+        }
+    }
+
+public:
+
+    template<class... Args, class E = typename std::enable_if<std::is_constructible<T, Args&&...>::value>::type>
+    explicit cv_box( Args&&... args ): p_( create( std::forward<Args>(args)... ) )
+    {
+    }
+
+    template<class B, class... Args, class E = typename std::enable_if<std::is_constructible<T, Args&&...>::value>::type>
+    cv_box( std::allocator_arg_t, B const& a, Args&&... args ): holder_type( a ), p_( create( std::forward<Args>(args)... ) )
+    {
+    }
+
+    // a copy or a move of r, allocated from a
+
+    template<class B> cv_box( std::allocator_arg_t, B const& a, cv_box const& r ): holder_type( a ), p_( r.p_? create( *r.p_ ): 0 )
+    {
+    }
+
+    template<class B> cv_box( std::allocator_arg_t, B const& a, cv_box&& r ): holder_type( a ), p_( r.p_? create( std::move( *r.p_ ) ): 0 )
+    {
+    }
+
+    cv_box( cv_box const& r ): holder_type( static_cast<holder_type const&>( r ) ), p_( r.p_? create( *r.p_ ): 0 )
+    {
+    }
+
+    cv_box( cv_box&& r ) noexcept: holder_type( static_cast<holder_type&&>( r ) ), p_( r.p_ )
+    {
+        r.p_ = 0;
+    }
+
+    ~cv_box() noexcept
+    {
+        destroy();
+    }
+
+    cv_box& operator=( cv_box const& r )
+    {
+        if( this == &r ) return *this;
+
+        if( traits::propagate_on_container_copy_assignment::value && !holder_type::equals( r ) )
+        {
+            destroy();
+        }
+
+        holder_type::operator=( static_cast<holder_type const&>( r ) );
+
+        if( r.p_ )
+        {
+            assign( *r.p_ );
+        }
+        else
+        {
+            destroy();
+        }
+
+        return *this;
+    }
+
+    cv_box& operator=( cv_box&& r ) noexcept( steals_on_move::value )
+    {
+        if( this != &r )
+        {
+            move_assign( steals_on_move(), r );
+        }
+
+        return *this;
+    }
+
+    template<class U> void assign( U&& u )
+    {
+        if( p_ )
+        {
+            *p_ = std::forward<U>(u);
+        }
+        else
+        {
+            p_ = create( std::forward<U>(u) );
+        }
+    }
+
+    // the non-const accessors allocate the node of an empty box
+
+    T& operator*() &
+    {
+        return *node( can_be_empty() );
+    }
+
+    T const& operator*() const& noexcept( nothrow_cnode )
+    {
+        return *cnode( can_be_empty() );
+    }
+
+    T&& operator*() &&
+    {
+        return std::move( *node( can_be_empty() ) );
+    }
+
+    T const&& operator*() const&& noexcept( nothrow_cnode )
+    {
+        return std::move( *cnode( can_be_empty() ) );
+    }
+
+    friend bool operator==( cv_box const& x, cv_box const& y )
+    {
+        return *x == *y;
+    }
+
+    friend bool operator!=( cv_box const& x, cv_box const& y )
+    {
+        return *x != *y;
+    }
+
+    friend bool operator<( cv_box const& x, cv_box const& y )
+    {
+        return *x < *y;
+    }
+
+    friend bool operator>( cv_box const& x, cv_box const& y )
+    {
+        return *x > *y;
+    }
+
+    friend bool operator<=( cv_box const& x, cv_box const& y )
+    {
+        return *x <= *y;
+    }
+
+    friend bool operator>=( cv_box const& x, cv_box const& y )
+    {
+        return *x >= *y;
+    }
+};
+
+template<class T> struct is_cv_box: std::false_type
+{
+};
+
+template<class T, class A> struct is_cv_box<cv_box<T, A>>: std::true_type
+{
+};
+
+template<std::size_t N, class A, class T> using cv_stored = mp11::mp_if_c<( sizeof(T) > N ), cv_box<T, A>, T>;
+
+// cv_unbox
+
+template<class X> X&& cv_unbox_( mp11::mp_false, X&& x ) noexcept
+{
+    return std::forward<X>(x);
+}
+
+template<class X> auto cv_unbox_( mp11::mp_true, X&& x ) noexcept( noexcept( *std::forward<X>(x) ) ) -> decltype( *std::forward<X>(x) )
+{
+    return *std::forward<X>(x);
+}
+
+template<class X> auto cv_unbox( X&& x ) noexcept( noexcept( cv_unbox_( is_cv_box<remove_cv_ref_t<X>>(), std::forward<X>(x) ) ) ) -> decltype( cv_unbox_( is_cv_box<remove_cv_ref_t<X>>(), std::forward<X>(x) ) )
+{
+    return cv_unbox_( is_cv_box<remove_cv_ref_t<X>>(), std::forward<X>(x) );
+}
+
+// cv_assign
+
+template<class X, class U> void cv_assign( X& x, U&& u )
+{
+    x = std::forward<U>(u);
+}
+
+template<class T, class A, class U> void cv_assign( cv_box<T, A>& x, U&& u )
+{
+    x.assign( std::forward<U>(u) );
+}
+
+// cv_emplace, with the allocator of the boxed alternatives
+
+template<std::size_t I, class V, class Al, class... Args> mp11::mp_at_c<V, I>& cv_emplace_( mp11::mp_true, V& v, Al const& a, Args&&... args )
+{
+    return v.template emplace<I>( std::allocator_arg, a, std::forward<Args>(args)... );
+}
+
+template<std::size_t I, class V, class Al, class... Args> mp11::mp_at_c<V, I>& cv_emplace_( mp11::mp_false, V& v, Al const&, Args&&... args )
+{
+    return v.template emplace<I>( std::forward<Args>(args)... );
+}
+
+template<std::size_t I, class V, class Al, class... Args> mp11::mp_at_c<V, I>& cv_emplace( V& v, Al const& a, Args&&... args )
+{
+    return cv_emplace_<I>( is_cv_box<mp11::mp_at_c<V, I>>(), v, a, std::forward<Args>(args)... );
+}
+
+// cv_storage<A, V> holds the variant V of the stored alternatives and the
+// allocator for the new boxes
+
+template<class A, class V> struct cv_storage_base: cv_allocator<A>
+{
+    V v_;
+
+    cv_storage_base() = default;
+
+    template<std::size_t I, class... Args> cv_storage_base( mp11::mp_true, A const& a, in_place_index_t<I> i, Args&&... args ): cv_allocator<A>( a ), v_( i, std::allocator_arg, a, std::forward<Args>(args)... )
+    {
+    }
+
+    template<std::size_t I, class... Args> cv_storage_base( mp11::mp_false, A const& a, in_place_index_t<I> i, Args&&... args ): cv_allocator<A>( a ), v_( i, std::forward<Args>(args)... )
+    {
+    }
+
+    template<std::size_t I, class... Args> cv_storage_base( A const& a, in_place_index_t<I> i, Args&&... args ): cv_storage_base( is_cv_box<mp11::mp_at_c<V, I>>(), a, i, std::forward<Args>(args)... )
+    {
+    }
+
+    template<std::size_t I, class... Args> mp11::mp_at_c<V, I>& emplace( Args&&... args )
+    {
+        return cv_emplace<I>( v_, this->get(), std::forward<Args>(args)... );
+    }
+};
+
+template<class S, class R> struct cv_storage_assign_L
+{
+    S* this_;
+    R r;
+
+    template<class I> void operator()( I ) const
+    {
+        this_->template emplace<I::value>( unsafe_get<I::value>( std::forward<R>(r) ) );
+    }
+};
+
+template<class A, class V, bool S = !cv_is_always_equal<A>::value> struct cv_storage: cv_storage_base<A, V>
+{
+    using cv_storage_base<A, V>::cv_storage_base;
+};
+
+// a stateful allocator that doesn't propagate keeps allocating the
+// alternatives assigned from another variant
+
+template<class A, class V> struct cv_storage<A, V, true>: cv_storage_base<A, V>
+{
+    using cv_storage_base<A, V>::cv_storage_base;
+
+    using traits = std::allocator_traits<A>;
+
+    cv_storage() = default;
+
+    cv_storage( cv_storage const& ) = default;
+    cv_storage( cv_storage&& ) = default;
+
+    cv_storage& operator=( cv_storage const& r )
+    {
+        if( this != &r )
+        {
+            cv_allocator<A>::operator=( static_cast<cv_allocator<A> const&>( r ) );
+
+            if( this->v_.index() == r.v_.index() )
+            {
+                this->v_ = r.v_;
+            }
+            else
+            {
+                detail::with_index<V, mp11::mp_size<V>::value>( r.v_.index(), cv_storage_assign_L<cv_storage, V const&>{ this, r.v_ } );
+            }
+        }
+
+        return *this;
+    }
+
+    cv_storage& operator=( cv_storage&& r ) noexcept( traits::propagate_on_container_move_assignment::value && std::is_nothrow_move_assignable<V>::value )
+    {
+        if( this != &r )
+        {
+            bool steal = traits::propagate_on_container_move_assignment::value || this->equals( r );
+
+            cv_allocator<A>::operator=( static_cast<cv_allocator<A>&&>( r ) );
+
+            if( steal || this->v_.index() == r.v_.index() )
+            {
+                this->v_ = std::move( r.v_ );
+            }
+            else
+            {
+                detail::with_index<V, mp11::mp_size<V>::value>( r.v_.index(), cv_storage_assign_L<cv_storage, V&&>{ this, std::move( r.v_ ) } );
+            }
+        }
+
+        return *this;
+    }
+};
+
+template<class T> struct is_compact_variant: std::false_type
+{
+};
+
+template<std::size_t N, class A, class... T> struct is_compact_variant<basic_compact_variant<N, A, T...>>: std::true_type
+{
+};
+
+// a stateless allocator isn't stored
+
+template<class A> using cv_allocator_relocatable = mp11::mp_or<cv_is_always_equal<A>, is_trivially_relocatable<A>>;
+
+} // namespace detail
+
+template<std::size_t N, class A, class... T> class basic_compact_variant
+{
+private:
+
+    using L = mp11::mp_list<T...>;
+
+    using base_type = variant<detail::cv_stored<N, A, T>...>;
+
+    using storage_type = detail::cv_storage<A, base_type>;
+
+    storage_type st_;
+
+public:
+
+    using allocator_type = A;
+
+    // constructors
+
+    template<class E1 = void, class E2 = mp11::mp_if<std::is_default_constructible<base_type>, E1>>
+    basic_compact_variant() noexcept( std::is_nothrow_default_constructible<storage_type>::value )
+    {
+    }
+
+    // basic_compact_variant( basic_compact_variant const& ) = default;
+    // basic_compact_variant( basic_compact_variant && ) = default;
+
+    template<class U,
+        class Ud = typename std::decay<U>::type,
+        class E1 = typename std::enable_if< !std::is_same<Ud, basic_compact_variant>::value && !std::is_same<Ud, std::allocator_arg_t>::value && !detail::is_in_place_index<Ud>::value && !detail::is_in_place_type<Ud>::value >::type,
+        class V = detail::resolve_overload_type<U&&, T...>,
+        class E2 = typename std::enable_if<std::is_constructible<V, U&&>::value>::type
+        >
+    basic_compact_variant( U&& u ): st_( A(), in_place_index_t<detail::resolve_overload_index<U&&, T...>::value>(), std::forward<U>(u) )
+    {
+    }
+
+    template<class U, class... Args, class I = mp11::mp_find<L, U>, class E = typename std::enable_if<std::is_constructible<U, Args&&...>::value>::type>
+    explicit basic_compact_variant( in_place_type_t<U>, Args&&... args ): st_( A(), in_place_index_t<I::value>(), std::forward<Args>(args)... )
+    {
+    }
+
+    template<std::size_t I, class... Args, class E = typename std::enable_if<std::is_constructible<mp11::mp_at_c<L, I>, Args&&...>::value>::type>
+    explicit basic_compact_variant( in_place_index_t<I>, Args&&... args ): st_( A(), in_place_index_t<I>(), std::forward<Args>(args)... )
+    {
+    }
+
+    // allocator-extended constructors
+
+    template<class E1 = void, class E2 = mp11::mp_if<std::is_default_constructible<mp11::mp_first<L>>, E1>>
+    basic_compact_variant( std::allocator_arg_t, A const& a ): st_( a, in_place_index_t<0>() )
+    {
+    }
+
+    template<class U,
+        class Ud = typename std::decay<U>::type,
+        class E1 = typename std::enable_if< !std::is_same<Ud, basic_compact_variant>::value && !detail::is_in_place_index<Ud>::value && !detail::is_in_place_type<Ud>::value >::type,
+        class V = detail::resolve_overload_type<U&&, T...>,
+        class E2 = typename std::enable_if<std::is_constructible<V, U&&>::value>::type
+        >
+    basic_compact_variant( std::allocator_arg_t, A const& a, U&& u ): st_( a, in_place_index_t<detail::resolve_overload_index<U&&, T...>::value>(), std::forward<U>(u) )
+    {
+    }
+
+    template<class U, class... Args, class I = mp11::mp_find<L, U>, class E = typename std::enable_if<std::is_constructible<U, Args&&...>::value>::type>
+    basic_compact_variant( std::allocator_arg_t, A const& a, in_place_type_t<U>, Args&&... args ): st_( a, in_place_index_t<I::value>(), std::forward<Args>(args)... )
+    {
+    }
+
+    template<std::size_t I, class... Args, class E = typename std::enable_if<std::is_constructible<mp11::mp_at_c<L, I>, Args&&...>::value>::type>
+    basic_compact_variant( std::allocator_arg_t, A const& a, in_place_index_t<I>, Args&&... args ): st_( a, in_place_index_t<I>(), std::forward<Args>(args)... )
+    {
+    }
+
+    // assignment
+
+    // basic_compact_variant& operator=( basic_compact_variant const& ) = default;
+    // basic_compact_variant& operator=( basic_compact_variant && ) = default;
+
+    template<class U,
+        class E1 = typename std::enable_if<!std::is_same<typename std::decay<U>::type, basic_compact_variant>::value>::type,
+        class V = detail::resolve_overload_type<U, T...>,
+        class E2 = typename std::enable_if<std::is_assignable<V&, U&&>::value && std::is_constructible<V, U&&>::value>::type
+        >
+    basic_compact_variant& operator=( U&& u )
+    {
+        std::size_t const I = detail::resolve_overload_index<U, T...>::value;
+
+        if( st_.v_.index() == I )
+        {
+            detail::cv_assign( unsafe_get<I>( st_.v_ ), std::forward<U>(u) );
+        }
+        else
+        {
+            st_.template emplace<I>( std::forward<U>(u) );
+        }
+
+        return *this;
+    }
+
+    // modifiers
+
+    template<std::size_t I, class... Args, class E = typename std::enable_if<std::is_constructible<mp11::mp_at_c<L, I>, Args&&...>::value>::type>
+    variant_alternative_t<I, basic_compact_variant>& emplace( Args&&... args )
+    {
+        return detail::cv_unbox( st_.template emplace<I>( std::forward<Args>(args)... ) );
+    }
+
+    template<class U, class... Args, class E = typename std::enable_if< mp11::mp_count<L, U>::value == 1 && std::is_constructible<U, Args&&...>::value >::type>
+    U& emplace( Args&&... args )
+    {
+        using I = mp11::mp_find<L, U>;
+        return this->template emplace<I::value>( std::forward<Args>(args)... );
+    }
+
+    // requires equal allocators, unless they propagate on swap
+    void swap( basic_compact_variant& r ) noexcept( noexcept( std::declval<base_type&>().swap( std::declval<base_type&>() ) ) )
+    {
+        st_.v_.swap( r.st_.v_ );
+    }
+
+    allocator_type get_allocator() const noexcept
+    {
+        return st_.get();
+    }
+
+    // value status
+
+    constexpr std::size_t index() const noexcept
+    {
+        return st_.v_.index();
+    }
+
+    constexpr bool valueless_by_exception() const noexcept
+    {
+        return false;
+    }
+
+    // private accessors
+
+    base_type& _base() & noexcept
+    {
+        return st_.v_;
+    }
+
+    base_type const& _base() const& noexcept
+    {
+        return st_.v_;
+    }
+
+    base_type&& _base() && noexcept
+    {
+        return std::move( st_.v_ );
+    }
+
+    base_type const&& _base() const&& noexcept
+    {
+        return std::move( st_.v_ );
+    }
+};
+
+// is_trivially_relocatable
+
+template<class T, class A> struct is_trivially_relocatable<detail::cv_box<T, A>>: detail::cv_allocator_relocatable<typename std::allocator_traits<A>::template rebind_alloc<T>>
+{
+};
+
+template<std::size_t N, class A, class... T> struct is_trivially_relocatable<basic_compact_variant<N, A, T...>>: mp11::mp_and<is_trivially_relocatable<variant<detail::cv_stored<N, A, T>...>>, detail::cv_allocator_relocatable<A>>
+{
+};
+
+// holds_alternative
+
+template<class U, std::size_t N, class A, class... T> bool holds_alternative( basic_compact_variant<N, A, T...> const& v ) noexcept
+{
+    static_assert( mp11::mp_count<mp11::mp_list<T...>, U>::value == 1, "The type must occur exactly once in the list of variant alternatives" );
+    return v.index() == mp11::mp_find<mp11::mp_list<T...>, U>::value;
+}
+
+// get (index)
+
+template<std::size_t I, std::size_t N, class A, class... T> variant_alternative_t<I, basic_compact_variant<N, A, T...>>& get( basic_compact_variant<N, A, T...>& v )
+{
+    return detail::cv_unbox( get<I>( v._base() ) );
+}
+
+template<std::size_t I, std::size_t N, class A, class... T> variant_alternative_t<I, basic_compact_variant<N, A, T...>>&& get( basic_compact_variant<N, A, T...>&& v )
+{
+    return detail::cv_unbox( get<I>( std::move( v )._base() ) );
+}
+
+template<std::size_t I, std::size_t N, class A, class... T> variant_alternative_t<I, basic_compact_variant<N, A, T...>> const& get( basic_compact_variant<N, A, T...> const& v )
+{
+    return detail::cv_unbox( get<I>( v._base() ) );
+}
+
+template<std::size_t I, std::size_t N, class A, class... T> variant_alternative_t<I, basic_compact_variant<N, A, T...>> const&& get( basic_compact_variant<N, A, T...> const&& v )
+{
+    return detail::cv_unbox( get<I>( std::move( v )._base() ) );
+}
+
+// get (type)
+
+template<class U, std::size_t N, class A, class... T> U& get( basic_compact_variant<N, A, T...>& v )
+{
+    static_assert( mp11::mp_count<mp11::mp_list<T...>, U>::value == 1, "The type must occur exactly once in the list of variant alternatives" );
+    return get<mp11::mp_find<mp11::mp_list<T...>, U>::value>( v );
+}
+
+template<class U, std::size_t N, class A, class... T> U&& get( basic_compact_variant<N, A, T...>&& v )
+{
+    static_assert( mp11::mp_count<mp11::mp_list<T...>, U>::value == 1, "The type must occur exactly once in the list of variant alternatives" );
+    return get<mp11::mp_find<mp11::mp_list<T...>, U>::value>( std::move( v ) );
+}
+
+template<class U, std::size_t N, class A, class... T> U const& get( basic_compact_variant<N, A, T...> const& v )
+{
+    static_assert( mp11::mp_count<mp11::mp_list<T...>, U>::value == 1, "The type must occur exactly once in the list of variant alternatives" );
+    return get<mp11::mp_find<mp11::mp_list<T...>, U>::value>( v );
+}
+
+template<class U, std::size_t N, class A, class... T> U const&& get( basic_compact_variant<N, A, T...> const&& v )
+{
+    static_assert( mp11::mp_count<mp11::mp_list<T...>, U>::value == 1, "The type must occur exactly once in the list of variant alternatives" );
+    return get<mp11::mp_find<mp11::mp_list<T...>, U>::value>( std::move( v ) );
+}
+
+// unsafe_get
+
+template<std::size_t I, std::size_t N, class A, class... T> variant_alternative_t<I, basic_compact_variant<N, A, T...>>& unsafe_get( basic_compact_variant<N, A, T...>& v )
+{
+    return detail::cv_unbox( unsafe_get<I>( v._base() ) );
+}
+
+template<std::size_t I, std::size_t N, class A, class... T> variant_alternative_t<I, basic_compact_variant<N, A, T...>>&& unsafe_get( basic_compact_variant<N, A, T...>&& v )
+{
+    return detail::cv_unbox( unsafe_get<I>( std::move( v )._base() ) );
+}
+
+template<std::size_t I, std::size_t N, class A, class... T> variant_alternative_t<I, basic_compact_variant<N, A, T...>> const& unsafe_get( basic_compact_variant<N, A, T...> const& v )
+{
+    return detail::cv_unbox( unsafe_get<I>( v._base() ) );
+}
+
+template<std::size_t I, std::size_t N, class A, class... T> variant_alternative_t<I, basic_compact_variant<N, A, T...>> const&& unsafe_get( basic_compact_variant<N, A, T...> const&& v )
+{
+    return detail::cv_unbox( unsafe_get<I>( std::move( v )._base() ) );
+}
+
+// get_if
+
+// the non-const overloads allocate the node of a moved-from alternative
+
+template<std::size_t I, std::size_t N, class A, class... T> variant_alternative_t<I, basic_compact_variant<N, A, T...>>* get_if( basic_compact_variant<N, A, T...>* v )
+{
+    static_assert( I < sizeof...(T), "Index out of bounds" );
+    return v && v->index() == I? &unsafe_get<I>( *v ): 0;
+}
+
+template<std::size_t I, std::size_t N, class A, class... T> variant_alternative_t<I, basic_compact_variant<N, A, T...>> const* get_if( basic_compact_variant<N, A, T...> const* v ) noexcept
+{
+    static_assert( I < sizeof...(T), "Index out of bounds" );
+    return v && v->index() == I? &unsafe_get<I>( *v ): 0;
+}
+
+template<class U, std::size_t N, class A, class... T> U* get_if( basic_compact_variant<N, A, T...>* v )
+{
+    static_assert( mp11::mp_count<mp11::mp_list<T...>, U>::value == 1, "The type must occur exactly once in the list of variant alternatives" );
+    return get_if<mp11::mp_find<mp11::mp_list<T...>, U>::value>( v );
+}
+
+template<class U, std::size_t N, class A, class... T> U const* get_if( basic_compact_variant<N, A, T...> const* v ) noexcept
+{
+    static_assert( mp11::mp_count<mp11::mp_list<T...>, U>::value == 1, "The type must occur exactly once in the list of variant alternatives" );
+    return get_if<mp11::mp_find<mp11::mp_list<T...>, U>::value>( v );
+}
+
+// relational operators
+
+template<std::size_t N, class A, class... T> bool operator==( basic_compact_variant<N, A, T...> const& v, basic_compact_variant<N, A, T...> const& w )
+{
+    return v._base() == w._base();
+}
+
+template<std::size_t N, class A, class... T> bool operator!=( basic_compact_variant<N, A, T...> const& v, basic_compact_variant<N, A, T...> const& w )
+{
+    return v._base() != w._base();
+}
+
+template<std::size_t N, class A, class... T> bool operator<( basic_compact_variant<N, A, T...> const& v, basic_compact_variant<N, A, T...> const& w )
+{
+    return v._base() < w._base();
+}
+
+template<std::size_t N, class A, class... T> bool operator>( basic_compact_variant<N, A, T...> const& v, basic_compact_variant<N, A, T...> const& w )
+{
+    return v._base() > w._base();
+}
+
+template<std::size_t N, class A, class... T> bool operator<=( basic_compact_variant<N, A, T...> const& v, basic_compact_variant<N, A, T...> const& w )
+{
+    return v._base() <= w._base();
+}
+
+template<std::size_t N, class A, class... T> bool operator>=( basic_compact_variant<N, A, T...> const& v, basic_compact_variant<N, A, T...> const& w )
+{
+    return v._base() >= w._base();
+}
+
+// swap
+
+template<std::size_t N, class A, class... T> void swap( basic_compact_variant<N, A, T...>& v, basic_compact_variant<N, A, T...>& w ) noexcept( noexcept( v.swap( w ) ) )
+{
+    v.swap( w );
+}
+
+// visitation
+
+namespace detail
+{
+
+template<class F> struct cv_unbox_F
+{
+    F&& f;
+
+    template<class... X> auto operator()( X&&... x ) const -> decltype( std::forward<F>(f)( cv_unbox( std::forward<X>(x) )... ) )
+    {
+        return std::forward<F>(f)( cv_unbox( std::forward<X>(x) )... );
+    }
+};
+
+template<class V> using cv_base_t = decltype( std::declval<V>()._base() );
+
+} // namespace detail
+
+template<class R = detail::deduced, class F, class V1, class... V,
+    class E = typename std::enable_if< mp11::mp_all<detail::is_compact_variant<detail::remove_cv_ref_t<V1>>, detail::is_compact_variant<detail::remove_cv_ref_t<V>>...>::value >::type>
+auto visit( F&& f, V1&& v1, V&&... v ) -> detail::Vret<R, detail::cv_unbox_F<F>, detail::cv_base_t<V1>, detail::cv_base_t<V>...>
+{
+    return visit<R>( detail::cv_unbox_F<F>{ std::forward<F>(f) }, std::forward<V1>(v1)._base(), std::forward<V>(v)._base()... );
+}
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_COMPACT_VARIANT_HPP_INCLUDED
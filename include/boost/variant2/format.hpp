@@ -0,0 +1,294 @@
+#ifndef BOOST_VARIANT2_FORMAT_HPP_INCLUDED
+#define BOOST_VARIANT2_FORMAT_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+
+#if defined(__has_include)
+# if __has_include(<version>)
+#  include <version>
+# endif
+#endif
+
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+# include <format>
+# include <string_view>
+#endif
+
+// std::formatter is specialized when <format> is available;
+// fmt::formatter is specialized when <fmt/format.h> has been included before this header
+
+namespace boost
+{
+namespace variant2
+{
+namespace detail
+{
+
+// the end of a format specification, the first '}' outside a nested replacement field
+
+template<class It> BOOST_CXX14_CONSTEXPR It format_spec_end( It first, It last )
+{
+    int depth = 0;
+
+    for( ; first != last; ++first )
+    {
+        if( *first == '{' )
+        {
+            ++depth;
+        }
+        else if( *first == '}' )
+        {
+            if( depth == 0 ) break;
+            --depth;
+        }
+    }
+
+    return first;
+}
+
+// a format specification, with the automatic argument ids of its nested
+// replacement fields replaced by the ids they were given by the enclosing
+// format string, so that it can be parsed again by the formatter of the
+// active alternative
+
+template<class Ch> struct format_spec
+{
+    static constexpr std::size_t capacity = 64;
+
+    Ch data[ capacity ] = {};
+    std::size_t size = 0;
+
+    BOOST_CXX14_CONSTEXPR bool push_back( Ch c )
+    {
+        if( size == capacity ) return false;
+
+        data[ size++ ] = c;
+        return true;
+    }
+
+    BOOST_CXX14_CONSTEXPR bool append_number( std::size_t n )
+    {
+        Ch tmp[ 24 ] = {};
+        std::size_t k = 0;
+
+        do
+        {
+            tmp[ k++ ] = static_cast<Ch>( '0' + n % 10 );
+            n /= 10;
+        }
+        while( n != 0 );
+
+        while( k != 0 )
+        {
+            if( !push_back( tmp[ --k ] ) ) return false;
+        }
+
+        return true;
+    }
+};
+
+// copies [first, last) into spec; returns false when it doesn't fit
+
+template<class PC, class It, class Ch> BOOST_CXX14_CONSTEXPR bool format_spec_resolve( PC& ctx, It first, It last, format_spec<Ch>& spec )
+{
+    while( first != last )
+    {
+        Ch c = *first++;
+
+        if( !spec.push_back( c ) ) return false;
+        if( c != '{' ) continue;
+
+        It q = first;
+        while( q != last && *q != '}' ) ++q;
+
+        if( q == first )
+        {
+            // automatic, take the next id of the enclosing format string
+            if( !spec.append_number( static_cast<std::size_t>( ctx.next_arg_id() ) ) ) return false;
+        }
+        else
+        {
+            // manual, or a name
+            bool numeric = true;
+            std::size_t n = 0;
+
+            for( It r = first; r != q; ++r )
+            {
+                if( *r < '0' || *r > '9' )
+                {
+                    numeric = false;
+                    break;
+                }
+
+                n = n * 10 + static_cast<std::size_t>( *r - '0' );
+            }
+
+            if( numeric )
+            {
+                ctx.check_arg_id( static_cast<decltype( ctx.next_arg_id() )>( n ) );
+            }
+
+            for( ; first != q; ++first )
+            {
+                if( !spec.push_back( *first ) ) return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// formats the active alternative, with the format specification
+// of the variant parsed by the formatter of the alternative
+
+template<template<class> class F, class PC, class SV, class Ctx> struct format_L
+{
+    SV spec;
+    Ctx& ctx;
+
+    template<class T> auto operator()( T const& t ) const -> decltype( ctx.out() )
+    {
+        F<T> f;
+
+        PC pc( spec );
+        f.parse( pc );
+
+        return f.format( t, ctx );
+    }
+};
+
+} // namespace detail
+} // namespace variant2
+} // namespace boost
+
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+
+namespace boost
+{
+namespace variant2
+{
+namespace detail
+{
+
+template<class Ch> struct std_formatter
+{
+    template<class T> using fn = std::formatter<T, Ch>;
+};
+
+} // namespace detail
+} // namespace variant2
+} // namespace boost
+
+namespace std
+{
+
+template<class Ch> struct formatter<boost::variant2::monostate, Ch>: formatter<basic_string_view<Ch>, Ch>
+{
+    template<class Ctx> typename Ctx::iterator format( boost::variant2::monostate, Ctx& ctx ) const
+    {
+        static constexpr Ch name[] = { 'm', 'o', 'n', 'o', 's', 't', 'a', 't', 'e' };
+        return formatter<basic_string_view<Ch>, Ch>::format( basic_string_view<Ch>( name, sizeof(name) / sizeof(Ch) ), ctx );
+    }
+};
+
+template<class... T, class Ch> struct formatter<boost::variant2::variant<T...>, Ch>
+{
+private:
+
+    boost::variant2::detail::format_spec<Ch> spec_;
+
+public:
+
+    constexpr typename basic_format_parse_context<Ch>::iterator parse( basic_format_parse_context<Ch>& ctx )
+    {
+        auto first = ctx.begin();
+        auto last = boost::variant2::detail::format_spec_end( first, ctx.end() );
+
+        if( !boost::variant2::detail::format_spec_resolve( ctx, first, last, spec_ ) )
+        {
+            throw format_error( "format specification of a variant is too long" );
+        }
+
+        return last;
+    }
+
+    template<class Ctx> typename Ctx::iterator format( boost::variant2::variant<T...> const& v, Ctx& ctx ) const
+    {
+        using L = boost::variant2::detail::format_L<boost::variant2::detail::std_formatter<Ch>::template fn, basic_format_parse_context<Ch>, basic_string_view<Ch>, Ctx>;
+        return boost::variant2::visit( L{ basic_string_view<Ch>( spec_.data, spec_.size ), ctx }, v );
+    }
+};
+
+} // namespace std
+
+#endif // #if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+
+#if defined(FMT_VERSION)
+
+namespace boost
+{
+namespace variant2
+{
+namespace detail
+{
+
+template<class Ch> struct fmt_formatter
+{
+    template<class T> using fn = fmt::formatter<T, Ch>;
+};
+
+} // namespace detail
+} // namespace variant2
+} // namespace boost
+
+namespace fmt
+{
+
+template<class Ch> struct formatter<boost::variant2::monostate, Ch>: formatter<basic_string_view<Ch>, Ch>
+{
+    template<class Ctx> auto format( boost::variant2::monostate, Ctx& ctx ) const -> decltype( ctx.out() )
+    {
+        static constexpr Ch name[] = { 'm', 'o', 'n', 'o', 's', 't', 'a', 't', 'e' };
+        return formatter<basic_string_view<Ch>, Ch>::format( basic_string_view<Ch>( name, sizeof(name) / sizeof(Ch) ), ctx );
+    }
+};
+
+template<class... T, class Ch> struct formatter<boost::variant2::variant<T...>, Ch>
+{
+private:
+
+    boost::variant2::detail::format_spec<Ch> spec_;
+
+public:
+
+    BOOST_CXX14_CONSTEXPR typename basic_format_parse_context<Ch>::iterator parse( basic_format_parse_context<Ch>& ctx )
+    {
+        auto first = ctx.begin();
+        auto last = boost::variant2::detail::format_spec_end( first, ctx.end() );
+
+        if( !boost::variant2::detail::format_spec_resolve( ctx, first, last, spec_ ) )
+        {
+            FMT_THROW( format_error( "format specification of a variant is too long" ) );
+        }
+
+        return last;
+    }
+
+    template<class Ctx> auto format( boost::variant2::variant<T...> const& v, Ctx& ctx ) const -> decltype( ctx.out() )
+    {
+        using L = boost::variant2::detail::format_L<boost::variant2::detail::fmt_formatter<Ch>::template fn, basic_format_parse_context<Ch>, basic_string_view<Ch>, Ctx>;
+        return boost::variant2::visit( L{ basic_string_view<Ch>( spec_.data, spec_.size ), ctx }, v );
+    }
+};
+
+} // namespace fmt
+
+#endif // #if defined(FMT_VERSION)
+
+#endif // #ifndef BOOST_VARIANT2_FORMAT_HPP_INCLUDED
@@ -0,0 +1,840 @@
+#ifndef BOOST_VARIANT2_JSON_READER_HPP_INCLUDED
+#define BOOST_VARIANT2_JSON_READER_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/json/basic_parser_impl.hpp>
+#include <boost/json/value_stack.hpp>
+#include <boost/json/value_to.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/mp11.hpp>
+#include <boost/config.hpp>
+#include <string>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace boost
+{
+namespace variant2
+{
+
+namespace detail
+{
+
+template<class T, class E = void> struct json_read_sink;
+
+// a number, as reported by the parser
+
+struct json_read_number
+{
+    enum kind_type { int64, uint64, double_ };
+
+    kind_type kind;
+
+    std::int64_t i;
+    std::uint64_t u;
+    double d;
+
+    boost::json::value to_value() const
+    {
+        switch( kind )
+        {
+        case int64: return boost::json::value( i );
+        case uint64: return boost::json::value( u );
+        default: return boost::json::value( d );
+        }
+    }
+};
+
+class json_read_context;
+
+// the operations of a value that is being read; p points to the object that
+// receives the value, or, for the elements of an array, to the sequence
+
+struct json_read_ops
+{
+    bool (*null)( void* p );
+    bool (*bool_)( void* p, bool b );
+    bool (*number)( void* p, json_read_number const& n );
+    bool (*string)( void* p, boost::json::string_view s );
+    bool (*array)( void* p, json_read_context& cx );
+    bool (*object)( void* p, json_read_context& cx );
+};
+
+// the state of the handler that the sinks can change
+
+class json_read_context
+{
+private:
+
+    struct frame
+    {
+        void* p;
+        json_read_ops const* ops;
+    };
+
+    std::vector<frame> frames_;
+
+    // the depth of the array or object that is collected into st_, or 0
+    std::size_t depth_;
+
+    boost::json::value_stack st_;
+
+    void* target_;
+    bool (*assign_)( void* p, boost::json::value const& jv );
+
+protected:
+
+    json_read_context( void* p, json_read_ops const* ops ): depth_( 0 ), target_( 0 ), assign_( 0 )
+    {
+        frames_.push_back( frame{ p, ops } );
+    }
+
+    bool collecting() const noexcept
+    {
+        return depth_ != 0;
+    }
+
+    boost::json::value_stack& stack() noexcept
+    {
+        return st_;
+    }
+
+    void* top() const noexcept
+    {
+        return frames_.back().p;
+    }
+
+    json_read_ops const& ops() const noexcept
+    {
+        return *frames_.back().ops;
+    }
+
+    void enter() noexcept
+    {
+        ++depth_;
+    }
+
+    // called after the end of an array or object has been pushed to st_
+    bool leave()
+    {
+        if( --depth_ != 0 ) return true;
+
+        boost::json::value jv = st_.release();
+        return assign_( target_, jv );
+    }
+
+    void pop() noexcept
+    {
+        BOOST_ASSERT( frames_.size() > 1 );
+        frames_.pop_back();
+    }
+
+public:
+
+    // reads the elements of the array that has just begun with ops,
+    // which receive a pointer to the sequence p
+    void push( void* p, json_read_ops const* ops )
+    {
+        frames_.push_back( frame{ p, ops } );
+    }
+
+    // collects the array or object that has just begun into a json::value,
+    // and passes it to assign( p, jv ) when it ends
+    void collect( void* p, bool (*assign)( void* p, boost::json::value const& jv ) )
+    {
+        BOOST_ASSERT( depth_ == 0 );
+
+        st_.reset();
+
+        depth_ = 1;
+        target_ = p;
+        assign_ = assign;
+    }
+};
+
+// reads a T from a json::value with boost::json::try_value_to
+
+template<class T> bool json_read_assign( void* p, boost::json::value const& jv )
+{
+    auto r = boost::json::try_value_to<T>( jv );
+
+    if( !r ) return false;
+
+    *static_cast<T*>( p ) = std::move( *r );
+    return true;
+}
+
+// the operations of a single value of type T
+
+template<class T> struct json_value_fns
+{
+    static bool null( void* p )
+    {
+        return json_read_sink<T>::null( *static_cast<T*>( p ) );
+    }
+
+    static bool bool_( void* p, bool b )
+    {
+        return json_read_sink<T>::bool_( *static_cast<T*>( p ), b );
+    }
+
+    static bool number( void* p, json_read_number const& n )
+    {
+        return json_read_sink<T>::number( *static_cast<T*>( p ), n );
+    }
+
+    static bool string( void* p, boost::json::string_view s )
+    {
+        return json_read_sink<T>::string( *static_cast<T*>( p ), s );
+    }
+
+    static bool array( void* p, json_read_context& cx )
+    {
+        return json_read_sink<T>::array( *static_cast<T*>( p ), cx );
+    }
+
+    static bool object( void* p, json_read_context& cx )
+    {
+        return json_read_sink<T>::object( *static_cast<T*>( p ), cx );
+    }
+
+    static json_read_ops const ops;
+};
+
+template<class T> json_read_ops const json_value_fns<T>::ops = { &null, &bool_, &number, &string, &array, &object };
+
+// the operations of the elements of a sequence S; each appends an element
+
+template<class S> struct json_element_fns
+{
+    using U = typename S::value_type;
+
+    static U& next( void* p )
+    {
+        S& s = *static_cast<S*>( p );
+
+        s.emplace_back();
+        return s.back();
+    }
+
+    static bool null( void* p )
+    {
+        return json_read_sink<U>::null( next( p ) );
+    }
+
+    static bool bool_( void* p, bool b )
+    {
+        return json_read_sink<U>::bool_( next( p ), b );
+    }
+
+    static bool number( void* p, json_read_number const& n )
+    {
+        return json_read_sink<U>::number( next( p ), n );
+    }
+
+    static bool string( void* p, boost::json::string_view s )
+    {
+        return json_read_sink<U>::string( next( p ), s );
+    }
+
+    static bool array( void* p, json_read_context& cx )
+    {
+        return json_read_sink<U>::array( next( p ), cx );
+    }
+
+    static bool object( void* p, json_read_context& cx )
+    {
+        return json_read_sink<U>::object( next( p ), cx );
+    }
+
+    static json_read_ops const ops;
+};
+
+template<class S> json_read_ops const json_element_fns<S>::ops = { &null, &bool_, &number, &string, &array, &object };
+
+template<class T> using json_sequence_push = decltype( std::declval<T&>().emplace_back(), std::declval<T&>().back() );
+
+template<class T> using json_is_readable_sequence = mp11::mp_bool<
+    mp11::mp_valid<json_sequence_push, T>::value && !is_json_string_like<T>::value
+>;
+
+template<class T> using json_is_null = mp11::mp_bool<
+    std::is_same<T, monostate>::value || std::is_same<T, std::nullptr_t>::value
+>;
+
+template<class T> using json_is_number = mp11::mp_bool<
+    std::is_arithmetic<T>::value && !std::is_same<T, bool>::value
+>;
+
+template<class T> bool json_number_fits( json_read_number const& n, T& t, mp11::mp_true /*integral*/ ) noexcept
+{
+    switch( n.kind )
+    {
+    case json_read_number::int64:
+
+        if( n.i < static_cast<std::int64_t>( ( std::numeric_limits<T>::min )() ) ) return false;
+        if( n.i >= 0 && static_cast<std::uint64_t>( n.i ) > static_cast<std::uint64_t>( ( std::numeric_limits<T>::max )() ) ) return false;
+
+        t = static_cast<T>( n.i );
+        return true;
+
+    case json_read_number::uint64:
+
+        if( n.u > static_cast<std::uint64_t>( ( std::numeric_limits<T>::max )() ) ) return false;
+
+        t = static_cast<T>( n.u );
+        return true;
+
+    default:
+
+        // a double is accepted when it has an exact integer value
+        if( !( n.d >= static_cast<double>( ( std::numeric_limits<T>::min )() ) && n.d < std::ldexp( 1.0, std::numeric_limits<T>::digits ) ) ) return false;
+        if( static_cast<double>( static_cast<T>( n.d ) ) != n.d ) return false;
+
+        t = static_cast<T>( n.d );
+        return true;
+    }
+}
+
+template<class T> bool json_number_fits( json_read_number const& n, T& t, mp11::mp_false /*floating*/ ) noexcept
+{
+    switch( n.kind )
+    {
+    case json_read_number::int64: t = static_cast<T>( n.i ); break;
+    case json_read_number::uint64: t = static_cast<T>( n.u ); break;
+    default: t = static_cast<T>( n.d ); break;
+    }
+
+    return true;
+}
+
+template<class T> bool json_number_fits( json_read_number const& n, T& t ) noexcept
+{
+    return json_number_fits( n, t, mp11::mp_bool<std::is_integral<T>::value>() );
+}
+
+// the kinds from which a T can be read
+
+template<class T> struct json_read_kinds: mp11::mp_if<json_is_readable_sequence<T>, mp11::mp_size_t<json_array>, json_kinds<T>>
+{
+};
+
+template<class K1, class K2> using json_kinds_or = mp11::mp_size_t<K1::value | K2::value>;
+
+template<class... T> struct json_read_kinds<variant<T...>>: mp11::mp_fold<mp11::mp_list<json_read_kinds<T>...>, mp11::mp_size_t<0>, json_kinds_or>
+{
+};
+
+template<class V, unsigned K> struct json_read_candidates_impl
+{
+    template<class I> using fn = mp11::mp_bool< ( json_read_kinds<mp11::mp_at<V, I>>::value & K ) != 0 >;
+
+    using type = mp11::mp_copy_if_q<mp11::mp_iota<mp11::mp_size<V>>, json_read_candidates_impl>;
+};
+
+// the indices of the alternatives that can be read from kind K
+template<class V, unsigned K> using json_read_candidates = typename json_read_candidates_impl<V, K>::type;
+
+// a sink for T has the static member functions
+//
+//   bool null( T& t );
+//   bool bool_( T& t, bool b );
+//   bool number( T& t, json_read_number const& n );
+//   bool string( T& t, boost::json::string_view s );
+//   bool array( T& t, json_read_context& cx );
+//   bool object( T& t, json_read_context& cx );
+//
+// which are called with the first token of the value, and return false
+// when the value can't be stored in t. By default, the value is converted
+// with boost::json::try_value_to, so that the conversions of a user type
+// apply; its arrays and objects are collected into a json::value first
+
+template<class T, class E> struct json_read_sink
+{
+    static bool null( T& t )
+    {
+        return json_read_assign<T>( &t, boost::json::value() );
+    }
+
+    static bool bool_( T& t, bool b )
+    {
+        return json_read_assign<T>( &t, boost::json::value( b ) );
+    }
+
+    static bool number( T& t, json_read_number const& n )
+    {
+        return json_read_assign<T>( &t, n.to_value() );
+    }
+
+    static bool string( T& t, boost::json::string_view s )
+    {
+        return json_read_assign<T>( &t, boost::json::value( s ) );
+    }
+
+    static bool array( T& t, json_read_context& cx )
+    {
+        cx.collect( &t, &json_read_assign<T> );
+        return true;
+    }
+
+    static bool object( T& t, json_read_context& cx )
+    {
+        cx.collect( &t, &json_read_assign<T> );
+        return true;
+    }
+};
+
+// the scalar types and the sequences reject the other kinds
+
+struct json_read_sink_base
+{
+    template<class T> static bool null( T& ) noexcept { return false; }
+    template<class T> static bool bool_( T&, bool ) noexcept { return false; }
+    template<class T> static bool number( T&, json_read_number const& ) noexcept { return false; }
+    template<class T> static bool string( T&, boost::json::string_view ) noexcept { return false; }
+    template<class T> static bool array( T&, json_read_context& ) noexcept { return false; }
+    template<class T> static bool object( T&, json_read_context& ) noexcept { return false; }
+};
+
+// null
+
+template<class T> struct json_read_sink<T, typename std::enable_if< json_is_null<T>::value >::type>: json_read_sink_base
+{
+    using json_read_sink_base::null;
+
+    static bool null( T& ) noexcept
+    {
+        return true;
+    }
+};
+
+// bool
+
+template<> struct json_read_sink<bool>: json_read_sink_base
+{
+    using json_read_sink_base::bool_;
+
+    static bool bool_( bool& t, bool b ) noexcept
+    {
+        t = b;
+        return true;
+    }
+};
+
+// numbers
+
+template<class T> struct json_read_sink<T, typename std::enable_if< json_is_number<T>::value >::type>: json_read_sink_base
+{
+    using json_read_sink_base::number;
+
+    static bool number( T& t, json_read_number const& n ) noexcept
+    {
+        return json_number_fits( n, t );
+    }
+};
+
+// strings
+
+template<class Tr, class A> struct json_read_sink<std::basic_string<char, Tr, A>>: json_read_sink_base
+{
+    using json_read_sink_base::string;
+
+    static bool string( std::basic_string<char, Tr, A>& t, boost::json::string_view s )
+    {
+        t.assign( s.data(), s.size() );
+        return true;
+    }
+};
+
+// sequences, from arrays; the elements are read as they arrive
+
+template<class T> struct json_read_sink<T, typename std::enable_if< json_is_readable_sequence<T>::value >::type>: json_read_sink_base
+{
+    using json_read_sink_base::array;
+
+    static bool array( T& t, json_read_context& cx )
+    {
+        t.clear();
+        cx.push( &t, &json_element_fns<T>::ops );
+
+        return true;
+    }
+};
+
+// variants, by the first token of the value
+
+template<class V, class F> struct json_read_scalar_L
+{
+    V& v;
+    F const& f;
+
+    bool& done;
+
+    template<class I> void operator()( I ) const
+    {
+        if( done ) return;
+
+        using U = mp11::mp_at<V, I>;
+        done = f( v.template emplace<I::value>(), static_cast<json_read_sink<U>*>( 0 ) );
+    }
+};
+
+// a scalar is given to each candidate in turn, until one accepts it
+template<class V, unsigned K, class F> bool json_read_scalar( V& v, F const& f )
+{
+    bool done = false;
+    mp11::mp_for_each< json_read_candidates<V, K> >( json_read_scalar_L<V, F>{ v, f, done } );
+
+    return done;
+}
+
+struct json_read_null_F
+{
+    template<class U, class Tr> bool operator()( U& u, Tr* ) const
+    {
+        return Tr::null( u );
+    }
+};
+
+struct json_read_bool_F
+{
+    bool b;
+
+    template<class U, class Tr> bool operator()( U& u, Tr* ) const
+    {
+        return Tr::bool_( u, b );
+    }
+};
+
+struct json_read_number_F
+{
+    json_read_number const& n;
+
+    template<class U, class Tr> bool operator()( U& u, Tr* ) const
+    {
+        return Tr::number( u, n );
+    }
+};
+
+struct json_read_string_F
+{
+    boost::json::string_view s;
+
+    template<class U, class Tr> bool operator()( U& u, Tr* ) const
+    {
+        return Tr::string( u, s );
+    }
+};
+
+template<class T> struct json_is_variant: std::false_type
+{
+};
+
+template<class... T> struct json_is_variant<variant<T...>>: std::true_type
+{
+};
+
+template<class T> using json_streams_array = mp11::mp_bool<
+    json_is_readable_sequence<T>::value || json_is_variant<T>::value
+>;
+
+// an array that only one alternative can be read from, a sequence or a
+// variant, is read into it as it arrives; otherwise, it's collected and
+// converted with try_value_to<V>, which tries the alternatives in order
+
+template<class V, class L> bool json_read_array( V& v, json_read_context& cx, L, mp11::mp_true /*stream*/ )
+{
+    using I = mp11::mp_front<L>;
+    using U = mp11::mp_at<V, I>;
+
+    return json_read_sink<U>::array( v.template emplace<I::value>(), cx );
+}
+
+template<class V, class L> bool json_read_array( V& v, json_read_context& cx, L, mp11::mp_false /*stream*/ )
+{
+    cx.collect( &v, &json_read_assign<V> );
+    return true;
+}
+
+template<class V, class L> struct json_read_array_streams: mp11::mp_false
+{
+};
+
+template<class V, class I> struct json_read_array_streams<V, mp11::mp_list<I>>: json_streams_array<mp11::mp_at<V, I>>
+{
+};
+
+template<class... T> struct json_read_sink<variant<T...>, void>
+{
+    using V = variant<T...>;
+
+    static bool null( V& v )
+    {
+        return json_read_scalar<V, json_null>( v, json_read_null_F() );
+    }
+
+    static bool bool_( V& v, bool b )
+    {
+        return json_read_scalar<V, json_bool>( v, json_read_bool_F{ b } );
+    }
+
+    static bool number( V& v, json_read_number const& n )
+    {
+        return json_read_scalar<V, json_number>( v, json_read_number_F{ n } );
+    }
+
+    static bool string( V& v, boost::json::string_view s )
+    {
+        return json_read_scalar<V, json_string>( v, json_read_string_F{ s } );
+    }
+
+    static bool array( V& v, json_read_context& cx )
+    {
+        using L = json_read_candidates<V, json_array>;
+        return json_read_array( v, cx, L(), json_read_array_streams<V, L>() );
+    }
+
+    // objects are collected, so that variant_json_discriminator applies
+    static bool object( V& v, json_read_context& cx )
+    {
+        cx.collect( &v, &json_read_assign<V> );
+        return true;
+    }
+};
+
+} // namespace detail
+
+// variant_json_handler
+
+template<class V> class variant_json_handler: private detail::json_read_context
+{
+private:
+
+    std::string str_;
+
+    static bool check( bool r, boost::json::error_code& ec )
+    {
+        if( !r )
+        {
+            ec = boost::system::errc::make_error_code( boost::system::errc::invalid_argument );
+        }
+
+        return r;
+    }
+
+    bool number( detail::json_read_number const& n, boost::json::error_code& ec )
+    {
+        return check( ops().number( top(), n ), ec );
+    }
+
+public:
+
+    static constexpr std::size_t max_object_size = static_cast<std::size_t>( -1 );
+    static constexpr std::size_t max_array_size = static_cast<std::size_t>( -1 );
+    static constexpr std::size_t max_key_size = static_cast<std::size_t>( -1 );
+    static constexpr std::size_t max_string_size = static_cast<std::size_t>( -1 );
+
+    explicit variant_json_handler( V& v ): detail::json_read_context( &v, &detail::json_value_fns<V>::ops )
+    {
+    }
+
+    bool on_document_begin( boost::json::error_code& )
+    {
+        return true;
+    }
+
+    bool on_document_end( boost::json::error_code& )
+    {
+        return true;
+    }
+
+    bool on_array_begin( boost::json::error_code& ec )
+    {
+        if( collecting() )
+        {
+            enter();
+            return true;
+        }
+
+        return check( ops().array( top(), *this ), ec );
+    }
+
+    bool on_array_end( std::size_t n, boost::json::error_code& ec )
+    {
+        if( collecting() )
+        {
+            stack().push_array( n );
+            return check( leave(), ec );
+        }
+
+        pop();
+        return true;
+    }
+
+    bool on_object_begin( boost::json::error_code& ec )
+    {
+        if( collecting() )
+        {
+            enter();
+            return true;
+        }
+
+        return check( ops().object( top(), *this ), ec );
+    }
+
+    bool on_object_end( std::size_t n, boost::json::error_code& ec )
+    {
+        // objects are always collected
+        stack().push_object( n );
+        return check( leave(), ec );
+    }
+
+    bool on_string_part( boost::json::string_view s, std::size_t, boost::json::error_code& )
+    {
+        if( collecting() )
+        {
+            stack().push_chars( s );
+        }
+        else
+        {
+            str_.append( s.data(), s.size() );
+        }
+
+        return true;
+    }
+
+    bool on_string( boost::json::string_view s, std::size_t, boost::json::error_code& ec )
+    {
+        if( collecting() )
+        {
+            stack().push_string( s );
+            return true;
+        }
+
+        if( str_.empty() )
+        {
+            return check( ops().string( top(), s ), ec );
+        }
+
+        str_.append( s.data(), s.size() );
+
+        bool r = ops().string( top(), boost::json::string_view( str_.data(), str_.size() ) );
+        str_.clear();
+
+        return check( r, ec );
+    }
+
+    bool on_key_part( boost::json::string_view s, std::size_t, boost::json::error_code& )
+    {
+        stack().push_chars( s );
+        return true;
+    }
+
+    bool on_key( boost::json::string_view s, std::size_t, boost::json::error_code& )
+    {
+        stack().push_key( s );
+        return true;
+    }
+
+    bool on_number_part( boost::json::string_view, boost::json::error_code& )
+    {
+        return true;
+    }
+
+    bool on_int64( std::int64_t i, boost::json::string_view, boost::json::error_code& ec )
+    {
+        if( collecting() )
+        {
+            stack().push_int64( i );
+            return true;
+        }
+
+        return number( detail::json_read_number{ detail::json_read_number::int64, i, 0, static_cast<double>( i ) }, ec );
+    }
+
+    bool on_uint64( std::uint64_t u, boost::json::string_view, boost::json::error_code& ec )
+    {
+        if( collecting() )
+        {
+            stack().push_uint64( u );
+            return true;
+        }
+
+        return number( detail::json_read_number{ detail::json_read_number::uint64, 0, u, static_cast<double>( u ) }, ec );
+    }
+
+    bool on_double( double d, boost::json::string_view, boost::json::error_code& ec )
+    {
+        if( collecting() )
+        {
+            stack().push_double( d );
+            return true;
+        }
+
+        return number( detail::json_read_number{ detail::json_read_number::double_, 0, 0, d }, ec );
+    }
+
+    bool on_bool( bool b, boost::json::error_code& ec )
+    {
+        if( collecting() )
+        {
+            stack().push_bool( b );
+            return true;
+        }
+
+        return check( ops().bool_( top(), b ), ec );
+    }
+
+    bool on_null( boost::json::error_code& ec )
+    {
+        if( collecting() )
+        {
+            stack().push_null();
+            return true;
+        }
+
+        return check( ops().null( top() ), ec );
+    }
+
+    bool on_comment_part( boost::json::string_view, boost::json::error_code& )
+    {
+        return true;
+    }
+
+    bool on_comment( boost::json::string_view, boost::json::error_code& )
+    {
+        return true;
+    }
+};
+
+// read_json
+
+template<class... T> char const* read_json( char const* first, char const* last, variant<T...>& v )
+{
+    boost::json::basic_parser< variant_json_handler<variant<T...>> > p( boost::json::parse_options(), v );
+
+    boost::json::error_code ec;
+    std::size_t n = p.write_some( false, first, static_cast<std::size_t>( last - first ), ec );
+
+    if( ec ) return 0;
+
+    first += n;
+
+    while( first != last && ( *first == ' ' || *first == '\t' || *first == '\n' || *first == '\r' ) ) ++first;
+
+    return first;
+}
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_JSON_READER_HPP_INCLUDED
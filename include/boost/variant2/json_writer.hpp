@@ -0,0 +1,354 @@
+#ifndef BOOST_VARIANT2_JSON_WRITER_HPP_INCLUDED
+#define BOOST_VARIANT2_JSON_WRITER_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/mp11.hpp>
+#include <boost/config.hpp>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstddef>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#if defined(__has_include)
+# if __has_include(<charconv>) && ( __cplusplus >= 201703L || ( defined(_MSVC_LANG) && _MSVC_LANG >= 201703L ) )
+#  include <charconv>
+# endif
+#endif
+
+namespace boost
+{
+namespace variant2
+{
+
+namespace detail
+{
+
+template<class T, class E = void> struct json_write_impl;
+
+// an output that writes to a fixed buffer and counts what doesn't fit
+
+class json_buffer_sink
+{
+private:
+
+    char* p_;
+    std::size_t n_;
+    std::size_t size_;
+
+public:
+
+    json_buffer_sink( char* p, std::size_t n ) noexcept: p_( p ), n_( n ), size_( 0 )
+    {
+    }
+
+    void append( char const* p, std::size_t n ) noexcept
+    {
+        if( size_ < n_ )
+        {
+            std::size_t k = n_ - size_ < n? n_ - size_: n;
+            std::memcpy( p_ + size_, p, k );
+        }
+
+        size_ += n;
+    }
+
+    void push_back( char c ) noexcept
+    {
+        if( size_ < n_ )
+        {
+            p_[ size_ ] = c;
+        }
+
+        ++size_;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+};
+
+template<class Out> void json_write_literal( Out& out, char const* s )
+{
+    out.append( s, std::strlen( s ) );
+}
+
+template<class Out> void json_write_unsigned( Out& out, unsigned long long v )
+{
+    char buffer[ 24 ];
+    char* p = buffer + sizeof( buffer );
+
+    do
+    {
+        *--p = static_cast<char>( '0' + v % 10 );
+        v /= 10;
+    }
+    while( v != 0 );
+
+    out.append( p, static_cast<std::size_t>( buffer + sizeof( buffer ) - p ) );
+}
+
+template<class Out> void json_write_signed( Out& out, long long v )
+{
+    if( v < 0 )
+    {
+        out.push_back( '-' );
+        json_write_unsigned( out, 0ull - static_cast<unsigned long long>( v ) );
+    }
+    else
+    {
+        json_write_unsigned( out, static_cast<unsigned long long>( v ) );
+    }
+}
+
+template<class Out> void json_write_double( Out& out, double v )
+{
+    if( std::isnan( v ) )
+    {
+        json_write_literal( out, "null" );
+        return;
+    }
+
+    if( std::isinf( v ) )
+    {
+        json_write_literal( out, v < 0? "-1e99999": "1e99999" );
+        return;
+    }
+
+    char buffer[ 32 ];
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+
+    // the shortest representation that round-trips
+    char* p = std::to_chars( buffer, buffer + sizeof( buffer ), v ).ptr;
+    out.append( buffer, static_cast<std::size_t>( p - buffer ) );
+
+#else
+
+    // the shorter of the two precisions that round-trips
+    int n = std::snprintf( buffer, sizeof( buffer ), "%.15g", v );
+
+    if( std::strtod( buffer, 0 ) != v )
+    {
+        n = std::snprintf( buffer, sizeof( buffer ), "%.17g", v );
+    }
+
+    out.append( buffer, static_cast<std::size_t>( n ) );
+
+#endif
+}
+
+template<class Out> void json_write_string( Out& out, char const* p, std::size_t n )
+{
+    static char const hex[] = "0123456789abcdef";
+
+    out.push_back( '"' );
+
+    char const* last = p + n;
+    char const* first = p;
+
+    for( ; p != last; ++p )
+    {
+        unsigned char c = static_cast<unsigned char>( *p );
+
+        if( c >= 0x20 && c != '"' && c != '\\' ) continue;
+
+        out.append( first, static_cast<std::size_t>( p - first ) );
+        first = p + 1;
+
+        switch( c )
+        {
+        case '"': json_write_literal( out, "\\\"" ); break;
+        case '\\': json_write_literal( out, "\\\\" ); break;
+        case '\b': json_write_literal( out, "\\b" ); break;
+        case '\f': json_write_literal( out, "\\f" ); break;
+        case '\n': json_write_literal( out, "\\n" ); break;
+        case '\r': json_write_literal( out, "\\r" ); break;
+        case '\t': json_write_literal( out, "\\t" ); break;
+
+        default:
+            {
+                char e[] = { '\\', 'u', '0', '0', hex[ c >> 4 ], hex[ c & 15 ] };
+                out.append( e, sizeof( e ) );
+            }
+        }
+    }
+
+    out.append( first, static_cast<std::size_t>( p - first ) );
+    out.push_back( '"' );
+}
+
+template<class T> using json_is_null = mp11::mp_bool<
+    std::is_same<T, monostate>::value || std::is_same<T, std::nullptr_t>::value
+>;
+
+template<class T> using json_is_signed = mp11::mp_bool<
+    std::is_integral<T>::value && std::is_signed<T>::value && !std::is_same<T, bool>::value
+>;
+
+template<class T> using json_is_unsigned = mp11::mp_bool<
+    std::is_integral<T>::value && !std::is_signed<T>::value && !std::is_same<T, bool>::value
+>;
+
+template<class T> using json_sequence_test = decltype( std::declval<T const&>().begin() != std::declval<T const&>().end() );
+
+// a sequence of pairs with string-like keys, which Boost.JSON converts to an object
+
+template<class T> using json_map_key = typename std::remove_const<typename T::value_type::first_type>::type;
+
+template<class T> using json_is_map_like_impl = is_json_string_like< json_map_key<T> >;
+
+template<class T> using json_is_map_like = mp11::mp_eval_if_not<mp11::mp_valid<json_map_key, T>, mp11::mp_false, json_is_map_like_impl, T>;
+
+template<class T> using json_is_sequence = mp11::mp_bool<
+    mp11::mp_valid<json_sequence_test, T>::value && !is_json_string_like<T>::value && !json_is_map_like<T>::value
+>;
+
+template<class Out> struct json_write_L
+{
+    Out& out;
+
+    template<class T> void operator()( T const& t ) const
+    {
+        json_write_impl<T>::write( out, t );
+    }
+};
+
+// the other types, such as maps, pairs, tuples and user-defined types, are
+// converted with boost::json::value_from, so that their tag_invoke overloads
+// apply, and serialized; JV is boost::json::value, deferred so that Boost.JSON
+// is only needed when such a type is written
+
+template<class Out, class T, class JV> void json_write_value_from( Out& out, T const& t, JV* )
+{
+    JV jv;
+    boost::json::value_from( t, jv );
+
+    auto s = serialize( jv );
+    out.append( s.data(), s.size() );
+}
+
+template<class T, class E> struct json_write_impl
+{
+    template<class Out> static void write( Out& out, T const& t )
+    {
+        detail::json_write_value_from( out, t, static_cast<boost::json::value*>( 0 ) );
+    }
+};
+
+// null
+
+template<class T> struct json_write_impl<T, typename std::enable_if< json_is_null<T>::value >::type>
+{
+    template<class Out> static void write( Out& out, T const& )
+    {
+        json_write_literal( out, "null" );
+    }
+};
+
+// bool
+
+template<> struct json_write_impl<bool>
+{
+    template<class Out> static void write( Out& out, bool v )
+    {
+        json_write_literal( out, v? "true": "false" );
+    }
+};
+
+// numbers
+
+template<class T> struct json_write_impl<T, typename std::enable_if< json_is_signed<T>::value >::type>
+{
+    template<class Out> static void write( Out& out, T v )
+    {
+        json_write_signed( out, v );
+    }
+};
+
+template<class T> struct json_write_impl<T, typename std::enable_if< json_is_unsigned<T>::value >::type>
+{
+    template<class Out> static void write( Out& out, T v )
+    {
+        json_write_unsigned( out, v );
+    }
+};
+
+template<class T> struct json_write_impl<T, typename std::enable_if< std::is_floating_point<T>::value >::type>
+{
+    template<class Out> static void write( Out& out, T v )
+    {
+        json_write_double( out, static_cast<double>( v ) );
+    }
+};
+
+// strings
+
+template<class T> struct json_write_impl<T, typename std::enable_if< is_json_string_like<T>::value >::type>
+{
+    template<class Out> static void write( Out& out, T const& s )
+    {
+        json_write_string( out, s.data(), s.size() );
+    }
+};
+
+// sequences, as arrays
+
+template<class T> struct json_write_impl<T, typename std::enable_if< json_is_sequence<T>::value >::type>
+{
+    template<class Out> static void write( Out& out, T const& s )
+    {
+        out.push_back( '[' );
+
+        bool first = true;
+
+        for( auto const& x: s )
+        {
+            if( !first ) out.push_back( ',' );
+            first = false;
+
+            json_write_L<Out>{ out }( x );
+        }
+
+        out.push_back( ']' );
+    }
+};
+
+// variants, as the contained value
+
+template<class... T> struct json_write_impl<variant<T...>, void>
+{
+    template<class Out> static void write( Out& out, variant<T...> const& v )
+    {
+        visit( json_write_L<Out>{ out }, v );
+    }
+};
+
+} // namespace detail
+
+// write_json
+
+template<class... T> void write_json( std::string& out, variant<T...> const& v )
+{
+    detail::json_write_impl<variant<T...>>::write( out, v );
+}
+
+template<class... T> std::size_t write_json( char* p, std::size_t n, variant<T...> const& v )
+{
+    detail::json_buffer_sink out( p, n );
+    detail::json_write_impl<variant<T...>>::write( out, v );
+    return out.size();
+}
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_JSON_WRITER_HPP_INCLUDED
@@ -0,0 +1,278 @@
+#ifndef BOOST_VARIANT2_MAILBOX_HPP_INCLUDED
+#define BOOST_VARIANT2_MAILBOX_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/mp11.hpp>
+#include <boost/config.hpp>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace boost
+{
+namespace variant2
+{
+
+// mailbox
+
+template<class... T> class mailbox;
+
+namespace detail
+{
+
+// a slot of the ring buffer; seq tells whether it's free for the
+// producer at position seq, or holds the message at position seq - 1
+
+template<class V> struct mailbox_slot
+{
+    std::atomic<std::size_t> seq;
+
+    // false when the construction of the message has thrown
+    bool full;
+
+    alignas(V) unsigned char storage[ sizeof(V) ];
+
+    V& value() noexcept
+    {
+        return *static_cast<V*>( static_cast<void*>( storage ) );
+    }
+};
+
+// publishes the slot even when the construction of the message throws
+
+template<class S> struct mailbox_publish_guard
+{
+    S* s_;
+    std::size_t seq_;
+
+    ~mailbox_publish_guard()
+    {
+        s_->seq.store( seq_, std::memory_order_release );
+    }
+};
+
+// frees the front slot even when the handler throws
+
+template<class M> struct mailbox_pop_guard
+{
+    M* this_;
+
+    ~mailbox_pop_guard()
+    {
+        this_->pop_front();
+    }
+};
+
+template<class M, class F> struct mailbox_drain_L
+{
+    M* this_;
+    F& f;
+    std::size_t max;
+
+    template<class I> std::size_t operator()( I ) const
+    {
+        return this_->template drain_run<I::value>( f, max );
+    }
+};
+
+} // namespace detail
+
+template<class... T> class mailbox
+{
+public:
+
+    using value_type = variant<T...>;
+
+private:
+
+    template<class M> friend struct detail::mailbox_pop_guard;
+    template<class M, class F> friend struct detail::mailbox_drain_L;
+
+    using slot_type = detail::mailbox_slot<value_type>;
+
+    std::unique_ptr<slot_type[]> slots_;
+    std::size_t mask_;
+
+    // producers and the consumer work on separate cache lines
+
+    alignas(64) std::atomic<std::size_t> tail_;
+    alignas(64) std::size_t head_;
+
+private:
+
+    static std::size_t round_capacity( std::size_t n ) noexcept
+    {
+        std::size_t r = 2;
+        while( r < n ) r *= 2;
+        return r;
+    }
+
+    // producers
+
+    template<class... A> bool try_construct( A&&... a )
+    {
+        std::size_t pos = tail_.load( std::memory_order_relaxed );
+
+        for( ;; )
+        {
+            slot_type& s = slots_[ pos & mask_ ];
+
+            std::size_t seq = s.seq.load( std::memory_order_acquire );
+            std::ptrdiff_t d = static_cast<std::ptrdiff_t>( seq - pos );
+
+            if( d == 0 )
+            {
+                if( tail_.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                {
+                    detail::mailbox_publish_guard<slot_type> guard{ &s, pos + 1 };
+
+                    s.full = false;
+                    ::new( static_cast<void*>( s.storage ) ) value_type( std::forward<A>(a)... );
+                    s.full = true;
+
+                    return true;
+                }
+            }
+            else if( d < 0 )
+            {
+                // the consumer hasn't freed the slot yet
+                return false;
+            }
+            else
+            {
+                // another producer has taken the slot
+                pos = tail_.load( std::memory_order_relaxed );
+            }
+        }
+    }
+
+    // consumer
+
+    slot_type* front() const noexcept
+    {
+        slot_type& s = slots_[ head_ & mask_ ];
+        return s.seq.load( std::memory_order_acquire ) == head_ + 1? &s: nullptr;
+    }
+
+    void pop_front() noexcept
+    {
+        slot_type& s = slots_[ head_ & mask_ ];
+
+        if( s.full )
+        {
+            s.value().~value_type();
+            s.full = false;
+        }
+
+        s.seq.store( head_ + mask_ + 1, std::memory_order_release );
+        ++head_;
+    }
+
+    // handles consecutive messages holding the alternative I
+    template<std::size_t I, class F> std::size_t drain_run( F& f, std::size_t max )
+    {
+        std::size_t n = 0;
+
+        for( ;; )
+        {
+            {
+                detail::mailbox_pop_guard<mailbox> guard{ this };
+                f( std::move( unsafe_get<I>( slots_[ head_ & mask_ ].value() ) ) );
+            }
+
+            if( ++n == max ) break;
+
+            slot_type* s = front();
+            if( s == nullptr || !s->full || s->value().index() != I ) break;
+        }
+
+        return n;
+    }
+
+public:
+
+    // the capacity is rounded up to a power of two
+    explicit mailbox( std::size_t capacity ): slots_( new slot_type[ round_capacity( capacity ) ] ), mask_( round_capacity( capacity ) - 1 ), tail_( 0 ), head_( 0 )
+    {
+        for( std::size_t i = 0; i <= mask_; ++i )
+        {
+            slots_[ i ].seq.store( i, std::memory_order_relaxed );
+            slots_[ i ].full = false;
+        }
+    }
+
+    mailbox( mailbox const& ) = delete;
+    mailbox& operator=( mailbox const& ) = delete;
+
+    ~mailbox()
+    {
+        while( front() ) pop_front();
+    }
+
+    std::size_t capacity() const noexcept
+    {
+        return mask_ + 1;
+    }
+
+    // producers; lock-free, and never wait for the consumer
+
+    template<class U> bool try_push( U&& u )
+    {
+        return try_construct( std::forward<U>(u) );
+    }
+
+    template<std::size_t I, class... A> bool try_emplace( A&&... a )
+    {
+        return try_construct( in_place_index_t<I>(), std::forward<A>(a)... );
+    }
+
+    template<class U, class... A> bool try_emplace( A&&... a )
+    {
+        return try_construct( in_place_type_t<U>(), std::forward<A>(a)... );
+    }
+
+    // consumer
+
+    bool empty() const noexcept
+    {
+        return front() == nullptr;
+    }
+
+    // calls f( std::move(x) ) for each of up to max messages, in order,
+    // switching on the alternative once per run of messages that hold the
+    // same one; returns the number of messages handled
+    template<class F> std::size_t drain( F&& f, std::size_t max = static_cast<std::size_t>( -1 ) )
+    {
+        std::size_t n = 0;
+
+        while( n < max )
+        {
+            slot_type* s = front();
+
+            if( s == nullptr ) break;
+
+            if( !s->full )
+            {
+                // the construction of the message has thrown
+                pop_front();
+                continue;
+            }
+
+            n += detail::with_index<value_type, sizeof...(T)>( s->value().index(), detail::mailbox_drain_L<mailbox, F>{ this, f, max - n } );
+        }
+
+        return n;
+    }
+};
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_MAILBOX_HPP_INCLUDED
@@ -0,0 +1,332 @@
+#ifndef BOOST_VARIANT2_PARALLEL_HPP_INCLUDED
+#define BOOST_VARIANT2_PARALLEL_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/algorithm.hpp>
+#include <boost/mp11.hpp>
+#include <boost/config.hpp>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// the overloads taking a standard execution policy are opt-in, because
+// with some standard libraries <execution> requires linking to TBB
+
+#if defined(BOOST_VARIANT2_USE_STD_EXECUTION)
+# include <execution>
+# include <numeric>
+# include <algorithm>
+#endif
+
+namespace boost
+{
+namespace variant2
+{
+namespace detail
+{
+
+// the range is processed in tiles; the elements of a tile are bucketed by
+// alternative, then each bucket is processed by a loop over a single type
+
+BOOST_INLINE_CONSTEXPR std::size_t pv_tile_size = 4096;
+
+template<class V> struct pv_tile
+{
+    V* first;
+    std::size_t n;
+
+    std::uint16_t off[ pv_tile_size ];
+    std::size_t start[ variant_size<typename std::remove_const<V>::type>::value + 1 ];
+
+    pv_tile( V* p, std::size_t size, std::size_t t ) noexcept
+    {
+        std::size_t const N = variant_size<typename std::remove_const<V>::type>::value;
+
+        first = p + t * pv_tile_size;
+        n = size - t * pv_tile_size < pv_tile_size? size - t * pv_tile_size: pv_tile_size;
+
+        auto const c = variant2::count_by_index( static_cast<V const*>( first ), n );
+
+        std::size_t next[ N ];
+
+        start[ 0 ] = 0;
+
+        for( std::size_t i = 0; i < N; ++i )
+        {
+            next[ i ] = start[ i ];
+            start[ i + 1 ] = start[ i ] + c[ i ];
+        }
+
+        for( std::size_t k = 0; k < n; ++k )
+        {
+            off[ next[ first[ k ].index() ]++ ] = static_cast<std::uint16_t>( k );
+        }
+    }
+};
+
+template<class V, class F> struct pv_for_each_L
+{
+    pv_tile<V> const& tile;
+    F const& f;
+
+    template<class I> void operator()( I ) const
+    {
+        for( std::size_t k = tile.start[ I::value ], m = tile.start[ I::value + 1 ]; k < m; ++k )
+        {
+            f( unsafe_get<I::value>( tile.first[ tile.off[ k ] ] ) );
+        }
+    }
+};
+
+template<class V, class F> void pv_for_each_tile( V* first, std::size_t n, std::size_t t, F const& f )
+{
+    pv_tile<V> tile( first, n, t );
+    mp11::mp_for_each< mp11::mp_iota< variant_size<typename std::remove_const<V>::type> > >( pv_for_each_L<V, F>{ tile, f } );
+}
+
+template<class V, class R, class Op, class F> struct pv_reduce_L
+{
+    pv_tile<V> const& tile;
+    R& r;
+    Op const& op;
+    F const& f;
+
+    template<class I> void operator()( I ) const
+    {
+        for( std::size_t k = tile.start[ I::value ], m = tile.start[ I::value + 1 ]; k < m; ++k )
+        {
+            r = op( std::move( r ), f( unsafe_get<I::value>( tile.first[ tile.off[ k ] ] ) ) );
+        }
+    }
+};
+
+// the result of a tile is accumulated in a local, so that the workers don't
+// write to the partial results, which share a cache line, per element
+
+template<class V, class R, class Op, class F> R pv_reduce_tile( V* first, std::size_t n, std::size_t t, R const& identity, Op const& op, F const& f )
+{
+    pv_tile<V> tile( first, n, t );
+
+    R r( identity );
+    mp11::mp_for_each< mp11::mp_iota< variant_size<typename std::remove_const<V>::type> > >( pv_reduce_L<V, R, Op, F>{ tile, r, op, f } );
+
+    return r;
+}
+
+inline std::size_t pv_tile_count( std::size_t n ) noexcept
+{
+    return ( n + pv_tile_size - 1 ) / pv_tile_size;
+}
+
+// a minimal pool; the calling thread works as well
+
+class pv_pool
+{
+private:
+
+    std::atomic<std::size_t> next_;
+    std::size_t tiles_;
+
+    std::atomic<bool> failed_;
+    std::exception_ptr ex_;
+
+    std::vector<std::thread> threads_;
+
+    // joins the workers even when starting one of them throws
+    struct join_guard
+    {
+        pv_pool* this_;
+
+        ~join_guard()
+        {
+            for( auto& th: this_->threads_ ) th.join();
+        }
+    };
+
+    template<class W> void work( W const& w, std::size_t k ) noexcept
+    {
+#if !defined(BOOST_NO_EXCEPTIONS)
+        try
+#endif
+        {
+            for( ;; )
+            {
+                std::size_t t = next_.fetch_add( 1, std::memory_order_relaxed );
+                if( t >= tiles_ ) break;
+
+                w( k, t );
+            }
+        }
+#if !defined(BOOST_NO_EXCEPTIONS)
+        catch( ... )
+        {
+            // stop the other workers
+            next_.store( tiles_, std::memory_order_relaxed );
+
+            if( !failed_.exchange( true ) )
+            {
+                ex_ = std::current_exception();
+            }
+        }
+#endif
+    }
+
+public:
+
+    pv_pool( std::size_t tiles ): next_( 0 ), tiles_( tiles ), failed_( false )
+    {
+    }
+
+    static std::size_t thread_count( std::size_t threads, std::size_t tiles ) noexcept
+    {
+        if( threads == 0 ) threads = std::thread::hardware_concurrency();
+        if( threads == 0 ) threads = 1;
+
+        return threads < tiles? threads: ( tiles == 0? 1: tiles );
+    }
+
+    // calls w( k, t ) for each tile t, where k < threads is the worker
+    template<class W> void run( std::size_t threads, W const& w )
+    {
+        {
+            join_guard guard{ this };
+
+            for( std::size_t k = 1; k < threads; ++k )
+            {
+                threads_.emplace_back( [this, &w, k]{ this->work( w, k ); } );
+            }
+
+            work( w, 0 );
+        }
+
+        if( ex_ ) std::rethrow_exception( ex_ );
+    }
+};
+
+template<class V, class F> void pv_for_each_visit( V* first, std::size_t n, F const& f, std::size_t threads )
+{
+    std::size_t const tiles = pv_tile_count( n );
+
+    pv_pool pool( tiles );
+
+    pool.run( pv_pool::thread_count( threads, tiles ), [&]( std::size_t /*k*/, std::size_t t ){
+
+        pv_for_each_tile( first, n, t, f );
+    });
+}
+
+} // namespace detail
+
+// parallel_for_each_visit
+
+template<class F, class... T> void parallel_for_each_visit( variant<T...>* first, std::size_t n, F const& f, std::size_t threads = 0 )
+{
+    detail::pv_for_each_visit( first, n, f, threads );
+}
+
+template<class F, class... T> void parallel_for_each_visit( variant<T...> const* first, std::size_t n, F const& f, std::size_t threads = 0 )
+{
+    detail::pv_for_each_visit( first, n, f, threads );
+}
+
+// parallel_visit_reduce
+
+template<class R, class Op, class F, class... T> R parallel_visit_reduce( variant<T...> const* first, std::size_t n, R identity, Op op, F const& f, std::size_t threads = 0 )
+{
+    std::size_t const tiles = detail::pv_tile_count( n );
+
+    detail::pv_pool pool( tiles );
+
+    threads = detail::pv_pool::thread_count( threads, tiles );
+
+    // one partial result per worker
+    std::vector<R> partial( threads, identity );
+
+    pool.run( threads, [&]( std::size_t k, std::size_t t ){
+
+        partial[ k ] = op( std::move( partial[ k ] ), detail::pv_reduce_tile( first, n, t, identity, op, f ) );
+    });
+
+    for( auto& r: partial )
+    {
+        identity = op( std::move( identity ), std::move( r ) );
+    }
+
+    return identity;
+}
+
+#if defined(BOOST_VARIANT2_HAS_SPAN)
+
+template<class F, class... T, std::size_t E> void parallel_for_each_visit( std::span<variant<T...>, E> s, F const& f, std::size_t threads = 0 )
+{
+    detail::pv_for_each_visit( s.data(), s.size(), f, threads );
+}
+
+template<class F, class... T, std::size_t E> void parallel_for_each_visit( std::span<variant<T...> const, E> s, F const& f, std::size_t threads = 0 )
+{
+    detail::pv_for_each_visit( s.data(), s.size(), f, threads );
+}
+
+template<class R, class Op, class F, class... T, std::size_t E> R parallel_visit_reduce( std::span<variant<T...> const, E> s, R identity, Op op, F const& f, std::size_t threads = 0 )
+{
+    return variant2::parallel_visit_reduce( s.data(), s.size(), std::move( identity ), std::move( op ), f, threads );
+}
+
+#endif
+
+#if defined(BOOST_VARIANT2_USE_STD_EXECUTION)
+
+namespace detail
+{
+
+template<class P> using pv_enable_if_policy = typename std::enable_if< std::is_execution_policy<typename std::decay<P>::type>::value >::type;
+
+template<class P, class V, class F> void pv_for_each_visit_policy( P&& policy, V* first, std::size_t n, F const& f )
+{
+    std::vector<std::size_t> tiles( pv_tile_count( n ) );
+    std::iota( tiles.begin(), tiles.end(), std::size_t( 0 ) );
+
+    std::for_each( std::forward<P>(policy), tiles.begin(), tiles.end(), [&]( std::size_t t ){
+
+        pv_for_each_tile( first, n, t, f );
+    });
+}
+
+} // namespace detail
+
+template<class P, class F, class... T, class E = detail::pv_enable_if_policy<P>> void parallel_for_each_visit( P&& policy, variant<T...>* first, std::size_t n, F const& f )
+{
+    detail::pv_for_each_visit_policy( std::forward<P>(policy), first, n, f );
+}
+
+template<class P, class F, class... T, class E = detail::pv_enable_if_policy<P>> void parallel_for_each_visit( P&& policy, variant<T...> const* first, std::size_t n, F const& f )
+{
+    detail::pv_for_each_visit_policy( std::forward<P>(policy), first, n, f );
+}
+
+template<class P, class R, class Op, class F, class... T, class E = detail::pv_enable_if_policy<P>> R parallel_visit_reduce( P&& policy, variant<T...> const* first, std::size_t n, R identity, Op op, F const& f )
+{
+    std::vector<std::size_t> tiles( detail::pv_tile_count( n ) );
+    std::iota( tiles.begin(), tiles.end(), std::size_t( 0 ) );
+
+    return std::transform_reduce( std::forward<P>(policy), tiles.begin(), tiles.end(), identity, op, [&]( std::size_t t ){
+
+        return detail::pv_reduce_tile( first, n, t, identity, op, f );
+    });
+}
+
+#endif
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_PARALLEL_HPP_INCLUDED
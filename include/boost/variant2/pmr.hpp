@@ -0,0 +1,201 @@
+#ifndef BOOST_VARIANT2_PMR_HPP_INCLUDED
+#define BOOST_VARIANT2_PMR_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/mp11.hpp>
+#include <boost/config.hpp>
+#include <memory>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#if !defined(BOOST_NO_CXX17_HDR_MEMORY_RESOURCE)
+# include <memory_resource>
+#endif
+
+#if defined(__cpp_lib_memory_resource) && __cpp_lib_memory_resource >= 201603L
+# define BOOST_VARIANT2_HAS_MEMORY_RESOURCE
+#endif
+
+namespace boost
+{
+namespace variant2
+{
+
+// allocator_variant
+
+template<class A, class... T> class allocator_variant;
+
+namespace detail
+{
+
+template<class V, class R> struct allocator_variant_assign_L
+{
+    V * this_;
+    R && r;
+
+    template<class I> void operator()( I ) const
+    {
+        if( this_->index() == I::value )
+        {
+            unsafe_get<I::value>( *this_ ) = unsafe_get<I::value>( std::forward<R>(r) );
+        }
+        else
+        {
+            this_->template emplace<I::value>( unsafe_get<I::value>( std::forward<R>(r) ) );
+        }
+    }
+};
+
+} // namespace detail
+
+// a variant that keeps the allocator it has been constructed with, and
+// uses it to construct each of its alternatives
+
+template<class A, class... T> class allocator_variant: public variant<T...>
+{
+private:
+
+    using base_type = variant<T...>;
+
+    A al_;
+
+public:
+
+    using allocator_type = A;
+
+    // constructors
+
+    allocator_variant(): allocator_variant( std::allocator_arg, A() )
+    {
+    }
+
+    explicit allocator_variant( A const& al ): allocator_variant( std::allocator_arg, al )
+    {
+    }
+
+    // as with the standard containers, a copy gets the allocator returned
+    // by select_on_container_copy_construction, and a move takes the allocator
+    // of the source
+
+    allocator_variant( allocator_variant const& r ): allocator_variant( std::allocator_arg, std::allocator_traits<A>::select_on_container_copy_construction( r.al_ ), r )
+    {
+    }
+
+    // the alternative is moved by uses-allocator construction with the allocator
+    // of the source, and the move is noexcept when that construction is
+
+    allocator_variant( allocator_variant&& r ) noexcept( mp11::mp_all<detail::is_nothrow_uses_alloc_constructible<T, A, T&&>...>::value && std::is_nothrow_copy_constructible<A>::value ):
+        allocator_variant( std::allocator_arg, r.al_, std::move( r ) )
+    {
+    }
+
+    // the constructors without an allocator use A(); for polymorphic_allocator,
+    // this is the default memory resource
+
+    template<class U,
+        class Ud = typename std::decay<U>::type,
+        class E = typename std::enable_if<
+            !std::is_base_of<base_type, Ud>::value && !std::is_same<Ud, A>::value && !detail::is_in_place_index<Ud>::value && !detail::is_in_place_type<Ud>::value &&
+            std::is_default_constructible<A>::value && std::is_constructible<base_type, std::allocator_arg_t, A const&, U&&>::value
+        >::type>
+    allocator_variant( U&& u ): allocator_variant( std::allocator_arg, A(), std::forward<U>(u) )
+    {
+    }
+
+    template<class U, class... Args, class E = typename std::enable_if<std::is_default_constructible<A>::value && std::is_constructible<base_type, std::allocator_arg_t, A const&, in_place_type_t<U>, Args&&...>::value>::type>
+    explicit allocator_variant( in_place_type_t<U> t, Args&&... a ): allocator_variant( std::allocator_arg, A(), t, std::forward<Args>(a)... )
+    {
+    }
+
+    template<std::size_t I, class... Args, class E = typename std::enable_if<std::is_default_constructible<A>::value && std::is_constructible<base_type, std::allocator_arg_t, A const&, in_place_index_t<I>, Args&&...>::value>::type>
+    explicit allocator_variant( in_place_index_t<I> i, Args&&... a ): allocator_variant( std::allocator_arg, A(), i, std::forward<Args>(a)... )
+    {
+    }
+
+    // allocator-extended constructors
+
+    template<class... Args, class E = typename std::enable_if<std::is_constructible<base_type, std::allocator_arg_t, A const&, Args&&...>::value>::type>
+    allocator_variant( std::allocator_arg_t, A const& al, Args&&... a ): base_type( std::allocator_arg, al, std::forward<Args>(a)... ), al_( al )
+    {
+    }
+
+    // assignment; the allocator is not propagated
+
+    allocator_variant& operator=( allocator_variant const& r )
+    {
+        return *this = static_cast<base_type const&>( r );
+    }
+
+    allocator_variant& operator=( allocator_variant&& r )
+    {
+        return *this = static_cast<base_type&&>( r );
+    }
+
+    allocator_variant& operator=( base_type const& r )
+    {
+        detail::with_index<base_type, sizeof...(T)>( r.index(), detail::allocator_variant_assign_L<allocator_variant, base_type const&>{ this, r } );
+        return *this;
+    }
+
+    allocator_variant& operator=( base_type&& r )
+    {
+        detail::with_index<base_type, sizeof...(T)>( r.index(), detail::allocator_variant_assign_L<allocator_variant, base_type&&>{ this, std::move( r ) } );
+        return *this;
+    }
+
+    template<class U,
+        class Ud = typename std::decay<U>::type,
+        class E1 = typename std::enable_if< !std::is_base_of<base_type, Ud>::value >::type,
+        class V = detail::resolve_overload_type<U&&, T...>,
+        class E2 = typename std::enable_if< detail::is_uses_alloc_constructible<V, A, U&&>::value >::type
+    >
+    allocator_variant& operator=( U&& u )
+    {
+        std::size_t const I = detail::resolve_overload_index<U&&, T...>::value;
+        this->template emplace<I>( std::forward<U>(u) );
+        return *this;
+    }
+
+    // modifiers; the alternative is constructed with the stored allocator
+
+    template<class U, class... Args,
+        class E = typename std::enable_if< mp11::mp_count<base_type, U>::value == 1 && detail::is_uses_alloc_constructible<U, A, Args&&...>::value >::type>
+    U& emplace( Args&&... a )
+    {
+        return base_type::template emplace<U>( std::allocator_arg, al_, std::forward<Args>(a)... );
+    }
+
+    template<std::size_t I, class... Args, class E = typename std::enable_if< detail::is_uses_alloc_constructible<mp11::mp_at_c<base_type, I>, A, Args&&...>::value >::type>
+    variant_alternative_t<I, base_type>& emplace( Args&&... a )
+    {
+        return base_type::template emplace<I>( std::allocator_arg, al_, std::forward<Args>(a)... );
+    }
+
+    // allocator
+
+    allocator_type get_allocator() const noexcept
+    {
+        return al_;
+    }
+};
+
+#if defined(BOOST_VARIANT2_HAS_MEMORY_RESOURCE)
+
+namespace pmr
+{
+
+template<class... T> using variant = allocator_variant<std::pmr::polymorphic_allocator<std::byte>, T...>;
+
+} // namespace pmr
+
+#endif
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_PMR_HPP_INCLUDED
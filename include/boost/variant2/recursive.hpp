@@ -0,0 +1,448 @@
+#ifndef BOOST_VARIANT2_RECURSIVE_HPP_INCLUDED
+#define BOOST_VARIANT2_RECURSIVE_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/variant2/relocate.hpp>
+#include <boost/mp11.hpp>
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace boost
+{
+namespace variant2
+{
+
+// bump_arena
+
+class bump_arena
+{
+private:
+
+    struct chunk
+    {
+        chunk* next;
+        std::size_t size;
+    };
+
+    struct cleanup
+    {
+        cleanup* next;
+        void (*fn)( void* );
+        void* p;
+    };
+
+    // the header of a chunk keeps its data maximally aligned
+    static constexpr std::size_t header_size = ( sizeof(chunk) + alignof(std::max_align_t) - 1 ) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    chunk* chunks_;
+
+    std::uintptr_t cur_;
+    std::uintptr_t end_;
+
+    cleanup* cleanups_;
+
+    std::size_t next_size_;
+
+private:
+
+    static std::uintptr_t chunk_data( chunk* c ) noexcept
+    {
+        return reinterpret_cast<std::uintptr_t>( c ) + header_size;
+    }
+
+    BOOST_NOINLINE void* allocate_slow( std::size_t n, std::size_t a )
+    {
+        std::size_t size = next_size_;
+        if( size < n + a ) size = n + a;
+
+        chunk* c = static_cast<chunk*>( ::operator new( header_size + size ) );
+
+        c->next = chunks_;
+        c->size = size;
+
+        chunks_ = c;
+
+        cur_ = chunk_data( c );
+        end_ = cur_ + size;
+
+        next_size_ = size * 2;
+
+        return allocate( n, a );
+    }
+
+    void run_cleanups() noexcept
+    {
+        while( cleanups_ )
+        {
+            cleanup* c = cleanups_;
+            cleanups_ = c->next;
+
+            c->fn( c->p );
+        }
+    }
+
+public:
+
+    explicit bump_arena( std::size_t initial_size = 4096 ) noexcept: chunks_( 0 ), cur_( 0 ), end_( 0 ), cleanups_( 0 ), next_size_( initial_size )
+    {
+    }
+
+    bump_arena( bump_arena const& ) = delete;
+    bump_arena& operator=( bump_arena const& ) = delete;
+
+    ~bump_arena()
+    {
+        run_cleanups();
+
+        while( chunks_ )
+        {
+            chunk* c = chunks_;
+            chunks_ = c->next;
+
+            ::operator delete( c );
+        }
+    }
+
+    // requires: n > 0, a is a power of two
+    void* allocate( std::size_t n, std::size_t a )
+    {
+        BOOST_ASSERT( n > 0 );
+        BOOST_ASSERT( a != 0 && ( a & ( a - 1 ) ) == 0 );
+
+        std::uintptr_t p = ( cur_ + a - 1 ) & ~static_cast<std::uintptr_t>( a - 1 );
+
+        if( p <= end_ && end_ - p >= n )
+        {
+            cur_ = p + n;
+            return reinterpret_cast<void*>( p );
+        }
+
+        return allocate_slow( n, a );
+    }
+
+    // fn( p ) is called by release, in the reverse order of registration
+    void add_cleanup( void (*fn)( void* ), void* p )
+    {
+        cleanup* c = static_cast<cleanup*>( allocate( sizeof(cleanup), alignof(cleanup) ) );
+
+        c->next = cleanups_;
+        c->fn = fn;
+        c->p = p;
+
+        cleanups_ = c;
+    }
+
+    // runs the cleanups and frees everything at once; the largest chunk
+    // is kept for reuse
+    void release() noexcept
+    {
+        run_cleanups();
+
+        if( chunks_ == 0 ) return;
+
+        while( chunks_->next )
+        {
+            chunk* c = chunks_->next;
+            chunks_->next = c->next;
+
+            ::operator delete( c );
+        }
+
+        cur_ = chunk_data( chunks_ );
+        end_ = cur_ + chunks_->size;
+    }
+};
+
+// recursive
+
+namespace detail
+{
+
+template<class T, class Arena> struct recursive_node
+{
+    Arena* arena;
+    T value;
+
+    template<class... A> explicit recursive_node( Arena* a, A&&... args ): arena( a ), value( std::forward<A>(args)... )
+    {
+    }
+};
+
+// destroys the node when the registration of its cleanup throws
+
+template<class N> struct recursive_node_guard
+{
+    N* p_;
+
+    ~recursive_node_guard()
+    {
+        if( p_ ) p_->~N();
+    }
+};
+
+// the value of a moved-from box is created on first use
+
+template<class T> using recursive_nothrow_empty = mp11::mp_bool< !std::is_default_constructible<T>::value || std::is_nothrow_default_constructible<T>::value >;
+
+} // namespace detail
+
+// a box for recursive alternatives whose node is allocated from an arena,
+// and owned by it; the box is trivially destructible, and the arena
+// destroys the nodes that aren't on release
+
+template<class T, class Arena = bump_arena> class recursive
+{
+public:
+
+    using value_type = T;
+    using arena_type = Arena;
+
+private:
+
+    using node_type = detail::recursive_node<T, Arena>;
+
+    // a moved-from box holds no node; it keeps a pointer to the arena, marked
+    // by the low bit, and has the value of a value-initialized T, which is
+    // allocated from the arena when it's accessed through a non-const reference
+
+    std::uintptr_t p_;
+
+private:
+
+    static void destroy( void* p ) noexcept
+    {
+        static_cast<node_type*>( p )->~node_type();
+    }
+
+    template<class... A> static std::uintptr_t create( Arena& a, A&&... args )
+    {
+        static_assert( alignof(node_type) >= 2, "The low bit of a node pointer must be zero" );
+
+        void* pv = a.allocate( sizeof(node_type), alignof(node_type) );
+        node_type* p = ::new( pv ) node_type( &a, std::forward<A>(args)... );
+
+        if( !std::is_trivially_destructible<T>::value )
+        {
+            detail::recursive_node_guard<node_type> guard{ p };
+            a.add_cleanup( &recursive::destroy, p );
+            guard.p_ = 0;
+        }
+
+        return reinterpret_cast<std::uintptr_t>( p );
+    }
+
+    static std::uintptr_t moved_from( Arena* a ) noexcept
+    {
+        static_assert( alignof(Arena) >= 2, "The low bit of an arena pointer must be zero" );
+        return reinterpret_cast<std::uintptr_t>( a ) | 1;
+    }
+
+    bool is_moved_from() const noexcept
+    {
+        return ( p_ & 1 ) != 0;
+    }
+
+    node_type* node() const noexcept
+    {
+        BOOST_ASSERT( !is_moved_from() );
+        return reinterpret_cast<node_type*>( p_ );
+    }
+
+    // a moved-from box of a T that isn't default constructible has no value
+
+    static T const& empty_value() noexcept( detail::recursive_nothrow_empty<T>::value )
+    {
+        static T const empty{};
+        return empty;
+    }
+
+    T const& value( mp11::mp_true ) const noexcept( detail::recursive_nothrow_empty<T>::value )
+    {
+        return is_moved_from()? empty_value(): node()->value;
+    }
+
+    T const& value( mp11::mp_false ) const noexcept
+    {
+        return node()->value;
+    }
+
+    T const& value() const noexcept( detail::recursive_nothrow_empty<T>::value )
+    {
+        return value( std::is_default_constructible<T>() );
+    }
+
+    T& unique_value( mp11::mp_true )
+    {
+        if( is_moved_from() )
+        {
+            p_ = create( *arena() );
+        }
+
+        return node()->value;
+    }
+
+    T& unique_value( mp11::mp_false ) noexcept
+    {
+        return node()->value;
+    }
+
+    T& unique_value()
+    {
+        return unique_value( std::is_default_constructible<T>() );
+    }
+
+public:
+
+    template<class... A, class E = typename std::enable_if<std::is_constructible<T, A&&...>::value>::type>
+    explicit recursive( Arena& a, A&&... args ): p_( create( a, std::forward<A>(args)... ) )
+    {
+    }
+
+    // a copy is allocated from the arena of r
+    recursive( recursive const& r ): p_( create( *r.arena(), r.value() ) )
+    {
+    }
+
+    recursive( recursive&& r ) noexcept: p_( r.p_ )
+    {
+        r.p_ = moved_from( r.arena() );
+    }
+
+    ~recursive() = default;
+
+    recursive& operator=( recursive const& r )
+    {
+        if( is_moved_from() )
+        {
+            p_ = create( *r.arena(), r.value() );
+        }
+        else
+        {
+            node()->value = r.value();
+        }
+
+        return *this;
+    }
+
+    recursive& operator=( recursive&& r ) noexcept
+    {
+        if( this != &r )
+        {
+            Arena* a = r.arena();
+
+            p_ = r.p_;
+            r.p_ = moved_from( a );
+        }
+
+        return *this;
+    }
+
+    Arena* arena() const noexcept
+    {
+        return is_moved_from()? reinterpret_cast<Arena*>( p_ & ~static_cast<std::uintptr_t>( 1 ) ): node()->arena;
+    }
+
+    // the non-const accessors of a moved-from box allocate a new node
+
+    T& operator*() &
+    {
+        return unique_value();
+    }
+
+    T const& operator*() const& noexcept( detail::recursive_nothrow_empty<T>::value )
+    {
+        return value();
+    }
+
+    T&& operator*() &&
+    {
+        return std::move( unique_value() );
+    }
+
+    T const&& operator*() const&& noexcept( detail::recursive_nothrow_empty<T>::value )
+    {
+        return std::move( value() );
+    }
+
+    T* operator->()
+    {
+        return &unique_value();
+    }
+
+    T const* operator->() const noexcept( detail::recursive_nothrow_empty<T>::value )
+    {
+        return &value();
+    }
+
+    // the conversions let a visitor that takes T handle a box of T
+
+    operator T&() &
+    {
+        return **this;
+    }
+
+    operator T const&() const& noexcept( detail::recursive_nothrow_empty<T>::value )
+    {
+        return **this;
+    }
+
+    operator T&&() &&
+    {
+        return *std::move( *this );
+    }
+
+    operator T const&&() const&& noexcept( detail::recursive_nothrow_empty<T>::value )
+    {
+        return *std::move( *this );
+    }
+
+    friend bool operator==( recursive const& x, recursive const& y )
+    {
+        return *x == *y;
+    }
+
+    friend bool operator!=( recursive const& x, recursive const& y )
+    {
+        return *x != *y;
+    }
+
+    friend bool operator<( recursive const& x, recursive const& y )
+    {
+        return *x < *y;
+    }
+
+    friend bool operator>( recursive const& x, recursive const& y )
+    {
+        return *x > *y;
+    }
+
+    friend bool operator<=( recursive const& x, recursive const& y )
+    {
+        return *x <= *y;
+    }
+
+    friend bool operator>=( recursive const& x, recursive const& y )
+    {
+        return *x >= *y;
+    }
+};
+
+// is_trivially_relocatable
+
+template<class T, class Arena> struct is_trivially_relocatable<recursive<T, Arena>>: std::true_type
+{
+};
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_RECURSIVE_HPP_INCLUDED
@@ -0,0 +1,112 @@
+#ifndef BOOST_VARIANT2_RELOCATE_HPP_INCLUDED
+#define BOOST_VARIANT2_RELOCATE_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/mp11.hpp>
+#include <boost/config.hpp>
+#include <cstring>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__has_builtin)
+# if __has_builtin(__builtin_is_cpp_trivially_relocatable)
+#  define BOOST_VARIANT2_IS_TRIVIALLY_RELOCATABLE(T) __builtin_is_cpp_trivially_relocatable(T)
+# elif __has_builtin(__is_trivially_relocatable)
+#  define BOOST_VARIANT2_IS_TRIVIALLY_RELOCATABLE(T) __is_trivially_relocatable(T)
+# endif
+#endif
+
+#if !defined(BOOST_VARIANT2_IS_TRIVIALLY_RELOCATABLE)
+# define BOOST_VARIANT2_IS_TRIVIALLY_RELOCATABLE(T) std::is_trivially_copyable<T>::value
+#endif
+
+namespace boost
+{
+namespace variant2
+{
+
+// is_trivially_relocatable
+
+template<class T> struct is_trivially_relocatable: mp11::mp_bool<
+    BOOST_VARIANT2_IS_TRIVIALLY_RELOCATABLE(T) || std::is_trivially_copyable<T>::value
+>
+{
+};
+
+template<class... T> struct is_trivially_relocatable<variant<T...>>: mp11::mp_all<is_trivially_relocatable<T>...>
+{
+};
+
+// uninitialized_relocate
+
+namespace detail
+{
+
+template<class T> T* uninitialized_relocate_impl( mp11::mp_true, T* first, T* last, T* d_first ) noexcept
+{
+    std::size_t n = static_cast<std::size_t>( last - first );
+
+    if( n != 0 )
+    {
+        std::memcpy( static_cast<void*>( d_first ), static_cast<void const*>( first ), n * sizeof(T) );
+    }
+
+    return d_first + n;
+}
+
+template<class T> struct relocate_guard
+{
+    T* first_;
+    T* last_;
+
+    T* d_first_;
+    T* d_last_;
+
+    ~relocate_guard()
+    {
+        for( ; first_ != last_; ++first_ ) first_->~T();
+        for( ; d_first_ != d_last_; ++d_first_ ) d_first_->~T();
+    }
+};
+
+template<class T> T* uninitialized_relocate_impl( mp11::mp_false, T* first, T* last, T* d_first )
+    noexcept( std::is_nothrow_move_constructible<T>::value )
+{
+    relocate_guard<T> g{ first, last, d_first, d_first };
+
+    for( ; g.first_ != g.last_; ++g.first_, ++g.d_last_ )
+    {
+        ::new( static_cast<void*>( g.d_last_ ) ) T( std::move( *g.first_ ) );
+        g.first_->~T();
+    }
+
+    T* r = g.d_last_;
+
+    g.d_first_ = r;
+    return r;
+}
+
+} // namespace detail
+
+template<class T> T* uninitialized_relocate( T* first, T* last, T* d_first )
+    noexcept( is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value )
+{
+    return detail::uninitialized_relocate_impl( is_trivially_relocatable<T>(), first, last, d_first );
+}
+
+template<class T> T* uninitialized_relocate_n( T* first, std::size_t n, T* d_first )
+    noexcept( is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value )
+{
+    return detail::uninitialized_relocate_impl( is_trivially_relocatable<T>(), first, first + n, d_first );
+}
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_RELOCATE_HPP_INCLUDED
@@ -0,0 +1,197 @@
+#ifndef BOOST_VARIANT2_SHARED_VARIANT_HPP_INCLUDED
+#define BOOST_VARIANT2_SHARED_VARIANT_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/mp11.hpp>
+#include <boost/config.hpp>
+#include <atomic>
+#include <cstring>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace boost
+{
+namespace variant2
+{
+namespace detail
+{
+
+// a copy of the variant, protected by a sequence counter that is odd while it's being written
+
+template<std::size_t N> struct alignas(64) seqlock_buffer
+{
+    static constexpr std::size_t words = ( N + sizeof(std::size_t) - 1 ) / sizeof(std::size_t);
+
+    std::atomic<std::size_t> seq;
+
+    // the words are accessed with relaxed atomic operations, so that
+    // a reader racing with the writer doesn't cause undefined behavior
+    std::atomic<std::size_t> data[ words ];
+
+    seqlock_buffer() noexcept: seq( 0 )
+    {
+    }
+
+    void write( void const* p ) noexcept
+    {
+        std::size_t w[ words ] = {};
+        std::memcpy( w, p, N );
+
+        std::size_t s = seq.load( std::memory_order_relaxed );
+
+        seq.store( s + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+
+        for( std::size_t i = 0; i < words; ++i )
+        {
+            data[ i ].store( w[ i ], std::memory_order_relaxed );
+        }
+
+        seq.store( s + 2, std::memory_order_release );
+    }
+
+    // returns false when the buffer has been written to during the read
+    bool try_read( void* p ) const noexcept
+    {
+        std::size_t s1 = seq.load( std::memory_order_acquire );
+
+        if( s1 & 1 ) return false;
+
+        std::size_t w[ words ];
+
+        for( std::size_t i = 0; i < words; ++i )
+        {
+            w[ i ] = data[ i ].load( std::memory_order_relaxed );
+        }
+
+        std::atomic_thread_fence( std::memory_order_acquire );
+
+        if( seq.load( std::memory_order_relaxed ) != s1 ) return false;
+
+        std::memcpy( p, w, N );
+        return true;
+    }
+};
+
+#if defined(BOOST_NO_CXX17_INLINE_VARIABLES)
+
+template<std::size_t N> constexpr std::size_t seqlock_buffer<N>::words;
+
+#endif
+
+} // namespace detail
+
+// shared_variant
+
+template<class... T> class shared_variant
+{
+public:
+
+    using value_type = variant<T...>;
+
+private:
+
+    static_assert( mp11::mp_all<std::is_trivially_copyable<T>...>::value, "shared_variant requires trivially copyable alternatives" );
+    static_assert( std::is_trivially_copyable<value_type>::value, "shared_variant requires a trivially copyable variant" );
+
+    // the writer fills the buffer that readers aren't directed to, then
+    // publishes it; a reader only retries when the writer has come back
+    // to its buffer, which takes two stores during a single read
+
+    detail::seqlock_buffer<sizeof(value_type)> buffer_[ 2 ];
+    std::atomic<unsigned> current_;
+
+private:
+
+    void read( void* p ) const noexcept
+    {
+        for( ;; )
+        {
+            unsigned i = current_.load( std::memory_order_acquire );
+            if( buffer_[ i ].try_read( p ) ) return;
+        }
+    }
+
+    // the bytes are copied into the result, as store copies them out of its argument
+
+    value_type load( std::true_type ) const noexcept
+    {
+        value_type r;
+        read( &r );
+        return r;
+    }
+
+    // without a default constructor, into storage, in which the copy implicitly
+    // creates the trivially copyable value
+
+    value_type load( std::false_type ) const noexcept
+    {
+        alignas(value_type) unsigned char st[ sizeof(value_type) ];
+        read( st );
+
+#if defined(__cpp_lib_launder) && __cpp_lib_launder >= 201606L
+        return *std::launder( reinterpret_cast<value_type const*>( st ) );
+#else
+        return *reinterpret_cast<value_type const*>( st );
+#endif
+    }
+
+public:
+
+    // constructors
+
+    shared_variant() noexcept( std::is_nothrow_default_constructible<value_type>::value ): current_( 0 )
+    {
+        value_type v;
+        buffer_[ 0 ].write( &v );
+    }
+
+    explicit shared_variant( value_type const& v ) noexcept: current_( 0 )
+    {
+        buffer_[ 0 ].write( &v );
+    }
+
+    shared_variant( shared_variant const& ) = delete;
+    shared_variant& operator=( shared_variant const& ) = delete;
+
+    // readers
+
+    value_type load() const noexcept
+    {
+        return load( std::is_default_constructible<value_type>() );
+    }
+
+    // calls f with a consistent copy of the current value
+    template<class F> auto visit( F&& f ) const -> decltype( variant2::visit( std::forward<F>(f), std::declval<value_type const&>() ) )
+    {
+        value_type const v = load();
+        return variant2::visit( std::forward<F>(f), v );
+    }
+
+    // writer; concurrent calls must be serialized by the caller
+
+    void store( value_type const& v ) noexcept
+    {
+        unsigned i = current_.load( std::memory_order_relaxed ) ^ 1;
+
+        buffer_[ i ].write( &v );
+        current_.store( i, std::memory_order_release );
+    }
+
+    value_type const& operator=( value_type const& v ) noexcept
+    {
+        store( v );
+        return v;
+    }
+};
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_SHARED_VARIANT_HPP_INCLUDED
@@ -0,0 +1,204 @@
+#ifndef BOOST_VARIANT2_UNTAGGED_VARIANT_HPP_INCLUDED
+#define BOOST_VARIANT2_UNTAGGED_VARIANT_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/mp11.hpp>
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace boost
+{
+namespace variant2
+{
+
+// untagged_variant
+
+template<class... T> class untagged_variant;
+
+namespace detail
+{
+
+template<class... T> struct uv_destroy_L
+{
+    untagged_variant<T...>* this_;
+
+    template<class I> void operator()( I ) const noexcept
+    {
+        using U = mp11::mp_at<mp11::mp_list<T...>, I>;
+        this_->template get<I::value>().~U();
+    }
+};
+
+template<class... T> struct uv_copy_L
+{
+    untagged_variant<T...>* this_;
+    untagged_variant<T...> const& r;
+
+    template<class I> void operator()( I ) const
+    {
+        this_->template emplace<I::value>( r.template get<I::value>() );
+    }
+};
+
+template<class... T> struct uv_move_L
+{
+    untagged_variant<T...>* this_;
+    untagged_variant<T...>& r;
+
+    template<class I> void operator()( I ) const
+    {
+        this_->template emplace<I::value>( std::move( r.template get<I::value>() ) );
+    }
+};
+
+template<class... T> struct uv_to_variant_L
+{
+    untagged_variant<T...> const& r;
+
+    template<class I> variant<T...> operator()( I ) const
+    {
+        return variant<T...>( in_place_index_t<I::value>(), r.template get<I::value>() );
+    }
+};
+
+template<class F, class... T> struct uv_visit_L
+{
+    untagged_variant<T...>& r;
+    F&& f;
+
+    template<class I> auto operator()( I ) const -> decltype( std::forward<F>(f)( r.template get<0>() ) )
+    {
+        return std::forward<F>(f)( r.template get<I::value>() );
+    }
+};
+
+template<class F, class... T> struct uv_cvisit_L
+{
+    untagged_variant<T...> const& r;
+    F&& f;
+
+    template<class I> auto operator()( I ) const -> decltype( std::forward<F>(f)( r.template get<0>() ) )
+    {
+        return std::forward<F>(f)( r.template get<I::value>() );
+    }
+};
+
+} // namespace detail
+
+template<class... T> class untagged_variant
+{
+private:
+
+    static_assert( sizeof...(T) > 0, "untagged_variant requires at least one alternative" );
+
+    detail::variant_storage<detail::none, T...> st_;
+
+public:
+
+    // constructors
+
+    constexpr untagged_variant() noexcept: st_( mp11::mp_size_t<0>() )
+    {
+    }
+
+    template<std::size_t I, class... A> constexpr explicit untagged_variant( in_place_index_t<I>, A&&... a ): st_( mp11::mp_size_t<I + 1>(), std::forward<A>(a)... )
+    {
+    }
+
+    // modifiers
+
+    // requires: *this holds no value
+    template<std::size_t I, class... A> variant_alternative_t<I, variant<T...>>& emplace( A&&... a )
+    {
+        static_assert( I < sizeof...(T), "Index out of bounds" );
+
+        st_.emplace( mp11::mp_size_t<I + 1>(), std::forward<A>(a)... );
+        return get<I>();
+    }
+
+    // requires: *this holds the alternative with index i
+    void destroy( std::size_t i ) noexcept
+    {
+        BOOST_ASSERT( i < sizeof...(T) );
+
+        this->destroy_impl( mp11::mp_all<std::is_trivially_destructible<T>...>(), i );
+    }
+
+    // requires: *this holds no value, r holds the alternative with index i
+    void copy_from( std::size_t i, untagged_variant const& r )
+    {
+        BOOST_ASSERT( i < sizeof...(T) );
+
+        detail::with_index<variant<T...>, sizeof...(T)>( i, detail::uv_copy_L<T...>{ this, r } );
+    }
+
+    // requires: *this holds no value, r holds the alternative with index i
+    void move_from( std::size_t i, untagged_variant&& r )
+    {
+        BOOST_ASSERT( i < sizeof...(T) );
+
+        detail::with_index<variant<T...>, sizeof...(T)>( i, detail::uv_move_L<T...>{ this, r } );
+    }
+
+    // access
+
+    template<std::size_t I> BOOST_CXX14_CONSTEXPR variant_alternative_t<I, variant<T...>>& get() noexcept
+    {
+        static_assert( I < sizeof...(T), "Index out of bounds" );
+        return st_.get( mp11::mp_size_t<I + 1>() );
+    }
+
+    template<std::size_t I> constexpr variant_alternative_t<I, variant<T...>> const& get() const noexcept
+    {
+        static_assert( I < sizeof...(T), "Index out of bounds" );
+        return st_.get( mp11::mp_size_t<I + 1>() );
+    }
+
+    // requires: *this holds the alternative with index i
+    variant<T...> to_variant( std::size_t i ) const
+    {
+        BOOST_ASSERT( i < sizeof...(T) );
+
+        return detail::with_index<variant<T...>, sizeof...(T)>( i, detail::uv_to_variant_L<T...>{ *this } );
+    }
+
+    // visitation
+
+    // requires: *this holds the alternative with index i
+    template<class F> auto visit( std::size_t i, F&& f ) -> decltype( std::forward<F>(f)( std::declval<variant_alternative_t<0, variant<T...>>&>() ) )
+    {
+        BOOST_ASSERT( i < sizeof...(T) );
+
+        return detail::with_index<variant<T...>, sizeof...(T)>( i, detail::uv_visit_L<F, T...>{ *this, std::forward<F>(f) } );
+    }
+
+    template<class F> auto visit( std::size_t i, F&& f ) const -> decltype( std::forward<F>(f)( std::declval<variant_alternative_t<0, variant<T...>> const&>() ) )
+    {
+        BOOST_ASSERT( i < sizeof...(T) );
+
+        return detail::with_index<variant<T...>, sizeof...(T)>( i, detail::uv_cvisit_L<F, T...>{ *this, std::forward<F>(f) } );
+    }
+
+private:
+
+    void destroy_impl( mp11::mp_true, std::size_t /*i*/ ) noexcept
+    {
+    }
+
+    void destroy_impl( mp11::mp_false, std::size_t i ) noexcept
+    {
+        detail::with_index<variant<T...>, sizeof...(T)>( i, detail::uv_destroy_L<T...>{ this } );
+    }
+};
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_UNTAGGED_VARIANT_HPP_INCLUDED
@@ -24,6 +24,9 @@
 #include <cstdint>
 #include <cerrno>
 #include <limits>
+#include <cstring>
+#include <new>
+#include <memory> // std::allocator_arg_t, std::uses_allocator
 
 //
 
@@ -34,6 +37,25 @@
 # define BOOST_VARIANT2_CXX20_CONSTEXPR
 #endif
 
+// visit( f, v1, v2 ) dispatches once on the combined index when the number of
+// alternative combinations does not exceed this limit, and recursively otherwise;
+// the limit can't exceed 64, the number of cases in the combined switch
+#if !defined(BOOST_VARIANT2_MAX_FLAT_VISIT)
+# define BOOST_VARIANT2_MAX_FLAT_VISIT 64
+#endif
+
+// BOOST_VARIANT2_ENABLE_PROFILING counts, per thread and per variant type, how
+// often each alternative is constructed, emplaced, visited and destroyed
+#if defined(BOOST_VARIANT2_ENABLE_PROFILING)
+# include <boost/current_function.hpp>
+# include <ostream>
+# define BOOST_VARIANT2_PROFILE(V, c, i) ::boost::variant2::detail::profile_count<V>( ::boost::variant2::detail::profile_##c, i )
+# define BOOST_VARIANT2_PROFILE_EXPR(V, c, i, ...) ( BOOST_VARIANT2_PROFILE(V, c, i), __VA_ARGS__ )
+#else
+# define BOOST_VARIANT2_PROFILE(V, c, i) ((void)0)
+# define BOOST_VARIANT2_PROFILE_EXPR(V, c, i, ...) __VA_ARGS__
+#endif
+
 //
 
 namespace boost
@@ -84,6 +106,155 @@ BOOST_NORETURN inline void throw_bad_variant_access()
 
 } // namespace detail
 
+#if defined(BOOST_VARIANT2_ENABLE_PROFILING)
+
+// profiling
+
+struct variant_profile_record
+{
+    char const * name;
+    std::size_t size;
+
+    unsigned long long * constructed;
+    unsigned long long * emplaced;
+    unsigned long long * visited;
+    unsigned long long * destroyed;
+
+    unsigned long long buffer_flips;
+
+    variant_profile_record * next;
+};
+
+namespace detail
+{
+
+enum profile_counter
+{
+    profile_constructed,
+    profile_emplaced,
+    profile_visited,
+    profile_destroyed,
+    profile_buffer_flips
+};
+
+inline variant_profile_record *& profile_head() noexcept
+{
+    static thread_local variant_profile_record * p = 0;
+    return p;
+}
+
+template<class V> char const * profile_name() noexcept
+{
+    return BOOST_CURRENT_FUNCTION;
+}
+
+// trivially destructible, so that variants destroyed during thread exit
+// can still be counted
+template<class V> struct profile_data
+{
+    static constexpr std::size_t N = mp11::mp_size<V>::value;
+
+    unsigned long long counts_[ 4 ][ N ];
+    variant_profile_record rec_;
+
+    profile_data() noexcept: counts_(), rec_{ profile_name<V>(), N, counts_[ 0 ], counts_[ 1 ], counts_[ 2 ], counts_[ 3 ], 0, profile_head() }
+    {
+        profile_head() = &rec_;
+    }
+
+    static profile_data& instance() noexcept
+    {
+        static thread_local profile_data d;
+        return d;
+    }
+};
+
+template<class V> void profile_count( profile_counter c, std::size_t i ) noexcept
+{
+    profile_data<V>& d = profile_data<V>::instance();
+
+    if( c == profile_buffer_flips )
+    {
+        ++d.rec_.buffer_flips;
+    }
+    else
+    {
+        BOOST_ASSERT( i < d.N );
+        ++d.counts_[ c ][ i ];
+    }
+}
+
+template<class Ch, class Tr> void profile_print_name( std::basic_ostream<Ch, Tr>& os, char const * p )
+{
+    // "... [with V = variant<...>]" (GCC, Clang) or "...<variant<...>>(void)" (MSVC)
+
+    char const * first = p;
+    char const * last = p;
+
+    for( char const * q = p; *q; ++q )
+    {
+        if( q[ 0 ] == 'V' && q[ 1 ] == ' ' && q[ 2 ] == '=' && q[ 3 ] == ' ' )
+        {
+            first = q + 4;
+        }
+
+        last = q + 1;
+    }
+
+    if( first != p && last != first && last[ -1 ] == ']' )
+    {
+        --last;
+    }
+
+    for( ; first != last; ++first )
+    {
+        os << os.widen( *first );
+    }
+}
+
+} // namespace detail
+
+template<class V> variant_profile_record const& variant_profile() noexcept
+{
+    return detail::profile_data<V>::instance().rec_;
+}
+
+inline variant_profile_record const * variant_profile_first() noexcept
+{
+    return detail::profile_head();
+}
+
+inline void variant_profile_reset() noexcept
+{
+    for( variant_profile_record * p = detail::profile_head(); p; p = p->next )
+    {
+        for( std::size_t i = 0; i < p->size; ++i )
+        {
+            p->constructed[ i ] = p->emplaced[ i ] = p->visited[ i ] = p->destroyed[ i ] = 0;
+        }
+
+        p->buffer_flips = 0;
+    }
+}
+
+template<class Ch, class Tr> std::basic_ostream<Ch, Tr>& variant_profile_dump( std::basic_ostream<Ch, Tr>& os )
+{
+    for( variant_profile_record const * p = detail::profile_head(); p; p = p->next )
+    {
+        detail::profile_print_name( os, p->name );
+        os << ": buffer flips " << p->buffer_flips << '\n';
+
+        for( std::size_t i = 0; i < p->size; ++i )
+        {
+            os << "  " << i << ": constructed " << p->constructed[ i ] << ", emplaced " << p->emplaced[ i ] << ", visited " << p->visited[ i ] << ", destroyed " << p->destroyed[ i ] << '\n';
+        }
+    }
+
+    return os;
+}
+
+#endif
+
 // monostate
 
 struct monostate
@@ -319,6 +490,146 @@ template<std::size_t I, class... T> struct variant_alternative<I, variant<T...>>
 
 constexpr std::size_t variant_npos = ~static_cast<std::size_t>( 0 );
 
+// dispatch strategies
+
+struct switch_dispatch {};
+struct jump_table_dispatch {};
+struct binary_search_dispatch {};
+template<std::size_t... I> struct linear_dispatch {};
+
+#if !defined(BOOST_VARIANT2_DEFAULT_DISPATCH)
+# define BOOST_VARIANT2_DEFAULT_DISPATCH ::boost::variant2::switch_dispatch
+#endif
+
+template<class V> struct variant_dispatch_strategy
+{
+    using type = BOOST_VARIANT2_DEFAULT_DISPATCH;
+};
+
+namespace detail
+{
+
+template<class F> using with_index_result = decltype( std::declval<F>()( std::declval<mp11::mp_size_t<0>>() ) );
+
+template<class S, std::size_t N> struct with_index_impl;
+
+// switch_dispatch
+
+template<std::size_t N> struct with_index_impl<switch_dispatch, N>
+{
+    template<class F> static BOOST_CXX14_CONSTEXPR with_index_result<F> call( std::size_t i, F&& f )
+    {
+        return mp11::mp_with_index<N>( i, std::forward<F>(f) );
+    }
+};
+
+// jump_table_dispatch
+
+template<class F, class L> struct jump_table;
+
+template<class F, class... I> struct jump_table<F, mp11::mp_list<I...>>
+{
+    template<class J> static with_index_result<F> fn( F&& f )
+    {
+        return std::forward<F>(f)( J() );
+    }
+
+    static with_index_result<F> call( std::size_t i, F&& f )
+    {
+        static with_index_result<F> (* const table[])( F&& ) = { &fn<I>... };
+        return table[ i ]( std::forward<F>(f) );
+    }
+};
+
+template<std::size_t N> struct with_index_impl<jump_table_dispatch, N>
+{
+    template<class F> static with_index_result<F> call( std::size_t i, F&& f )
+    {
+        BOOST_ASSERT( i < N );
+        return jump_table<F, mp11::mp_iota_c<N>>::call( i, std::forward<F>(f) );
+    }
+};
+
+// binary_search_dispatch
+
+template<std::size_t K, std::size_t N> struct with_index_binary_search
+{
+    template<class F> static BOOST_CXX14_CONSTEXPR with_index_result<F> call( std::size_t i, F&& f )
+    {
+        if( i < K + N / 2 )
+        {
+            return with_index_binary_search<K, N / 2>::call( i, std::forward<F>(f) );
+        }
+        else
+        {
+            return with_index_binary_search<K + N / 2, N - N / 2>::call( i, std::forward<F>(f) );
+        }
+    }
+};
+
+template<std::size_t K> struct with_index_binary_search<K, 1>
+{
+    template<class F> static BOOST_CXX14_CONSTEXPR with_index_result<F> call( std::size_t /*i*/, F&& f )
+    {
+        return std::forward<F>(f)( mp11::mp_size_t<K>() );
+    }
+};
+
+template<std::size_t N> struct with_index_impl<binary_search_dispatch, N>: with_index_binary_search<0, N>
+{
+};
+
+// linear_dispatch
+
+template<class L> struct with_index_linear;
+
+template<class K, class... J> struct with_index_linear<mp11::mp_list<K, J...>>
+{
+    template<class F> static BOOST_CXX14_CONSTEXPR with_index_result<F> call( std::size_t i, F&& f )
+    {
+        if( i == K::value )
+        {
+            return std::forward<F>(f)( K() );
+        }
+        else
+        {
+            return with_index_linear<mp11::mp_list<J...>>::call( i, std::forward<F>(f) );
+        }
+    }
+};
+
+template<class K> struct with_index_linear<mp11::mp_list<K>>
+{
+    template<class F> static BOOST_CXX14_CONSTEXPR with_index_result<F> call( std::size_t /*i*/, F&& f )
+    {
+        return std::forward<F>(f)( K() );
+    }
+};
+
+// the indices given to linear_dispatch are probed first, in the given order,
+// followed by the rest in declaration order; indices not less than N are ignored
+
+template<std::size_t N> struct linear_probe_valid
+{
+    template<class I> using fn = mp11::mp_bool<( I::value < N )>;
+};
+
+template<std::size_t N, class L, class L2 = mp11::mp_unique<mp11::mp_copy_if_q<L, linear_probe_valid<N>>>>
+    using linear_probe_order = mp11::mp_append<L2, mp11::mp_remove_if_q<mp11::mp_iota_c<N>, mp11::mp_bind_front<mp11::mp_contains, L2>>>;
+
+template<std::size_t... I, std::size_t N> struct with_index_impl<linear_dispatch<I...>, N>: with_index_linear<linear_probe_order<N, mp11::mp_list<mp11::mp_size_t<I>...>>>
+{
+};
+
+//
+
+template<class V, std::size_t N, class F> BOOST_CXX14_CONSTEXPR with_index_result<F> with_index( std::size_t i, F&& f )
+{
+    return with_index_impl<typename variant_dispatch_strategy<V>::type, N>::call( i, std::forward<F>(f) );
+}
+
+} // namespace detail
+
 // holds_alternative
 
 #if !defined(BOOST_MP11_HAS_CXX14_CONSTEXPR)
@@ -351,7 +662,7 @@ template<class U, class... T> constexpr bool holds_alternative( variant<T...> co
     using V = variant<T...>;
     static_assert( mp11::mp_contains<V, U>::value, "The type must be present in the list of variant alternatives" );
 
-    return mp11::mp_with_index<sizeof...(T)>( v.index(), detail::holds_alternative_L<U, V>() );
+    return detail::with_index<variant<T...>, sizeof...(T)>( v.index(), detail::holds_alternative_L<U, V>() );
 }
 
 #endif
@@ -473,7 +784,7 @@ template<class U, class V> struct get_if_impl_L1
 
 template<class U, class... T> constexpr U* get_if_impl( variant<T...>& v ) noexcept
 {
-    return mp11::mp_with_index<sizeof...(T)>( v.index(), get_if_impl_L1< U, variant<T...> >{ v } );
+    return detail::with_index<variant<T...>, sizeof...(T)>( v.index(), get_if_impl_L1< U, variant<T...> >{ v } );
 }
 
 template<class U, class V> struct get_if_impl_L2
@@ -498,7 +809,7 @@ template<class U, class V> struct get_if_impl_L2
 
 template<class U, class... T> constexpr U const* get_if_impl( variant<T...> const& v ) noexcept
 {
-    return mp11::mp_with_index<sizeof...(T)>( v.index(), get_if_impl_L2< U, variant<T...> >{ v } );
+    return detail::with_index<variant<T...>, sizeof...(T)>( v.index(), get_if_impl_L2< U, variant<T...> >{ v } );
 }
 
 } // namespace detail
@@ -575,6 +886,91 @@ template<class U, class... T> constexpr typename std::add_pointer<U const>::type
     return v && holds_alternative<U>( *v )? detail::get_if_impl<U>( *v ): 0;
 }
 
+// niche_traits
+
+template<class T, class E = void> struct niche_traits
+{
+    static constexpr std::size_t count = 0;
+};
+
+// object representations of bool other than 0 and 1
+
+template<> struct niche_traits<bool>
+{
+    static constexpr std::size_t count = sizeof( bool ) == 1? 254: 0;
+
+    static void store( void * p, std::size_t n ) noexcept
+    {
+        unsigned char v = static_cast<unsigned char>( n + 2 );
+        std::memcpy( p, &v, 1 );
+    }
+
+    static std::size_t load( void const * p ) noexcept
+    {
+        unsigned char v;
+        std::memcpy( &v, p, 1 );
+
+        return v >= 2? v - 2u: 254u;
+    }
+};
+
+// the non-null addresses in the first page, which hold no objects; these
+// don't depend on T, so that T can be incomplete without changing the layout
+
+template<class T> struct niche_traits<T*, typename std::enable_if< std::is_object<T>::value >::type>
+{
+    static_assert( sizeof( T* ) == sizeof( std::uintptr_t ), "Object pointers are expected to have the size of std::uintptr_t" );
+
+    static constexpr std::size_t count = 255;
+
+    static void store( void * p, std::size_t n ) noexcept
+    {
+        std::uintptr_t v = n + 1;
+        std::memcpy( p, &v, sizeof(v) );
+    }
+
+    static std::size_t load( void const * p ) noexcept
+    {
+        std::uintptr_t v;
+        std::memcpy( &v, p, sizeof(v) );
+
+        return v != 0 && v <= count? static_cast<std::size_t>( v - 1 ): count;
+    }
+};
+
+// enumerators greater than Last; meant to be derived from
+// by specializations of niche_traits for enumeration types
+
+template<class E, E Last> struct niche_enum_traits
+{
+private:
+
+    using U = typename std::underlying_type<E>::type;
+    using UU = typename std::make_unsigned<U>::type;
+
+    static constexpr UU spare = static_cast<UU>( (std::numeric_limits<U>::max)() ) - static_cast<UU>( static_cast<U>( Last ) );
+
+public:
+
+    static constexpr std::size_t count = spare < 255? spare: 255;
+
+    static void store( void * p, std::size_t n ) noexcept
+    {
+        U v = static_cast<U>( static_cast<UU>( static_cast<U>( Last ) ) + 1 + n );
+        std::memcpy( p, &v, sizeof(v) );
+    }
+
+    static std::size_t load( void const * p ) noexcept
+    {
+        U v;
+        std::memcpy( &v, p, sizeof(v) );
+
+        UU d = static_cast<UU>( static_cast<UU>( v ) - static_cast<UU>( static_cast<U>( Last ) ) - 1 );
+
+        return v > static_cast<U>( Last ) && d < count? static_cast<std::size_t>( d ): static_cast<std::size_t>( count );
+    }
+};
+
 //
 
 namespace detail
@@ -953,10 +1349,85 @@ template<bool Double, class... T> using get_index_type = get_smallest_unsigned_t
 
 #endif
 
+} // namespace detail
+
+// storage policies
+
+struct double_buffer_storage {};
+struct single_buffer_storage {};
+
+template<class V> struct variant_storage_policy
+{
+    using type = double_buffer_storage;
+};
+
+namespace detail
+{
+
+// a single buffered variant with an alternative whose move constructor can
+// throw is reset to monostate, or to the first nothrow default constructible
+// alternative, when emplace fails
+
+template<class... T> using is_single_buffered = mp11::mp_bool<
+    mp11::mp_all<std::is_nothrow_move_constructible<T>...>::value ||
+    std::is_same<typename variant_storage_policy<variant<T...>>::type, single_buffer_storage>::value
+>;
+
+template<class... T> using variant_reset_index = mp11::mp_if<
+    mp11::mp_contains<mp11::mp_list<T...>, monostate>,
+    mp11::mp_find<mp11::mp_list<T...>, monostate>,
+    mp11::mp_find_if<mp11::mp_list<T...>, std::is_nothrow_default_constructible>
+>;
+
 // variant_base
 
 template<bool is_trivially_destructible, bool is_single_buffered, class... T> struct variant_base_impl;
-template<class... T> using variant_base = variant_base_impl<mp11::mp_all<std::is_trivially_destructible<T>...>::value, mp11::mp_all<std::is_nothrow_move_constructible<T>...>::value, T...>;
+
+#if defined(BOOST_VARIANT2_ENABLE_NICHE)
+
+// alternatives that hold no data and can live in the storage of another
+
+template<class T> using is_niche_empty = mp11::mp_bool<
+    std::is_empty<T>::value &&
+    std::is_nothrow_default_constructible<T>::value &&
+    std::is_trivially_destructible<T>::value &&
+    is_trivially_copy_constructible<T>::value &&
+    is_trivially_copy_assignable<T>::value
+>;
+
+template<class T> using is_niche_data = mp11::mp_not<is_niche_empty<T>>;
+
+template<class... T> struct is_niche_variant_impl
+{
+    using L = mp11::mp_list<T...>;
+    using K = mp11::mp_find_if<L, is_niche_data>;
+
+    template<class K2> using D = mp11::mp_at<L, K2>;
+
+    template<class K2> using fn = mp11::mp_bool<
+        mp11::mp_count_if<L, is_niche_empty>::value + 1 == sizeof...(T) &&
+        std::is_trivially_destructible<D<K2>>::value &&
+        is_trivially_copy_constructible<D<K2>>::value &&
+        is_trivially_copy_assignable<D<K2>>::value &&
+        ( niche_traits<D<K2>>::count >= sizeof...(T) - 1 )
+    >;
+
+    using type = mp11::mp_eval_if_c<sizeof...(T) < 2 || K::value == sizeof...(T), mp11::mp_false, fn, K>;
+};
+
+template<class... T> using is_niche_variant = typename is_niche_variant_impl<T...>::type;
+
+template<class... T> struct variant_niche_base;
+
+template<class... T> using variant_base = mp11::mp_if<is_niche_variant<T...>,
+    variant_niche_base<T...>,
+    variant_base_impl<mp11::mp_all<std::is_trivially_destructible<T>...>::value, is_single_buffered<T...>::value, T...>>;
+
+#else
+
+template<class... T> using variant_base = variant_base_impl<mp11::mp_all<std::is_trivially_destructible<T>...>::value, is_single_buffered<T...>::value, T...>;
+
+#endif
 
 struct none {};
 
@@ -972,7 +1443,7 @@ template<class... T> struct variant_base_impl<true, true, T...>
     {
     }
 
-    template<class I, class... A> constexpr explicit variant_base_impl( I, A&&... a ): st_( mp11::mp_size_t<I::value + 1>(), std::forward<A>(a)... ), ix_( I::value + 1 )
+    template<class I, class... A> constexpr explicit variant_base_impl( I, A&&... a ): st_( mp11::mp_size_t<I::value + 1>(), std::forward<A>(a)... ), ix_( BOOST_VARIANT2_PROFILE_EXPR( variant<T...>, constructed, I::value, I::value + 1 ) )
     {
     }
 
@@ -983,6 +1454,8 @@ template<class... T> struct variant_base_impl<true, true, T...>
 
         static_assert( I::value + 1 <= (std::numeric_limits<index_type>::max)(), "" );
         ix_ = I::value + 1;
+
+        BOOST_VARIANT2_PROFILE( variant<T...>, constructed, I::value );
     }
 
     constexpr std::size_t index() const noexcept
@@ -1018,7 +1491,7 @@ template<class... T> struct variant_base_impl<true, true, T...>
         ix_ = J;
     }
 
-    template<std::size_t J, class U, class... A> BOOST_CXX14_CONSTEXPR void emplace_impl( mp11::mp_false, A&&... a )
+    template<std::size_t J, class U, class... A> BOOST_CXX14_CONSTEXPR void emplace_move( mp11::mp_true, A&&... a )
     {
         static_assert( std::is_nothrow_move_constructible<U>::value, "Logic error: U must be nothrow move constructible" );
 
@@ -1030,12 +1503,46 @@ template<class... T> struct variant_base_impl<true, true, T...>
         ix_ = J;
     }
 
-    template<std::size_t I, class... A> BOOST_CXX14_CONSTEXPR void emplace( A&&... a )
+    struct _reset_guard
     {
-        std::size_t const J = I+1;
-        using U = mp11::mp_at_c<variant<T...>, I>;
+        variant_base_impl * this_;
+
+        ~_reset_guard()
+        {
+            if( this_ ) this_->_replace( variant_reset_index<T...>() );
+        }
+    };
+
+    template<std::size_t J, class U, class... A> void emplace_move( mp11::mp_false, A&&... a )
+    {
+        static_assert( variant_reset_index<T...>::value < sizeof...(T), "A single buffered variant with an alternative whose move constructor can throw requires monostate or a nothrow default constructible alternative" );
+
+        // the arguments may refer to the current alternative
+        U tmp( std::forward<A>(a)... );
+
+        ix_ = 0;
+
+        _reset_guard g{ this };
+        st_.emplace( mp11::mp_size_t<J>(), std::move(tmp) );
+        g.this_ = 0;
+
+        static_assert( J <= (std::numeric_limits<index_type>::max)(), "" );
+        ix_ = J;
+    }
+
+    template<std::size_t J, class U, class... A> BOOST_CXX14_CONSTEXPR void emplace_impl( mp11::mp_false, A&&... a )
+    {
+        this->emplace_move<J, U>( std::is_nothrow_move_constructible<U>(), std::forward<A>(a)... );
+    }
+
+    template<std::size_t I, class... A> BOOST_CXX14_CONSTEXPR void emplace( A&&... a )
+    {
+        std::size_t const J = I+1;
+        using U = mp11::mp_at_c<variant<T...>, I>;
 
         this->emplace_impl<J, U>( std::is_nothrow_constructible<U, A&&...>(), std::forward<A>(a)... );
+
+        BOOST_VARIANT2_PROFILE( variant<T...>, emplaced, I );
     }
 
     static constexpr bool uses_double_storage() noexcept
@@ -1056,7 +1563,7 @@ template<class... T> struct variant_base_impl<true, false, T...>
     {
     }
 
-    template<class I, class... A> constexpr explicit variant_base_impl( I, A&&... a ): st_{ { mp11::mp_size_t<I::value + 1>(), std::forward<A>(a)... }, { mp11::mp_size_t<0>() } }, ix_( ( I::value + 1 ) * 2 )
+    template<class I, class... A> constexpr explicit variant_base_impl( I, A&&... a ): st_{ { mp11::mp_size_t<I::value + 1>(), std::forward<A>(a)... }, { mp11::mp_size_t<0>() } }, ix_( BOOST_VARIANT2_PROFILE_EXPR( variant<T...>, constructed, I::value, ( I::value + 1 ) * 2 ) )
     {
     }
 
@@ -1067,6 +1574,8 @@ template<class... T> struct variant_base_impl<true, false, T...>
 
         static_assert( ( I::value + 1 ) * 2 <= (std::numeric_limits<index_type>::max)(), "" );
         ix_ = ( I::value + 1 ) * 2;
+
+        BOOST_VARIANT2_PROFILE( variant<T...>, constructed, I::value );
     }
 
     constexpr std::size_t index() const noexcept
@@ -1104,6 +1613,9 @@ template<class... T> struct variant_base_impl<true, false, T...>
 
         static_assert( J * 2 + 1 <= (std::numeric_limits<index_type>::max)(), "" );
         ix_ = static_cast<index_type>( J * 2 + i2 );
+
+        BOOST_VARIANT2_PROFILE( variant<T...>, emplaced, I );
+        BOOST_VARIANT2_PROFILE( variant<T...>, buffer_flips, 0 );
     }
 
     static constexpr bool uses_double_storage() noexcept
@@ -1124,7 +1636,7 @@ template<class... T> struct variant_base_impl<false, true, T...>
     {
     }
 
-    template<class I, class... A> constexpr explicit variant_base_impl( I, A&&... a ): st_( mp11::mp_size_t<I::value + 1>(), std::forward<A>(a)... ), ix_( I::value + 1 )
+    template<class I, class... A> constexpr explicit variant_base_impl( I, A&&... a ): st_( mp11::mp_size_t<I::value + 1>(), std::forward<A>(a)... ), ix_( BOOST_VARIANT2_PROFILE_EXPR( variant<T...>, constructed, I::value, I::value + 1 ) )
     {
     }
 
@@ -1135,6 +1647,8 @@ template<class... T> struct variant_base_impl<false, true, T...>
 
         static_assert( I::value + 1 <= (std::numeric_limits<index_type>::max)(), "" );
         ix_ = I::value + 1;
+
+        BOOST_VARIANT2_PROFILE( variant<T...>, constructed, I::value );
     }
 
     //[&]( auto I ){
@@ -1146,9 +1660,12 @@ template<class... T> struct variant_base_impl<false, true, T...>
     {
         variant_base_impl * this_;
 
+        // I is the index of the alternative; it's stored at I + 1
+
         template<class I> BOOST_CXX14_CONSTEXPR void operator()( I ) const noexcept
         {
-            using U = mp11::mp_at<mp11::mp_list<none, T...>, I>;
+            using J = mp11::mp_size_t<I::value + 1>;
+            using U = mp11::mp_at<mp11::mp_list<none, T...>, J>;
 
 #if defined(BOOST_GCC) && (__GNUC__ >= 12)
 // false positive, see https://github.com/boostorg/variant2/issues/55
@@ -1156,7 +1673,7 @@ template<class... T> struct variant_base_impl<false, true, T...>
 # pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
 #endif
 
-            this_->st_.get( I() ).~U();
+            this_->st_.get( J() ).~U();
 
 #if defined(BOOST_GCC) && (__GNUC__ >= 12)
 # pragma GCC diagnostic pop
@@ -1168,7 +1685,10 @@ template<class... T> struct variant_base_impl<false, true, T...>
     {
         if( ix_ > 0 )
         {
-            mp11::mp_with_index<1 + sizeof...(T)>( ix_, _destroy_L1{ this } );
+            BOOST_VARIANT2_PROFILE( variant<T...>, destroyed, ix_ - 1 );
+            // dispatch on the index of the alternative, so that
+            // the probes of linear_dispatch apply
+            detail::with_index<variant<T...>, sizeof...(T)>( ix_ - 1, _destroy_L1{ this } );
         }
     }
 
@@ -1200,7 +1720,50 @@ template<class... T> struct variant_base_impl<false, true, T...>
         return st_.get( mp11::mp_size_t<I+1>() );
     }
 
+    struct _reset_guard
+    {
+        variant_base_impl * this_;
+
+        ~_reset_guard()
+        {
+            if( this_ ) this_->_replace( variant_reset_index<T...>() );
+        }
+    };
+
+    template<std::size_t J, class... A> void emplace_reset( A&&... a )
+    {
+        static_assert( variant_reset_index<T...>::value < sizeof...(T), "A single buffered variant with an alternative whose move constructor can throw requires monostate or a nothrow default constructible alternative" );
+
+        using U = mp11::mp_at_c<mp11::mp_list<none, T...>, J>;
+
+        // the arguments may refer to the current alternative
+        U tmp( std::forward<A>(a)... );
+
+        _destroy();
+        ix_ = 0;
+
+        _reset_guard g{ this };
+        st_.emplace( mp11::mp_size_t<J>(), std::move(tmp) );
+        g.this_ = 0;
+
+        static_assert( J <= (std::numeric_limits<index_type>::max)(), "" );
+        ix_ = J;
+    }
+
+    template<std::size_t I, class... A> void emplace_impl( mp11::mp_false, A&&... a )
+    {
+        this->emplace_reset<I+1>( std::forward<A>(a)... );
+
+        BOOST_VARIANT2_PROFILE( variant<T...>, emplaced, I );
+    }
+
     template<std::size_t I, class... A> BOOST_CXX14_CONSTEXPR void emplace( A&&... a )
+    {
+        using U = mp11::mp_at_c<variant<T...>, I>;
+        this->emplace_impl<I>( std::is_nothrow_move_constructible<U>(), std::forward<A>(a)... );
+    }
+
+    template<std::size_t I, class... A> BOOST_CXX14_CONSTEXPR void emplace_impl( mp11::mp_true, A&&... a )
     {
         std::size_t const J = I+1;
 
@@ -1226,6 +1789,8 @@ template<class... T> struct variant_base_impl<false, true, T...>
 
         static_assert( J <= (std::numeric_limits<index_type>::max)(), "" );
         ix_ = J;
+
+        BOOST_VARIANT2_PROFILE( variant<T...>, emplaced, I );
     }
 
     static constexpr bool uses_double_storage() noexcept
@@ -1250,7 +1815,7 @@ template<class... T> struct variant_base_impl<false, false, T...>
     {
     }
 
-    template<class I, class... A> constexpr explicit variant_base_impl( I, A&&... a ): st1_( mp11::mp_size_t<I::value + 1>(), std::forward<A>(a)... ), st2_( mp11::mp_size_t<0>() ), ix_( ( I::value + 1 ) * 2 )
+    template<class I, class... A> constexpr explicit variant_base_impl( I, A&&... a ): st1_( mp11::mp_size_t<I::value + 1>(), std::forward<A>(a)... ), st2_( mp11::mp_size_t<0>() ), ix_( BOOST_VARIANT2_PROFILE_EXPR( variant<T...>, constructed, I::value, ( I::value + 1 ) * 2 ) )
     {
     }
 
@@ -1273,7 +1838,7 @@ template<class... T> struct variant_base_impl<false, false, T...>
     {
     }
 
-    template<class I, class... A> constexpr explicit variant_base_impl( I, A&&... a ): st_{ { mp11::mp_size_t<I::value + 1>(), std::forward<A>(a)... }, { mp11::mp_size_t<0>() } }, ix_( ( I::value + 1 ) * 2 )
+    template<class I, class... A> constexpr explicit variant_base_impl( I, A&&... a ): st_{ { mp11::mp_size_t<I::value + 1>(), std::forward<A>(a)... }, { mp11::mp_size_t<0>() } }, ix_( BOOST_VARIANT2_PROFILE_EXPR( variant<T...>, constructed, I::value, ( I::value + 1 ) * 2 ) )
     {
     }
 
@@ -1296,6 +1861,8 @@ template<class... T> struct variant_base_impl<false, false, T...>
 
         static_assert( ( I::value + 1 ) * 2 <= (std::numeric_limits<index_type>::max)(), "" );
         ix_ = ( I::value + 1 ) * 2;
+
+        BOOST_VARIANT2_PROFILE( variant<T...>, constructed, I::value );
     }
 
     //[&]( auto I ){
@@ -1308,16 +1875,26 @@ template<class... T> struct variant_base_impl<false, false, T...>
         variant_base_impl * this_;
         unsigned i2_;
 
+        // I is the index of the alternative; it's stored at I + 1
+
         template<class I> BOOST_CXX14_CONSTEXPR void operator()( I ) const noexcept
         {
-            using U = mp11::mp_at<mp11::mp_list<none, T...>, I>;
-            this_->storage( i2_ ).get( I() ).~U();
+            using J = mp11::mp_size_t<I::value + 1>;
+            using U = mp11::mp_at<mp11::mp_list<none, T...>, J>;
+            this_->storage( i2_ ).get( J() ).~U();
         }
     };
 
     BOOST_CXX14_CONSTEXPR void _destroy() noexcept
     {
-        mp11::mp_with_index<1 + sizeof...(T)>( ix_ / 2, _destroy_L1{ this, static_cast<unsigned>( ix_ & 1 ) } );
+        if( ix_ >= 2 )
+        {
+            BOOST_VARIANT2_PROFILE( variant<T...>, destroyed, ix_ / 2 - 1 );
+
+            // dispatch on the index of the alternative, so that
+            // the probes of linear_dispatch apply
+            detail::with_index<variant<T...>, sizeof...(T)>( ix_ / 2 - 1, _destroy_L1{ this, static_cast<unsigned>( ix_ & 1 ) } );
+        }
     }
 
     BOOST_VARIANT2_CXX20_CONSTEXPR ~variant_base_impl() noexcept
@@ -1361,6 +1938,9 @@ template<class... T> struct variant_base_impl<false, false, T...>
 
         static_assert( J * 2 + 1 <= (std::numeric_limits<index_type>::max)(), "" );
         ix_ = static_cast<index_type>( J * 2 + i2 );
+
+        BOOST_VARIANT2_PROFILE( variant<T...>, emplaced, I );
+        BOOST_VARIANT2_PROFILE( variant<T...>, buffer_flips, 0 );
     }
 
     static constexpr bool uses_double_storage() noexcept
@@ -1369,6 +1949,111 @@ template<class... T> struct variant_base_impl<false, false, T...>
     }
 };
 
+#if defined(BOOST_VARIANT2_ENABLE_NICHE)
+
+// one alternative with spare values, the rest empty; the index is encoded
+// in the spare values, so there is no separate index member
+
+template<class... T> struct variant_niche_base
+{
+    static constexpr std::size_t K = mp11::mp_find_if<mp11::mp_list<T...>, is_niche_data>::value;
+
+    using D = mp11::mp_at_c<mp11::mp_list<T...>, K>;
+
+    alignas( D ) unsigned char st_[ sizeof( D ) ];
+
+    variant_niche_base() noexcept
+    {
+    }
+
+    template<class I, class... A> explicit variant_niche_base( I, A&&... a )
+    {
+        _replace( I(), std::forward<A>(a)... );
+    }
+
+    template<std::size_t I, class... A> void _construct( mp11::mp_true, A&&... a )
+    {
+        ::new( static_cast<void*>( st_ ) ) D( std::forward<A>(a)... );
+    }
+
+    template<std::size_t I, class... A> void _construct( mp11::mp_false, A&&... a )
+    {
+        using U = mp11::mp_at_c<variant<T...>, I>;
+
+        ::new( static_cast<void*>( st_ ) ) U( std::forward<A>(a)... );
+        niche_traits<D>::store( st_, I < K? I: I - 1 );
+    }
+
+    // requires: no alternative has been constructed
+    template<class I, class... A> void _replace( I, A&&... a )
+    {
+        this->_construct<I::value>( mp11::mp_bool<I::value == K>(), std::forward<A>(a)... );
+
+        BOOST_VARIANT2_PROFILE( variant<T...>, constructed, I::value );
+    }
+
+    std::size_t index() const noexcept
+    {
+        std::size_t n = niche_traits<D>::load( st_ );
+        return n >= sizeof...(T) - 1? K: n < K? n: n + 1;
+    }
+
+    template<std::size_t I> mp11::mp_at_c<variant<T...>, I>& _get_impl( mp11::mp_size_t<I> ) noexcept
+    {
+        BOOST_ASSERT( index() == I );
+
+        using U = mp11::mp_at_c<variant<T...>, I>;
+
+#if defined(__cpp_lib_launder) && __cpp_lib_launder >= 201606L
+        return *std::launder( reinterpret_cast<U*>( st_ ) );
+#else
+        return *reinterpret_cast<U*>( st_ );
+#endif
+    }
+
+    template<std::size_t I> mp11::mp_at_c<variant<T...>, I> const& _get_impl( mp11::mp_size_t<I> ) const noexcept
+    {
+        BOOST_ASSERT( index() == I );
+
+        using U = mp11::mp_at_c<variant<T...>, I>;
+
+#if defined(__cpp_lib_launder) && __cpp_lib_launder >= 201606L
+        return *std::launder( reinterpret_cast<U const*>( st_ ) );
+#else
+        return *reinterpret_cast<U const*>( st_ );
+#endif
+    }
+
+    template<std::size_t I, class... A> void emplace_impl( mp11::mp_true, A&&... a )
+    {
+        this->_construct<I>( mp11::mp_bool<I == K>(), std::forward<A>(a)... );
+    }
+
+    template<std::size_t I, class... A> void emplace_impl( mp11::mp_false, A&&... a )
+    {
+        using U = mp11::mp_at_c<variant<T...>, I>;
+
+        U tmp( std::forward<A>(a)... );
+        this->_construct<I>( mp11::mp_bool<I == K>(), std::move( tmp ) );
+    }
+
+    template<std::size_t I, class... A> void emplace( A&&... a )
+    {
+        using U = mp11::mp_at_c<variant<T...>, I>;
+
+        this->emplace_impl<I>( std::is_nothrow_constructible<U, A&&...>(), std::forward<A>(a)... );
+
+        BOOST_VARIANT2_PROFILE( variant<T...>, emplaced, I );
+    }
+
+    static constexpr bool uses_double_storage() noexcept
+    {
+        return false;
+    }
+};
+
+#endif
+
 } // namespace detail
 
 // in_place_type_t
@@ -1523,7 +2208,7 @@ public:
         noexcept( mp11::mp_all<std::is_nothrow_copy_constructible<T>...>::value )
         : variant_base()
     {
-        mp11::mp_with_index<sizeof...(T)>( r.index(), L1{ this, r } );
+        detail::with_index<variant<T...>, sizeof...(T)>( r.index(), L1{ this, r } );
     }
 
     // move constructor
@@ -1602,7 +2287,7 @@ public:
     BOOST_CXX14_CONSTEXPR variant_ca_base_impl& operator=( variant_ca_base_impl const & r )
         noexcept( mp11::mp_all<std::is_nothrow_copy_constructible<T>...>::value )
     {
-        mp11::mp_with_index<sizeof...(T)>( r.index(), L3{ this, r } );
+        detail::with_index<variant<T...>, sizeof...(T)>( r.index(), L3{ this, r } );
         return *this;
     }
 
@@ -1676,7 +2361,7 @@ public:
     BOOST_CXX14_CONSTEXPR variant_mc_base_impl( variant_mc_base_impl && r )
         noexcept( mp11::mp_all<std::is_nothrow_move_constructible<T>...>::value )
     {
-        mp11::mp_with_index<sizeof...(T)>( r.index(), L2{ this, r } );
+        detail::with_index<variant<T...>, sizeof...(T)>( r.index(), L2{ this, r } );
     }
 
     // assignment
@@ -1755,13 +2440,82 @@ public:
     BOOST_CXX14_CONSTEXPR variant_ma_base_impl& operator=( variant_ma_base_impl && r )
         noexcept( mp11::mp_all<std::is_nothrow_move_constructible<T>...>::value )
     {
-        mp11::mp_with_index<sizeof...(T)>( r.index(), L4{ this, r } );
+        detail::with_index<variant<T...>, sizeof...(T)>( r.index(), L4{ this, r } );
         return *this;
     }
 };
 
 } // namespace detail
 
+// uses-allocator construction
+
+namespace detail
+{
+
+// 0: the allocator is not used; 1: leading allocator_arg_t convention;
+// 2: trailing allocator convention; 3: not constructible with an allocator
+
+template<class U, class Al, class... A> using uses_alloc_kind = mp11::mp_cond<
+    mp11::mp_not< std::uses_allocator<U, Al> >, mp11::mp_size_t<0>,
+    std::is_constructible<U, std::allocator_arg_t, Al const&, A...>, mp11::mp_size_t<1>,
+    std::is_constructible<U, A..., Al const&>, mp11::mp_size_t<2>,
+    mp11::mp_true, mp11::mp_size_t<3>
+>;
+
+template<class U, class Al, class... A> using is_uses_alloc_constructible = mp11::mp_bool<
+    uses_alloc_kind<U, Al, A...>::value == 0? std::is_constructible<U, A...>::value: uses_alloc_kind<U, Al, A...>::value != 3
+>;
+
+template<class U, class Al, class... A> using is_nothrow_uses_alloc_constructible = mp11::mp_at<mp11::mp_list<
+    std::is_nothrow_constructible<U, A...>,
+    std::is_nothrow_constructible<U, std::allocator_arg_t, Al const&, A...>,
+    std::is_nothrow_constructible<U, A..., Al const&>,
+    mp11::mp_false
+>, uses_alloc_kind<U, Al, A...>>;
+
+template<class F, class Al, class... A> void uses_alloc_construct_impl( mp11::mp_size_t<0>, F const& f, Al const& /*al*/, A&&... a )
+{
+    f( std::forward<A>(a)... );
+}
+
+template<class F, class Al, class... A> void uses_alloc_construct_impl( mp11::mp_size_t<1>, F const& f, Al const& al, A&&... a )
+{
+    f( std::allocator_arg, al, std::forward<A>(a)... );
+}
+
+template<class F, class Al, class... A> void uses_alloc_construct_impl( mp11::mp_size_t<2>, F const& f, Al const& al, A&&... a )
+{
+    f( std::forward<A>(a)..., al );
+}
+
+// calls f with the arguments for the uses-allocator construction of U
+template<class U, class F, class Al, class... A> void uses_alloc_construct( F const& f, Al const& al, A&&... a )
+{
+    detail::uses_alloc_construct_impl( uses_alloc_kind<U, Al, A&&...>(), f, al, std::forward<A>(a)... );
+}
+
+template<class B, class I> struct uses_alloc_replace_L
+{
+    B * this_;
+
+    template<class... A> void operator()( A&&... a ) const
+    {
+        this_->_replace( I(), std::forward<A>(a)... );
+    }
+};
+
+template<class B, std::size_t I> struct uses_alloc_emplace_L
+{
+    B * this_;
+
+    template<class... A> void operator()( A&&... a ) const
+    {
+        this_->template emplace<I>( std::forward<A>(a)... );
+    }
+};
+
+} // namespace detail
+
 // variant
 
 template<class... T> class variant: private detail::variant_ma_base<T...>
@@ -1878,6 +2632,72 @@ public:
         return _get_impl( mp11::mp_size_t<I>() );
     }
 
+    // assign_same_or_emplace (extension)
+
+private:
+
+    template<std::size_t I, class X> BOOST_CXX14_CONSTEXPR void _assign_same_or_emplace( mp11::mp_size_t<I> i, X&& x )
+    {
+        if( variant_base::index() == I )
+        {
+            // reuses the storage, and the capacity, of the contained value
+            variant_base::_get_impl( i ) = std::forward<X>(x);
+        }
+        else
+        {
+            variant_base::template emplace<I>( std::forward<X>(x) );
+        }
+    }
+
+    struct L14
+    {
+        variant * this_;
+        variant const & r;
+
+        template<class I> BOOST_CXX14_CONSTEXPR void operator()( I i ) const
+        {
+            this_->_assign_same_or_emplace( i, r._get_impl( i ) );
+        }
+    };
+
+    struct L15
+    {
+        variant * this_;
+        variant & r;
+
+        template<class I> BOOST_CXX14_CONSTEXPR void operator()( I i ) const
+        {
+            this_->_assign_same_or_emplace( i, std::move( r._get_impl( i ) ) );
+        }
+    };
+
+public:
+
+    template<class U,
+        class E1 = typename std::enable_if<!std::is_same<typename std::decay<U>::type, variant>::value>::type,
+        class V = detail::resolve_overload_type<U, T...>,
+        class E2 = typename std::enable_if<std::is_assignable<V&, U&&>::value && std::is_constructible<V, U&&>::value>::type
+    >
+    BOOST_CXX14_CONSTEXPR variant& assign_same_or_emplace( U&& u )
+    {
+        this->_assign_same_or_emplace( detail::resolve_overload_index<U, T...>(), std::forward<U>(u) );
+        return *this;
+    }
+
+    template<class E1 = void, class E2 = mp11::mp_if<mp11::mp_all<std::is_copy_constructible<T>..., std::is_copy_assignable<T>...>, E1>>
+    BOOST_CXX14_CONSTEXPR variant& assign_same_or_emplace( variant const& r )
+    {
+        detail::with_index<variant<T...>, sizeof...(T)>( r.index(), L14{ this, r } );
+        return *this;
+    }
+
+    template<class E1 = void, class E2 = mp11::mp_if<mp11::mp_all<std::is_move_constructible<T>..., std::is_move_assignable<T>...>, E1>>
+    BOOST_CXX14_CONSTEXPR variant& assign_same_or_emplace( variant&& r )
+    {
+        detail::with_index<variant<T...>, sizeof...(T)>( r.index(), L15{ this, r } );
+        return *this;
+    }
+
     // value status
 
     constexpr bool valueless_by_exception() const noexcept
@@ -1911,7 +2731,7 @@ public:
     {
         if( index() == r.index() )
         {
-            mp11::mp_with_index<sizeof...(T)>( index(), L5{ this, r } );
+            detail::with_index<variant<T...>, sizeof...(T)>( index(), L5{ this, r } );
         }
         else
         {
@@ -1948,7 +2768,7 @@ public:
     BOOST_CXX14_CONSTEXPR variant( variant<U...> const& r )
         noexcept( mp11::mp_all<std::is_nothrow_copy_constructible<U>...>::value )
     {
-        mp11::mp_with_index<sizeof...(U)>( r.index(), L6<U...>{ this, r } );
+        detail::with_index<variant<U...>, sizeof...(U)>( r.index(), L6<U...>{ this, r } );
     }
 
 private:
@@ -1972,7 +2792,96 @@ public:
     BOOST_CXX14_CONSTEXPR variant( variant<U...> && r )
         noexcept( mp11::mp_all<std::is_nothrow_move_constructible<U>...>::value )
     {
-        mp11::mp_with_index<sizeof...(U)>( r.index(), L7<U...>{ this, r } );
+        detail::with_index<variant<U...>, sizeof...(U)>( r.index(), L7<U...>{ this, r } );
+    }
+
+    // allocator-extended constructors (extension)
+
+private:
+
+    template<class Al> struct L12
+    {
+        variant_base * this_;
+        Al const & al;
+        variant const & r;
+
+        template<class I> void operator()( I i ) const
+        {
+            detail::uses_alloc_construct< mp11::mp_at<variant<T...>, I> >( detail::uses_alloc_replace_L<variant_base, I>{ this_ }, al, r._get_impl( i ) );
+        }
+    };
+
+    template<class Al> struct L13
+    {
+        variant_base * this_;
+        Al const & al;
+        variant & r;
+
+        template<class I> void operator()( I i ) const
+        {
+            detail::uses_alloc_construct< mp11::mp_at<variant<T...>, I> >( detail::uses_alloc_replace_L<variant_base, I>{ this_ }, al, std::move( r._get_impl( i ) ) );
+        }
+    };
+
+public:
+
+    template<class Al, class E = typename std::enable_if< detail::is_uses_alloc_constructible<mp11::mp_first<variant<T...>>, Al>::value >::type>
+    variant( std::allocator_arg_t, Al const& al )
+    {
+        detail::uses_alloc_construct< mp11::mp_first<variant<T...>> >( detail::uses_alloc_replace_L<variant_base, mp11::mp_size_t<0>>{ this }, al );
+    }
+
+    template<class Al, class E = typename std::enable_if< mp11::mp_all<detail::is_uses_alloc_constructible<T, Al, T const&>...>::value >::type>
+    variant( std::allocator_arg_t, Al const& al, variant const& r )
+    {
+        detail::with_index<variant<T...>, sizeof...(T)>( r.index(), L12<Al>{ this, al, r } );
+    }
+
+    template<class Al, class E = typename std::enable_if< mp11::mp_all<detail::is_uses_alloc_constructible<T, Al, T&&>...>::value >::type>
+    variant( std::allocator_arg_t, Al const& al, variant&& r )
+    {
+        detail::with_index<variant<T...>, sizeof...(T)>( r.index(), L13<Al>{ this, al, r } );
+    }
+
+    template<class Al, class U,
+        class Ud = typename std::decay<U>::type,
+        class E1 = typename std::enable_if< !std::is_same<Ud, variant>::value && !std::is_base_of<variant, Ud>::value && !detail::is_in_place_index<Ud>::value && !detail::is_in_place_type<Ud>::value >::type,
+        class V = detail::resolve_overload_type<U&&, T...>,
+        class E2 = typename std::enable_if< detail::is_uses_alloc_constructible<V, Al, U&&>::value >::type
+        >
+    variant( std::allocator_arg_t, Al const& al, U&& u )
+    {
+        detail::uses_alloc_construct<V>( detail::uses_alloc_replace_L<variant_base, detail::resolve_overload_index<U&&, T...>>{ this }, al, std::forward<U>(u) );
+    }
+
+    template<class Al, class U, class... A, class I = mp11::mp_find<variant<T...>, U>, class E = typename std::enable_if< detail::is_uses_alloc_constructible<U, Al, A&&...>::value >::type>
+    variant( std::allocator_arg_t, Al const& al, in_place_type_t<U>, A&&... a )
+    {
+        detail::uses_alloc_construct<U>( detail::uses_alloc_replace_L<variant_base, I>{ this }, al, std::forward<A>(a)... );
+    }
+
+    template<class Al, std::size_t I, class... A, class E = typename std::enable_if< detail::is_uses_alloc_constructible<mp11::mp_at_c<variant<T...>, I>, Al, A&&...>::value >::type>
+    variant( std::allocator_arg_t, Al const& al, in_place_index_t<I>, A&&... a )
+    {
+        detail::uses_alloc_construct< mp11::mp_at_c<variant<T...>, I> >( detail::uses_alloc_replace_L<variant_base, mp11::mp_size_t<I>>{ this }, al, std::forward<A>(a)... );
+    }
+
+    // allocator-extended emplace (extension)
+
+    template<class U, class Al, class... A,
+        class E = typename std::enable_if< mp11::mp_count<variant<T...>, U>::value == 1 && detail::is_uses_alloc_constructible<U, Al, A&&...>::value >::type>
+    U& emplace( std::allocator_arg_t, Al const& al, A&&... a )
+    {
+        using I = mp11::mp_find<variant<T...>, U>;
+        detail::uses_alloc_construct<U>( detail::uses_alloc_emplace_L<variant_base, I::value>{ this }, al, std::forward<A>(a)... );
+        return _get_impl( I() );
+    }
+
+    template<std::size_t I, class Al, class... A, class E = typename std::enable_if< detail::is_uses_alloc_constructible<mp11::mp_at_c<variant<T...>, I>, Al, A&&...>::value >::type>
+    variant_alternative_t<I, variant<T...>>& emplace( std::allocator_arg_t, Al const& al, A&&... a )
+    {
+        detail::uses_alloc_construct< mp11::mp_at_c<variant<T...>, I> >( detail::uses_alloc_emplace_L<variant_base, I>{ this }, al, std::forward<A>(a)... );
+        return _get_impl( mp11::mp_size_t<I>() );
     }
 
     // subset (extension)
@@ -2008,7 +2917,7 @@ public:
         class E2 = mp11::mp_if<mp11::mp_all<std::is_copy_constructible<U>..., mp11::mp_contains<mp11::mp_list<T...>, U>...>, void> >
     BOOST_CXX14_CONSTEXPR variant<U...> subset() &
     {
-        return mp11::mp_with_index<sizeof...(T)>( index(), L8<U...>{ this } );
+        return detail::with_index<variant<T...>, sizeof...(T)>( index(), L8<U...>{ this } );
     }
 
 private:
@@ -2030,7 +2939,7 @@ public:
         class E2 = mp11::mp_if<mp11::mp_all<std::is_copy_constructible<U>..., mp11::mp_contains<mp11::mp_list<T...>, U>...>, void> >
     constexpr variant<U...> subset() const&
     {
-        return mp11::mp_with_index<sizeof...(T)>( index(), L9<U...>{ this } );
+        return detail::with_index<variant<T...>, sizeof...(T)>( index(), L9<U...>{ this } );
     }
 
 private:
@@ -2052,7 +2961,7 @@ public:
         class E2 = mp11::mp_if<mp11::mp_all<std::is_copy_constructible<U>..., mp11::mp_contains<mp11::mp_list<T...>, U>...>, void> >
     BOOST_CXX14_CONSTEXPR variant<U...> subset() &&
     {
-        return mp11::mp_with_index<sizeof...(T)>( index(), L10<U...>{ this } );
+        return detail::with_index<variant<T...>, sizeof...(T)>( index(), L10<U...>{ this } );
     }
 
 #if !BOOST_WORKAROUND(BOOST_GCC, < 40900)
@@ -2078,12 +2987,116 @@ public:
         class E2 = mp11::mp_if<mp11::mp_all<std::is_copy_constructible<U>..., mp11::mp_contains<mp11::mp_list<T...>, U>...>, void> >
     constexpr variant<U...> subset() const&&
     {
-        return mp11::mp_with_index<sizeof...(T)>( index(), L11<U...>{ this } );
+        return detail::with_index<variant<T...>, sizeof...(T)>( index(), L11<U...>{ this } );
     }
 
 #endif
 };
 
+// variant_layout_info
+
+namespace detail
+{
+
+#if defined(BOOST_VARIANT2_ENABLE_NICHE)
+
+template<class... T> using uses_niche_layout = is_niche_variant<T...>;
+
+#else
+
+template<class... T> using uses_niche_layout = mp11::mp_false;
+
+#endif
+
+template<class... T> struct variant_layout_info_impl
+{
+    static constexpr bool niche = uses_niche_layout<T...>::value;
+    static constexpr bool double_storage = variant<T...>::uses_double_storage();
+
+    static constexpr std::size_t storage_size = niche? mp11::mp_max_element<mp11::mp_list<mp11::mp_size_t<sizeof(T)>...>, mp11::mp_less>::value: ( double_storage? 2: 1 ) * sizeof( variant_storage<none, T...> );
+    static constexpr std::size_t index_size = niche? 0: sizeof( get_index_type<double_storage, T...> );
+};
+
+} // namespace detail
+
+template<class V> struct variant_layout_info;
+
+template<class... T> struct variant_layout_info<variant<T...>>
+{
+private:
+
+    using impl = detail::variant_layout_info_impl<T...>;
+
+    static constexpr std::size_t sizes_[] = { sizeof(T)... };
+    static constexpr std::size_t alignments_[] = { alignof(T)... };
+
+public:
+
+    static constexpr std::size_t alternatives = sizeof...(T);
+
+    static constexpr std::size_t size = sizeof( variant<T...> );
+    static constexpr std::size_t alignment = alignof( variant<T...> );
+
+    // size and alignment of the largest alternative
+    static constexpr std::size_t max_alternative_size = mp11::mp_max_element<mp11::mp_list<mp11::mp_size_t<sizeof(T)>...>, mp11::mp_less>::value;
+    static constexpr std::size_t max_alternative_alignment = mp11::mp_max_element<mp11::mp_list<mp11::mp_size_t<alignof(T)>...>, mp11::mp_less>::value;
+
+    static constexpr bool uses_double_storage = impl::double_storage;
+    static constexpr bool uses_niche = impl::niche;
+
+    // bytes taken by the alternative storage, one or two buffers
+    static constexpr std::size_t storage_size = impl::storage_size;
+
+    // width of the index in bytes, 0 when it's kept in the niche of an alternative
+    static constexpr std::size_t index_size = impl::index_size;
+
+    static constexpr std::size_t padding = size - storage_size - index_size;
+
+    // bytes on top of the largest alternative
+    static constexpr std::size_t overhead = size - max_alternative_size;
+
+    static constexpr std::size_t alternative_size( std::size_t i ) noexcept
+    {
+        return sizes_[ i ];
+    }
+
+    static constexpr std::size_t alternative_alignment( std::size_t i ) noexcept
+    {
+        return alignments_[ i ];
+    }
+};
+
+template<class... T> constexpr std::size_t variant_layout_info<variant<T...>>::sizes_[];
+template<class... T> constexpr std::size_t variant_layout_info<variant<T...>>::alignments_[];
+
+#if defined(BOOST_NO_CXX17_INLINE_VARIABLES)
+
+template<class... T> constexpr std::size_t variant_layout_info<variant<T...>>::alternatives;
+template<class... T> constexpr std::size_t variant_layout_info<variant<T...>>::size;
+template<class... T> constexpr std::size_t variant_layout_info<variant<T...>>::alignment;
+template<class... T> constexpr std::size_t variant_layout_info<variant<T...>>::max_alternative_size;
+template<class... T> constexpr std::size_t variant_layout_info<variant<T...>>::max_alternative_alignment;
+template<class... T> constexpr bool variant_layout_info<variant<T...>>::uses_double_storage;
+template<class... T> constexpr bool variant_layout_info<variant<T...>>::uses_niche;
+template<class... T> constexpr std::size_t variant_layout_info<variant<T...>>::storage_size;
+template<class... T> constexpr std::size_t variant_layout_info<variant<T...>>::index_size;
+template<class... T> constexpr std::size_t variant_layout_info<variant<T...>>::padding;
+template<class... T> constexpr std::size_t variant_layout_info<variant<T...>>::overhead;
+
+#endif
+
+template<class V> struct variant_layout_info<V const>: variant_layout_info<V>
+{
+};
+
+// variant_size_budget
+
+template<class V, std::size_t Budget, std::size_t Size = sizeof(V)> struct variant_size_budget
+{
+    static_assert( Size <= Budget, "The variant exceeds its size budget; Size is the actual size and Budget the limit" );
+    static constexpr bool value = true;
+};
+
 // relational operators
 
 namespace detail
@@ -2104,7 +3117,7 @@ template<class... T> struct eq_L
 
 template<class... T> constexpr bool operator==( variant<T...> const & v, variant<T...> const & w )
 {
-    return v.index() == w.index() && mp11::mp_with_index<sizeof...(T)>( v.index(), detail::eq_L<T...>{ v, w } );
+    return v.index() == w.index() && detail::with_index<variant<T...>, sizeof...(T)>( v.index(), detail::eq_L<T...>{ v, w } );
 }
 
 namespace detail
@@ -2125,7 +3138,7 @@ template<class... T> struct ne_L
 
 template<class... T> constexpr bool operator!=( variant<T...> const & v, variant<T...> const & w )
 {
-    return v.index() != w.index() || mp11::mp_with_index<sizeof...(T)>( v.index(), detail::ne_L<T...>{ v, w } );
+    return v.index() != w.index() || detail::with_index<variant<T...>, sizeof...(T)>( v.index(), detail::ne_L<T...>{ v, w } );
 }
 
 namespace detail
@@ -2146,7 +3159,7 @@ template<class... T> struct lt_L
 
 template<class... T> constexpr bool operator<( variant<T...> const & v, variant<T...> const & w )
 {
-    return v.index() < w.index() || ( v.index() == w.index() && mp11::mp_with_index<sizeof...(T)>( v.index(), detail::lt_L<T...>{ v, w } ) );
+    return v.index() < w.index() || ( v.index() == w.index() && detail::with_index<variant<T...>, sizeof...(T)>( v.index(), detail::lt_L<T...>{ v, w } ) );
 }
 
 template<class... T> constexpr bool operator>(  variant<T...> const & v, variant<T...> const & w )
@@ -2172,7 +3185,7 @@ template<class... T> struct le_L
 
 template<class... T> constexpr bool operator<=( variant<T...> const & v, variant<T...> const & w )
 {
-    return v.index() < w.index() || ( v.index() == w.index() && mp11::mp_with_index<sizeof...(T)>( v.index(), detail::le_L<T...>{ v, w } ) );
+    return v.index() < w.index() || ( v.index() == w.index() && detail::with_index<variant<T...>, sizeof...(T)>( v.index(), detail::le_L<T...>{ v, w } ) );
 }
 
 template<class... T> constexpr bool operator>=( variant<T...> const & v, variant<T...> const & w )
@@ -2280,7 +3293,7 @@ template<class R, class F, class V1> struct visit_L1
 
     template<class I> constexpr auto operator()( I ) const -> Vret<R, F, V1>
     {
-        return std::forward<F>(f)( unsafe_get<I::value>( std::forward<V1>(v1) ) );
+        return BOOST_VARIANT2_PROFILE_EXPR( extract_variant_base<V1>, visited, I::value, std::forward<F>(f)( unsafe_get<I::value>( std::forward<V1>(v1) ) ) );
     }
 };
 
@@ -2288,9 +3301,120 @@ template<class R, class F, class V1> struct visit_L1
 
 template<class R = detail::deduced, class F, class V1> constexpr auto visit( F&& f, V1&& v1 ) -> detail::Vret<R, F, V1>
 {
-    return mp11::mp_with_index<detail::variant_base_size<V1>>( v1.index(), detail::visit_L1<R, F, V1>{ std::forward<F>(f), std::forward<V1>(v1) } );
+    return detail::with_index<detail::extract_variant_base<V1>, detail::variant_base_size<V1>::value>( v1.index(), detail::visit_L1<R, F, V1>{ std::forward<F>(f), std::forward<V1>(v1) } );
+}
+
+// visit_likely
+
+namespace detail
+{
+
+template<class R, class F, class V1, std::size_t... I> struct visit_likely_impl;
+
+template<class R, class F, class V1> struct visit_likely_impl<R, F, V1>
+{
+    static constexpr Vret<R, F, V1> call( std::size_t ix, visit_L1<R, F, V1> const& L )
+    {
+        return with_index<extract_variant_base<V1>, variant_base_size<V1>::value>( ix, L );
+    }
+};
+
+template<class R, class F, class V1, std::size_t I, std::size_t... J> struct visit_likely_impl<R, F, V1, I, J...>
+{
+    static_assert( I < variant_base_size<V1>::value, "Index out of bounds" );
+
+    static constexpr Vret<R, F, V1> call( std::size_t ix, visit_L1<R, F, V1> const& L )
+    {
+        return BOOST_LIKELY( ix == I )? L( mp11::mp_size_t<I>() ): visit_likely_impl<R, F, V1, J...>::call( ix, L );
+    }
+};
+
+} // namespace detail
+
+template<std::size_t... I, class F, class V1> constexpr auto visit_likely( F&& f, V1&& v1 ) -> detail::Vret<detail::deduced, F, V1>
+{
+    return detail::visit_likely_impl<detail::deduced, F, V1, I...>::call( v1.index(), detail::visit_L1<detail::deduced, F, V1>{ std::forward<F>(f), std::forward<V1>(v1) } );
 }
 
+template<class R, std::size_t... I, class F, class V1> constexpr auto visit_likely( F&& f, V1&& v1 ) -> detail::Vret<R, F, V1>
+{
+    return detail::visit_likely_impl<R, F, V1, I...>::call( v1.index(), detail::visit_L1<R, F, V1>{ std::forward<F>(f), std::forward<V1>(v1) } );
+}
+
+namespace detail
+{
+
+// mp_with_index switches directly on up to 16 indices; with_index_flat
+// extends the single switch to 64
+
+template<std::size_t N, bool E = ( N > 16 )> struct with_index_flat_impl
+{
+    template<class F> static BOOST_CXX14_CONSTEXPR decltype(std::declval<F>()(std::declval<mp11::mp_size_t<0>>())) call( std::size_t i, F&& f )
+    {
+        return mp11::mp_with_index<N>( i, std::forward<F>(f) );
+    }
+};
+
+#define BOOST_VARIANT2_FLAT_CASE(k) case k: return std::forward<F>(f)( mp11::mp_size_t<( k < N? k: 0 )>() );
+#define BOOST_VARIANT2_FLAT_CASE8(k) BOOST_VARIANT2_FLAT_CASE(k) BOOST_VARIANT2_FLAT_CASE(k+1) BOOST_VARIANT2_FLAT_CASE(k+2) BOOST_VARIANT2_FLAT_CASE(k+3) \
+    BOOST_VARIANT2_FLAT_CASE(k+4) BOOST_VARIANT2_FLAT_CASE(k+5) BOOST_VARIANT2_FLAT_CASE(k+6) BOOST_VARIANT2_FLAT_CASE(k+7)
+
+template<std::size_t N> struct with_index_flat_impl<N, true>
+{
+    template<class F> static BOOST_CXX14_CONSTEXPR decltype(std::declval<F>()(std::declval<mp11::mp_size_t<0>>())) call( std::size_t i, F&& f )
+    {
+        switch( i )
+        {
+        default:
+        BOOST_VARIANT2_FLAT_CASE8(0)
+        BOOST_VARIANT2_FLAT_CASE8(8)
+        BOOST_VARIANT2_FLAT_CASE8(16)
+        BOOST_VARIANT2_FLAT_CASE8(24)
+        BOOST_VARIANT2_FLAT_CASE8(32)
+        BOOST_VARIANT2_FLAT_CASE8(40)
+        BOOST_VARIANT2_FLAT_CASE8(48)
+        BOOST_VARIANT2_FLAT_CASE8(56)
+        }
+    }
+};
+
+#undef BOOST_VARIANT2_FLAT_CASE8
+#undef BOOST_VARIANT2_FLAT_CASE
+
+template<std::size_t N, class F> BOOST_CXX14_CONSTEXPR decltype(std::declval<F>()(std::declval<mp11::mp_size_t<0>>())) with_index_flat( std::size_t i, F&& f )
+{
+    static_assert( N <= 64, "with_index_flat supports up to 64 indices" );
+
+    BOOST_VARIANT2_CX14_ASSERT( i < N )
+    return with_index_flat_impl<N>::call( i, std::forward<F>(f) );
+}
+
+static_assert( BOOST_VARIANT2_MAX_FLAT_VISIT <= 64, "BOOST_VARIANT2_MAX_FLAT_VISIT must not exceed 64" );
+
+template<class V1, class V2> using is_flat_visit = mp11::mp_bool< variant_base_size<V1>::value * variant_base_size<V2>::value <= BOOST_VARIANT2_MAX_FLAT_VISIT >;
+
+template<class R, class F, class V1, class V2> struct visit_flat_L2
+{
+    F&& f;
+
+    V1&& v1;
+    V2&& v2;
+
+    template<class I> constexpr auto operator()( I ) const -> Vret<R, F, V1, V2>
+    {
+        return BOOST_VARIANT2_PROFILE_EXPR( extract_variant_base<V1>, visited, I::value / variant_base_size<V2>::value,
+            BOOST_VARIANT2_PROFILE_EXPR( extract_variant_base<V2>, visited, I::value % variant_base_size<V2>::value,
+            std::forward<F>(f)( unsafe_get<I::value / variant_base_size<V2>::value>( std::forward<V1>(v1) ), unsafe_get<I::value % variant_base_size<V2>::value>( std::forward<V2>(v2) ) ) ) );
+    }
+};
+
+template<class R, class F, class V1, class V2> constexpr auto visit_2( mp11::mp_true, F&& f, V1&& v1, V2&& v2 ) -> Vret<R, F, V1, V2>
+{
+    return with_index_flat<variant_base_size<V1>::value * variant_base_size<V2>::value>( v1.index() * variant_base_size<V2>::value + v2.index(), visit_flat_L2<R, F, V1, V2>{ std::forward<F>(f), std::forward<V1>(v1), std::forward<V2>(v2) } );
+}
+
+} // namespace detail
+
 #if defined(BOOST_NO_CXX14_GENERIC_LAMBDAS) || BOOST_WORKAROUND( BOOST_MSVC, < 1920 )
 
 namespace detail
@@ -2321,6 +3445,8 @@ template<class R, class F, class V1, class V2> struct visit_L2
 
     template<class I> auto operator()( I ) const -> Vret<R, F, V1, V2>
     {
+        BOOST_VARIANT2_PROFILE( extract_variant_base<V1>, visited, I::value );
+
         auto f2 = bind_front( std::forward<F>(f), unsafe_get<I::value>( std::forward<V1>(v1) ) );
         return visit<R>( f2, std::forward<V2>(v2) );
     }
@@ -2328,9 +3454,19 @@ template<class R, class F, class V1, class V2> struct visit_L2
 
 } // namespace detail
 
+namespace detail
+{
+
+template<class R, class F, class V1, class V2> constexpr auto visit_2( mp11::mp_false, F&& f, V1&& v1, V2&& v2 ) -> Vret<R, F, V1, V2>
+{
+    return with_index<extract_variant_base<V1>, variant_base_size<V1>::value>( v1.index(), visit_L2<R, F, V1, V2>{ std::forward<F>(f), std::forward<V1>(v1), std::forward<V2>(v2) } );
+}
+
+} // namespace detail
+
 template<class R = detail::deduced, class F, class V1, class V2> constexpr auto visit( F&& f, V1&& v1, V2&& v2 ) -> detail::Vret<R, F, V1, V2>
 {
-    return mp11::mp_with_index<detail::variant_base_size<V1>>( v1.index(), detail::visit_L2<R, F, V1, V2>{ std::forward<F>(f), std::forward<V1>(v1), std::forward<V2>(v2) } );
+    return detail::visit_2<R>( detail::is_flat_visit<V1, V2>(), std::forward<F>(f), std::forward<V1>(v1), std::forward<V2>(v2) );
 }
 
 namespace detail
@@ -2346,6 +3482,8 @@ template<class R, class F, class V1, class V2, class V3> struct visit_L3
 
     template<class I> auto operator()( I ) const -> Vret<R, F, V1, V2, V3>
     {
+        BOOST_VARIANT2_PROFILE( extract_variant_base<V1>, visited, I::value );
+
         auto f2 = bind_front( std::forward<F>(f), unsafe_get<I::value>( std::forward<V1>(v1) ) );
         return visit<R>( f2, std::forward<V2>(v2), std::forward<V3>(v3) );
     }
@@ -2355,7 +3493,7 @@ template<class R, class F, class V1, class V2, class V3> struct visit_L3
 
 template<class R = detail::deduced, class F, class V1, class V2, class V3> constexpr auto visit( F&& f, V1&& v1, V2&& v2, V3&& v3 ) -> detail::Vret<R, F, V1, V2, V3>
 {
-    return mp11::mp_with_index<detail::variant_base_size<V1>>( v1.index(), detail::visit_L3<R, F, V1, V2, V3>{ std::forward<F>(f), std::forward<V1>(v1), std::forward<V2>(v2), std::forward<V3>(v3) } );
+    return detail::with_index<detail::extract_variant_base<V1>, detail::variant_base_size<V1>::value>( v1.index(), detail::visit_L3<R, F, V1, V2, V3>{ std::forward<F>(f), std::forward<V1>(v1), std::forward<V2>(v2), std::forward<V3>(v3) } );
 }
 
 namespace detail
@@ -2372,6 +3510,8 @@ template<class R, class F, class V1, class V2, class V3, class V4> struct visit_
 
     template<class I> auto operator()( I ) const -> Vret<R, F, V1, V2, V3, V4>
     {
+        BOOST_VARIANT2_PROFILE( extract_variant_base<V1>, visited, I::value );
+
         auto f2 = bind_front( std::forward<F>(f), unsafe_get<I::value>( std::forward<V1>(v1) ) );
         return visit<R>( f2, std::forward<V2>(v2), std::forward<V3>(v3), std::forward<V4>(v4) );
     }
@@ -2381,17 +3521,41 @@ template<class R, class F, class V1, class V2, class V3, class V4> struct visit_
 
 template<class R = detail::deduced, class F, class V1, class V2, class V3, class V4> constexpr auto visit( F&& f, V1&& v1, V2&& v2, V3&& v3, V4&& v4 ) -> detail::Vret<R, F, V1, V2, V3, V4>
 {
-    return mp11::mp_with_index<detail::variant_base_size<V1>>( v1.index(), detail::visit_L4<R, F, V1, V2, V3, V4>{ std::forward<F>(f), std::forward<V1>(v1), std::forward<V2>(v2), std::forward<V3>(v3), std::forward<V4>(v4) } );
+    return detail::with_index<detail::extract_variant_base<V1>, detail::variant_base_size<V1>::value>( v1.index(), detail::visit_L4<R, F, V1, V2, V3, V4>{ std::forward<F>(f), std::forward<V1>(v1), std::forward<V2>(v2), std::forward<V3>(v3), std::forward<V4>(v4) } );
 }
 
 #else
 
-template<class R = detail::deduced, class F, class V1, class V2, class... V> constexpr auto visit( F&& f, V1&& v1, V2&& v2, V&&... v ) -> detail::Vret<R, F, V1, V2, V...>
+namespace detail
+{
+
+template<class R, class F, class V1, class V2> constexpr auto visit_2( mp11::mp_false, F&& f, V1&& v1, V2&& v2 ) -> Vret<R, F, V1, V2>
+{
+    return with_index<extract_variant_base<V1>, variant_base_size<V1>::value>( v1.index(), [&]( auto I ){
+
+        BOOST_VARIANT2_PROFILE( extract_variant_base<V1>, visited, I.value );
+
+        auto f2 = [&]( auto&& a ){ return std::forward<F>(f)( unsafe_get<I.value>( std::forward<V1>(v1) ), std::forward<decltype(a)>(a) ); };
+        return visit<R>( f2, std::forward<V2>(v2) );
+
+    });
+}
+
+} // namespace detail
+
+template<class R = detail::deduced, class F, class V1, class V2> constexpr auto visit( F&& f, V1&& v1, V2&& v2 ) -> detail::Vret<R, F, V1, V2>
+{
+    return detail::visit_2<R>( detail::is_flat_visit<V1, V2>(), std::forward<F>(f), std::forward<V1>(v1), std::forward<V2>(v2) );
+}
+
+template<class R = detail::deduced, class F, class V1, class V2, class V3, class... V> constexpr auto visit( F&& f, V1&& v1, V2&& v2, V3&& v3, V&&... v ) -> detail::Vret<R, F, V1, V2, V3, V...>
 {
-    return mp11::mp_with_index<detail::variant_base_size<V1>>( v1.index(), [&]( auto I ){
+    return detail::with_index<detail::extract_variant_base<V1>, detail::variant_base_size<V1>::value>( v1.index(), [&]( auto I ){
+
+        BOOST_VARIANT2_PROFILE( detail::extract_variant_base<V1>, visited, I.value );
 
         auto f2 = [&]( auto&&... a ){ return std::forward<F>(f)( unsafe_get<I.value>( std::forward<V1>(v1) ), std::forward<decltype(a)>(a)... ); };
-        return visit<R>( f2, std::forward<V2>(v2), std::forward<V>(v)... );
+        return visit<R>( f2, std::forward<V2>(v2), std::forward<V3>(v3), std::forward<V>(v)... );
 
     });
 }
@@ -2421,7 +3585,7 @@ template<class R, class V, class... F> struct visit_by_index_L
 
     template<class I> constexpr detail::Vret2<R, V, F...> operator()( I ) const
     {
-        return std::get<I::value>( std::move(tp) )( unsafe_get<I::value>( std::forward<V>(v) ) );
+        return BOOST_VARIANT2_PROFILE_EXPR( remove_cv_ref_t<V>, visited, I::value, std::get<I::value>( std::move(tp) )( unsafe_get<I::value>( std::forward<V>(v) ) ) );
     }
 };
 
@@ -2431,7 +3595,7 @@ template<class R = detail::deduced, class V, class... F> constexpr auto visit_by
 {
     static_assert( variant_size<V>::value == sizeof...(F), "Incorrect number of function objects" );
 
-    return mp11::mp_with_index<variant_size<V>::value>( v.index(),
+    return detail::with_index<detail::remove_cv_ref_t<V>, variant_size<V>::value>( v.index(),
         detail::visit_by_index_L<R, V, F...>{ std::forward<V>(v), std::tuple<F&&...>( std::forward<F>(f)... ) } );
 }
 
@@ -2472,7 +3636,7 @@ template<class Ch, class Tr, class T1, class... T,
     class E = typename std::enable_if< mp11::mp_all< detail::is_output_streamable<std::basic_ostream<Ch, Tr>, T>... >::value >::type >
 std::basic_ostream<Ch, Tr>& operator<<( std::basic_ostream<Ch, Tr>& os, variant<T1, T...> const& v )
 {
-    return mp11::mp_with_index<1 + sizeof...(T)>( v.index(),
+    return detail::with_index<variant<T1, T...>, 1 + sizeof...(T)>( v.index(),
         detail::ostream_insert_L<Ch, Tr, T1, T...>{ os, v } );
 }
 
@@ -2531,7 +3695,7 @@ template<template<class> class H, class V> struct hash_value_L
 
 template<class... T> std::size_t hash_value_std( variant<T...> const & v )
 {
-    return mp11::mp_with_index<sizeof...(T)>( v.index(), detail::hash_value_L< std::hash, variant<T...> >{ v } );
+    return detail::with_index<variant<T...>, sizeof...(T)>( v.index(), detail::hash_value_L< std::hash, variant<T...> >{ v } );
 }
 
 } // namespace detail
@@ -2543,7 +3707,7 @@ inline std::size_t hash_value( monostate const & )
 
 template<class... T> std::size_t hash_value( variant<T...> const & v )
 {
-    return mp11::mp_with_index<sizeof...(T)>( v.index(), detail::hash_value_L< boost::hash, variant<T...> >{ v } );
+    return detail::with_index<variant<T...>, sizeof...(T)>( v.index(), detail::hash_value_L< boost::hash, variant<T...> >{ v } );
 }
 
 namespace detail
@@ -2588,6 +3752,12 @@ template<> struct hash< ::boost::variant2::monostate >
     }
 };
 
+// a variant uses an allocator when one of its alternatives does
+
+template<class... T, class Al> struct uses_allocator< ::boost::variant2::variant<T...>, Al >: public ::boost::mp11::mp_any< std::uses_allocator<T, Al>... >
+{
+};
+
 } // namespace std
 
 // JSON support
@@ -2627,6 +3797,12 @@ template<> struct is_null_like<variant2::monostate>: std::true_type {};
 namespace variant2
 {
 
+// variant_json_discriminator
+
+template<class V> struct variant_json_discriminator
+{
+};
+
 namespace detail
 {
 
@@ -2676,6 +3852,104 @@ template<class V> struct tag_invoke_L2
     }
 };
 
+// the JSON kinds from which an alternative can be converted
+
+BOOST_INLINE_CONSTEXPR unsigned json_null = 1;
+BOOST_INLINE_CONSTEXPR unsigned json_bool = 2;
+BOOST_INLINE_CONSTEXPR unsigned json_number = 4;
+BOOST_INLINE_CONSTEXPR unsigned json_string = 8;
+BOOST_INLINE_CONSTEXPR unsigned json_array = 16;
+BOOST_INLINE_CONSTEXPR unsigned json_object = 32;
+BOOST_INLINE_CONSTEXPR unsigned json_any = 63;
+
+template<class T> using is_json_string_like_impl = mp11::mp_bool<
+    std::is_same<typename T::traits_type::char_type, char>::value && std::is_same<typename T::value_type, char>::value
+>;
+
+template<class T> using is_json_string_like = mp11::mp_eval_if_not<mp11::mp_valid<is_json_string_like_impl, T>, mp11::mp_false, is_json_string_like_impl, T>;
+
+template<class T> using json_kinds = mp11::mp_cond<
+    std::is_same<T, monostate>, mp11::mp_size_t<json_null>,
+    std::is_same<T, std::nullptr_t>, mp11::mp_size_t<json_null>,
+    std::is_same<T, bool>, mp11::mp_size_t<json_bool>,
+    std::is_arithmetic<T>, mp11::mp_size_t<json_number>,
+    is_json_string_like<T>, mp11::mp_size_t<json_string>,
+    mp11::mp_true, mp11::mp_size_t<json_any>
+>;
+
+template<class V, unsigned K> struct json_candidates_impl
+{
+    template<class I> using fn = mp11::mp_bool<( json_kinds<mp11::mp_at<V, I>>::value & K ) != 0>;
+
+    using type = mp11::mp_copy_if_q<mp11::mp_iota<mp11::mp_size<V>>, json_candidates_impl>;
+};
+
+// the indices of the alternatives that can be converted from kind K
+template<class V, unsigned K> using json_candidates = typename json_candidates_impl<V, K>::type;
+
+template<class JV> unsigned json_kind_of( JV const& v ) noexcept
+{
+    using K = decltype( v.kind() );
+
+    switch( v.kind() )
+    {
+    case K::null: return json_null;
+    case K::bool_: return json_bool;
+    case K::int64: case K::uint64: case K::double_: return json_number;
+    case K::string: return json_string;
+    case K::array: return json_array;
+    case K::object: return json_object;
+    }
+
+    return json_any;
+}
+
+template<class V, class JV, class R> void json_try_value_to_kind( JV const& v, R& r )
+{
+    switch( json_kind_of( v ) )
+    {
+    case json_null: mp11::mp_for_each<json_candidates<V, json_null>>( tag_invoke_L2<V>{ v, r } ); break;
+    case json_bool: mp11::mp_for_each<json_candidates<V, json_bool>>( tag_invoke_L2<V>{ v, r } ); break;
+    case json_number: mp11::mp_for_each<json_candidates<V, json_number>>( tag_invoke_L2<V>{ v, r } ); break;
+    case json_string: mp11::mp_for_each<json_candidates<V, json_string>>( tag_invoke_L2<V>{ v, r } ); break;
+    case json_array: mp11::mp_for_each<json_candidates<V, json_array>>( tag_invoke_L2<V>{ v, r } ); break;
+    case json_object: mp11::mp_for_each<json_candidates<V, json_object>>( tag_invoke_L2<V>{ v, r } ); break;
+    default: mp11::mp_for_each<mp11::mp_iota<mp11::mp_size<V>>>( tag_invoke_L2<V>{ v, r } ); break;
+    }
+}
+
+template<class V> using json_discriminator_key = decltype( variant_json_discriminator<V>::key );
+
+template<class V, class JV, class R> void json_try_value_to( mp11::mp_false, JV const& v, R& r )
+{
+    json_try_value_to_kind<V>( v, r );
+}
+
+template<class V, class JV, class R> void json_try_value_to( mp11::mp_true, JV const& v, R& r )
+{
+    if( auto const* obj = v.if_object() )
+    {
+        char const* key = variant_json_discriminator<V>::key;
+        auto it = obj->find( key );
+
+        if( it != obj->end() )
+        {
+            if( auto const* name = it->value().if_string() )
+            {
+                std::size_t i = variant_json_discriminator<V>::index( *name );
+
+                if( i < mp11::mp_size<V>::value )
+                {
+                    detail::with_index<V, mp11::mp_size<V>::value>( i, tag_invoke_L2<V>{ v, r } );
+                    return;
+                }
+            }
+        }
+    }
+
+    json_try_value_to_kind<V>( v, r );
+}
+
 } // namespace detail
 
 template<class... T>
@@ -2685,7 +3959,7 @@ template<class... T>
     static constexpr boost::source_location loc = BOOST_CURRENT_LOCATION;
     auto r = boost::json::result_from_errno< variant<T...> >( EINVAL, &loc );
 
-    mp11::mp_for_each<mp11::mp_iota_c<sizeof...(T)>>( detail::tag_invoke_L2< variant<T...> >{ v, r } );
+    detail::json_try_value_to< variant<T...> >( mp11::mp_valid<detail::json_discriminator_key, variant<T...>>(), v, r );
 
     return r;
 }
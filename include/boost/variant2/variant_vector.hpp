@@ -0,0 +1,247 @@
+#ifndef BOOST_VARIANT2_VARIANT_VECTOR_HPP_INCLUDED
+#define BOOST_VARIANT2_VARIANT_VECTOR_HPP_INCLUDED
+
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/mp11.hpp>
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <vector>
+#include <tuple>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace boost
+{
+namespace variant2
+{
+
+// variant_vector
+
+template<class... T> class variant_vector;
+
+namespace detail
+{
+
+template<class T> using is_vv_element = mp11::mp_bool<
+    std::is_object<T>::value && !std::is_const<T>::value && !std::is_volatile<T>::value && !std::is_same<T, bool>::value
+>;
+
+struct vv_clear_L
+{
+    template<class V> void operator()( V& v ) const noexcept
+    {
+        v.clear();
+    }
+};
+
+template<class V> struct vv_ix_guard
+{
+    V* p_;
+
+    ~vv_ix_guard()
+    {
+        if( p_ ) p_->pop_back();
+    }
+};
+
+template<class... T> struct vv_push_back_L1
+{
+    variant_vector<T...>* this_;
+    variant<T...> const& v;
+
+    template<class I> void operator()( I ) const
+    {
+        this_->template emplace_back<I::value>( unsafe_get<I::value>( v ) );
+    }
+};
+
+template<class... T> struct vv_push_back_L2
+{
+    variant_vector<T...>* this_;
+    variant<T...>& v;
+
+    template<class I> void operator()( I ) const
+    {
+        this_->template emplace_back<I::value>( std::move( unsafe_get<I::value>( v ) ) );
+    }
+};
+
+} // namespace detail
+
+template<class... T> class variant_vector
+{
+private:
+
+    static_assert( sizeof...(T) > 0, "variant_vector requires at least one alternative" );
+    static_assert( mp11::mp_all<detail::is_vv_element<T>...>::value, "variant_vector alternatives must be cv-unqualified object types other than bool" );
+
+    using index_type = detail::get_smallest_unsigned_type< sizeof...(T) >;
+
+    std::vector<index_type> ix_;
+    std::tuple<std::vector<T>...> st_;
+
+public:
+
+    using value_type = variant<T...>;
+    using size_type = std::size_t;
+
+    // constructors
+
+    variant_vector() = default;
+
+    // capacity
+
+    bool empty() const noexcept
+    {
+        return ix_.empty();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return ix_.size();
+    }
+
+    void reserve( std::size_t n )
+    {
+        ix_.reserve( n );
+    }
+
+    // modifiers
+
+    void clear() noexcept
+    {
+        ix_.clear();
+        mp11::tuple_for_each( st_, detail::vv_clear_L() );
+    }
+
+    template<std::size_t I, class... A> variant_alternative_t<I, variant<T...>>& emplace_back( A&&... a )
+    {
+        static_assert( I < sizeof...(T), "Index out of bounds" );
+
+        auto& s = std::get<I>( st_ );
+
+        ix_.push_back( static_cast<index_type>( I ) );
+        detail::vv_ix_guard< std::vector<index_type> > guard{ &ix_ };
+
+        s.emplace_back( std::forward<A>(a)... );
+
+        guard.p_ = 0;
+        return s.back();
+    }
+
+    template<class U, class... A,
+        class E = typename std::enable_if< mp11::mp_count<mp11::mp_list<T...>, U>::value == 1 >::type>
+    U& emplace_back( A&&... a )
+    {
+        using I = mp11::mp_find<mp11::mp_list<T...>, U>;
+        return this->template emplace_back<I::value>( std::forward<A>(a)... );
+    }
+
+    void push_back( variant<T...> const& v )
+    {
+        detail::with_index<variant<T...>, sizeof...(T)>( v.index(), detail::vv_push_back_L1<T...>{ this, v } );
+    }
+
+    void push_back( variant<T...>&& v )
+    {
+        detail::with_index<variant<T...>, sizeof...(T)>( v.index(), detail::vv_push_back_L2<T...>{ this, v } );
+    }
+
+    // element access
+
+    std::size_t index( std::size_t i ) const noexcept
+    {
+        BOOST_ASSERT( i < size() );
+        return ix_[ i ];
+    }
+
+    template<std::size_t I> std::vector<variant_alternative_t<I, variant<T...>>>& segment() noexcept
+    {
+        static_assert( I < sizeof...(T), "Index out of bounds" );
+        return std::get<I>( st_ );
+    }
+
+    template<std::size_t I> std::vector<variant_alternative_t<I, variant<T...>>> const& segment() const noexcept
+    {
+        static_assert( I < sizeof...(T), "Index out of bounds" );
+        return std::get<I>( st_ );
+    }
+};
+
+// for_each_visit
+
+namespace detail
+{
+
+template<class F, class VV> struct vv_for_each_L
+{
+    F& f;
+    VV& v;
+
+    template<class I> void operator()( I ) const
+    {
+        auto& s = v.template segment<I::value>();
+
+        for( auto first = s.begin(), last = s.end(); first != last; ++first )
+        {
+            f( *first );
+        }
+    }
+};
+
+template<class F, class VV, std::size_t N> struct vv_in_order_L
+{
+    F& f;
+    VV& v;
+    std::array<std::size_t, N>& pos;
+
+    template<class I> void operator()( I ) const
+    {
+        f( v.template segment<I::value>()[ pos[ I::value ]++ ] );
+    }
+};
+
+} // namespace detail
+
+template<class F, class... T> void for_each_visit( F&& f, variant_vector<T...>& v )
+{
+    mp11::mp_for_each<mp11::mp_iota_c<sizeof...(T)>>( detail::vv_for_each_L<F, variant_vector<T...>>{ f, v } );
+}
+
+template<class F, class... T> void for_each_visit( F&& f, variant_vector<T...> const& v )
+{
+    mp11::mp_for_each<mp11::mp_iota_c<sizeof...(T)>>( detail::vv_for_each_L<F, variant_vector<T...> const>{ f, v } );
+}
+
+template<class F, class... T> void for_each_visit_in_order( F&& f, variant_vector<T...>& v )
+{
+    std::array<std::size_t, sizeof...(T)> pos = {{}};
+    detail::vv_in_order_L<F, variant_vector<T...>, sizeof...(T)> L{ f, v, pos };
+
+    for( std::size_t i = 0, n = v.size(); i < n; ++i )
+    {
+        detail::with_index<variant<T...>, sizeof...(T)>( v.index( i ), L );
+    }
+}
+
+template<class F, class... T> void for_each_visit_in_order( F&& f, variant_vector<T...> const& v )
+{
+    std::array<std::size_t, sizeof...(T)> pos = {{}};
+    detail::vv_in_order_L<F, variant_vector<T...> const, sizeof...(T)> L{ f, v, pos };
+
+    for( std::size_t i = 0, n = v.size(); i < n; ++i )
+    {
+        detail::with_index<variant<T...>, sizeof...(T)>( v.index( i ), L );
+    }
+}
+
+} // namespace variant2
+} // namespace boost
+
+#endif // #ifndef BOOST_VARIANT2_VARIANT_VECTOR_HPP_INCLUDED
@@ -0,0 +1,193 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <string>
+#include <vector>
+
+using namespace boost::variant2;
+
+// counts constructions and assignments
+
+struct X
+{
+    static int constructions;
+    static int assignments;
+
+    int v;
+
+    X( int v = 0 ): v( v )
+    {
+        ++constructions;
+    }
+
+    X( X const& r ): v( r.v )
+    {
+        ++constructions;
+    }
+
+    X( X&& r ): v( r.v )
+    {
+        ++constructions;
+    }
+
+    X& operator=( X const& r )
+    {
+        v = r.v;
+        ++assignments;
+        return *this;
+    }
+
+    X& operator=( X&& r )
+    {
+        v = r.v;
+        ++assignments;
+        return *this;
+    }
+
+    X& operator=( int w )
+    {
+        v = w;
+        ++assignments;
+        return *this;
+    }
+
+    static void reset()
+    {
+        constructions = assignments = 0;
+    }
+};
+
+int X::constructions = 0;
+int X::assignments = 0;
+
+// a potentially throwing move constructor makes the variant double-buffered
+
+struct Y
+{
+    Y() {}
+    Y( Y const& ) {}
+    Y( Y&& ) noexcept( false ) {}
+
+    Y& operator=( Y const& ) { return *this; }
+    Y& operator=( Y&& ) { return *this; }
+};
+
+bool operator==( Y const&, Y const& )
+{
+    return true;
+}
+
+template<class V> void test_string()
+{
+    std::string const s( 100, 'x' );
+    std::string const s2( 50, 'y' );
+
+    V v( s );
+
+    char const* p = get<std::string>( v ).data();
+
+    v.assign_same_or_emplace( s2 );
+
+    BOOST_TEST_EQ( get<std::string>( v ), s2 );
+    BOOST_TEST_EQ( get<std::string>( v ).data(), p );
+
+    v.assign_same_or_emplace( "abc" );
+
+    BOOST_TEST_EQ( get<std::string>( v ), std::string( "abc" ) );
+    BOOST_TEST_EQ( get<std::string>( v ).data(), p );
+
+    V w( s );
+
+    v.assign_same_or_emplace( w );
+
+    BOOST_TEST_EQ( get<std::string>( v ), s );
+    BOOST_TEST_EQ( get<std::string>( v ).data(), p );
+
+    v.assign_same_or_emplace( 5 );
+
+    BOOST_TEST_EQ( v.index(), 0u );
+    BOOST_TEST_EQ( get<0>( v ), 5 );
+
+    v.assign_same_or_emplace( std::move( w ) );
+
+    BOOST_TEST_EQ( v.index(), 1u );
+    BOOST_TEST_EQ( get<std::string>( v ), s );
+
+    V const z( 7 );
+
+    v.assign_same_or_emplace( z );
+
+    BOOST_TEST( v == z );
+
+    v.assign_same_or_emplace( v );
+
+    BOOST_TEST( v == z );
+}
+
+int main()
+{
+    test_string< variant<int, std::string> >();
+    test_string< variant<int, std::string, Y> >();
+
+    BOOST_TEST(( !variant<int, std::string>::uses_double_storage() ));
+    BOOST_TEST(( variant<int, std::string, Y>::uses_double_storage() ));
+
+    {
+        variant<int, X> v( in_place_type_t<X>(), 1 );
+
+        X::reset();
+
+        v.assign_same_or_emplace( X( 2 ) );
+
+        BOOST_TEST_EQ( get<X>( v ).v, 2 );
+        BOOST_TEST_EQ( X::constructions, 1 );
+        BOOST_TEST_EQ( X::assignments, 1 );
+
+        X::reset();
+
+        variant<int, X> w( v );
+        w.assign_same_or_emplace( v );
+
+        BOOST_TEST_EQ( X::constructions, 1 );
+        BOOST_TEST_EQ( X::assignments, 1 );
+
+        X::reset();
+
+        w.assign_same_or_emplace( std::move( v ) );
+
+        BOOST_TEST_EQ( X::constructions, 0 );
+        BOOST_TEST_EQ( X::assignments, 1 );
+
+        // operator= still replaces the contained value
+
+        X::reset();
+
+        w = X( 3 );
+
+        BOOST_TEST_EQ( get<X>( w ).v, 3 );
+        BOOST_TEST_EQ( X::assignments, 0 );
+
+        X::reset();
+
+        w.assign_same_or_emplace( 1 );
+
+        BOOST_TEST_EQ( w.index(), 0u );
+        BOOST_TEST_EQ( X::assignments, 0 );
+    }
+
+    {
+        variant<std::vector<int>, std::string> v( std::vector<int>( 1000, 1 ) );
+
+        std::vector<int> const x( 10, 2 );
+
+        v.assign_same_or_emplace( x );
+
+        BOOST_TEST( get<0>( v ) == x );
+        BOOST_TEST_GE( get<0>( v ).capacity(), 1000u );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,179 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/atomic_variant.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <thread>
+#include <vector>
+
+using namespace boost::variant2;
+
+struct P
+{
+    char c;
+    int x;
+};
+
+template<class A> void test_single_thread()
+{
+    using V = typename A::value_type;
+
+    A a;
+
+    BOOST_TEST( a.load() == V() );
+
+    a.store( V( 5 ) );
+
+    BOOST_TEST( a.load() == V( 5 ) );
+    BOOST_TEST( static_cast<V>( a ) == V( 5 ) );
+
+    a = V( 2.5 );
+
+    BOOST_TEST( a.load( std::memory_order_acquire ) == V( 2.5 ) );
+
+    BOOST_TEST( a.exchange( V( 7 ) ) == V( 2.5 ) );
+    BOOST_TEST( a.load() == V( 7 ) );
+
+    {
+        V e( 8 );
+
+        BOOST_TEST( !a.compare_exchange_strong( e, V( 9 ) ) );
+        BOOST_TEST( e == V( 7 ) );
+
+        BOOST_TEST( a.compare_exchange_strong( e, V( 9 ) ) );
+        BOOST_TEST( a.load() == V( 9 ) );
+    }
+
+    {
+        // same bytes, different index
+
+        V e( 9.0f );
+
+        BOOST_TEST( !a.compare_exchange_strong( e, V(), std::memory_order_acq_rel ) );
+        BOOST_TEST( e == V( 9 ) );
+    }
+
+    {
+        V e( 9 );
+
+        while( !a.compare_exchange_weak( e, V() ) )
+        {
+            BOOST_TEST( e == V( 9 ) );
+        }
+
+        BOOST_TEST( a.load() == V() );
+    }
+
+    {
+        // the bytes of the previous alternative don't take part in the comparison
+
+        A b( V( 1.0 ) );
+
+        b.store( V( 3 ) );
+
+        V e( 3 );
+
+        BOOST_TEST( b.compare_exchange_strong( e, V( 4 ) ) );
+        BOOST_TEST( b.load() == V( 4 ) );
+    }
+}
+
+template<class A> void test_threads()
+{
+    using V = typename A::value_type;
+
+    int const N = 4;
+    int const M = 10000;
+
+    A a( V( 0 ) );
+
+    std::vector<std::thread> th;
+
+    for( int i = 0; i < N; ++i )
+    {
+        th.emplace_back( [&]{
+
+            for( int j = 0; j < M; ++j )
+            {
+                V e = a.load();
+
+                for( ;; )
+                {
+                    // alternate between the alternatives 1 and 2
+                    V d = e.index() == 1? V( in_place_index_t<2>(), get<1>( e ) + 1 ): V( in_place_index_t<1>(), static_cast<int>( get<2>( e ) ) + 1 );
+
+                    if( a.compare_exchange_weak( e, d ) ) break;
+                }
+            }
+        });
+    }
+
+    for( auto& t: th ) t.join();
+
+    V v = a.load();
+
+    BOOST_TEST_EQ( v.index(), 1u );
+    BOOST_TEST( v == V( N * M ) );
+}
+
+int main()
+{
+    {
+        using A = atomic_variant<monostate, int, double, float>;
+
+        BOOST_TEST( A::is_always_lock_free == A().is_lock_free() );
+
+        test_single_thread<A>();
+        test_threads<A>();
+    }
+
+    {
+        using A = atomic_variant<monostate, int, float, double, void*>;
+
+        test_single_thread<A>();
+        test_threads<A>();
+    }
+
+    {
+        // fits in eight bytes
+
+        using A = atomic_variant<monostate, int, float, double>;
+
+        BOOST_TEST_EQ( sizeof( A::value_type ), 16u );
+
+        using B = atomic_variant<int, float>;
+
+        BOOST_TEST( B::is_always_lock_free );
+        BOOST_TEST( B().is_lock_free() );
+
+        B b( 1.5f );
+
+        BOOST_TEST( b.exchange( 2 ) == B::value_type( 1.5f ) );
+        BOOST_TEST( b.load() == B::value_type( 2 ) );
+    }
+
+#if defined(BOOST_VARIANT2_HAS_CLEAR_PADDING)
+
+    {
+        // padding inside an alternative, rejected when it can't be cleared
+
+        using A = atomic_variant<int, P>;
+        using V = A::value_type;
+
+        P p1;
+        p1.c = 'a';
+        p1.x = 1;
+
+        V e( p1 );
+
+        A a( e );
+
+        BOOST_TEST( a.compare_exchange_strong( e, V( 5 ) ) );
+        BOOST_TEST_EQ( get<int>( a.load() ), 5 );
+    }
+
+#endif
+
+    return boost::report_errors();
+}
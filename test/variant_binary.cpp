@@ -0,0 +1,222 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/binary.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+
+using namespace boost::variant2;
+
+struct P
+{
+    int x, y;
+};
+
+inline bool operator==( P const& p1, P const& p2 )
+{
+    return p1.x == p2.x && p1.y == p2.y;
+}
+
+// X is not trivially copyable and uses a user-provided encoding
+
+struct X
+{
+    static int reads;
+
+    std::vector<int> v;
+};
+
+int X::reads = 0;
+
+inline bool operator==( X const& x1, X const& x2 )
+{
+    return x1.v == x2.v;
+}
+
+namespace boost
+{
+namespace variant2
+{
+
+template<> struct binary_traits<X>
+{
+    static std::size_t size( X const& x ) noexcept
+    {
+        return 1 + x.v.size() * sizeof(int);
+    }
+
+    static unsigned char* write( unsigned char* p, X const& x ) noexcept
+    {
+        *p++ = static_cast<unsigned char>( x.v.size() );
+        std::memcpy( p, x.v.data(), x.v.size() * sizeof(int) );
+        return p + x.v.size() * sizeof(int);
+    }
+
+    static std::size_t parse( unsigned char const* first, unsigned char const* last ) noexcept
+    {
+        if( first == last ) return binary_error;
+
+        std::size_t n = 1 + *first * sizeof(int);
+        return n > static_cast<std::size_t>( last - first )? binary_error: n;
+    }
+
+    static X read( unsigned char const* first, unsigned char const* /*last*/ )
+    {
+        ++X::reads;
+
+        X x;
+        x.v.resize( *first );
+        std::memcpy( x.v.data(), first + 1, x.v.size() * sizeof(int) );
+        return x;
+    }
+};
+
+} // namespace variant2
+} // namespace boost
+
+template<class V> V roundtrip( V const& v )
+{
+    std::vector<unsigned char> buffer( binary_size( v ) );
+
+    unsigned char* p = write_binary( buffer.data(), v );
+    BOOST_TEST_EQ( p, buffer.data() + buffer.size() );
+
+    V w;
+
+    unsigned char const* q = read_binary( buffer.data(), buffer.data() + buffer.size(), w );
+    BOOST_TEST_EQ( q, buffer.data() + buffer.size() );
+
+    return w;
+}
+
+int main()
+{
+    {
+        using V = variant<monostate, int, double, P, std::string>;
+
+        BOOST_TEST_EQ( binary_size( V() ), 1u );
+        BOOST_TEST_EQ( binary_size( V( 1 ) ), 1 + sizeof( int ) );
+        BOOST_TEST_EQ( binary_size( V( "abc" ) ), 1 + 1 + 3u );
+
+        BOOST_TEST( roundtrip( V() ) == V() );
+        BOOST_TEST( roundtrip( V( 5 ) ) == V( 5 ) );
+        BOOST_TEST( roundtrip( V( 3.14 ) ) == V( 3.14 ) );
+        BOOST_TEST( roundtrip( V( std::string() ) ) == V( std::string() ) );
+        BOOST_TEST( roundtrip( V( "abc" ) ) == V( "abc" ) );
+
+        {
+            V w = roundtrip( V( P{ 1, 2 } ) );
+
+            BOOST_TEST_EQ( w.index(), 3u );
+            BOOST_TEST( get<P>( w ) == ( P{ 1, 2 } ) );
+        }
+
+        {
+            // two byte length
+            std::string s( 300, 'x' );
+
+            BOOST_TEST_EQ( binary_size( V( s ) ), 1 + 2 + 300u );
+            BOOST_TEST( roundtrip( V( s ) ) == V( s ) );
+        }
+    }
+
+    {
+        using V1 = variant<int, std::string>;
+        using V = variant<monostate, V1, X>;
+
+        V v( V1( "nested" ) );
+
+        BOOST_TEST_EQ( binary_size( v ), 1 + 1 + 1 + 6u );
+        BOOST_TEST( roundtrip( v ) == v );
+
+        X x;
+        x.v = { 1, 2, 3 };
+
+        BOOST_TEST( roundtrip( V( x ) ) == V( x ) );
+        BOOST_TEST_EQ( X::reads, 1 );
+    }
+
+    {
+        // several values in one buffer
+
+        using V = variant<int, std::string>;
+
+        V v1( 7 ), v2( "seven" );
+
+        std::vector<unsigned char> buffer( binary_size( v1 ) + binary_size( v2 ) );
+
+        unsigned char* p = buffer.data();
+
+        p = write_binary( p, v1 );
+        p = write_binary( p, v2 );
+
+        BOOST_TEST_EQ( p, buffer.data() + buffer.size() );
+
+        unsigned char const* q = buffer.data();
+        unsigned char const* last = buffer.data() + buffer.size();
+
+        V w;
+
+        q = read_binary( q, last, w );
+        BOOST_TEST( w == v1 );
+
+        q = read_binary( q, last, w );
+        BOOST_TEST( w == v2 );
+
+        BOOST_TEST_EQ( q, last );
+    }
+
+    {
+        // malformed input leaves the variant unchanged
+
+        using V = variant<int, std::string>;
+
+        V v( "abcdef" );
+
+        std::vector<unsigned char> buffer( binary_size( v ) );
+        write_binary( buffer.data(), v );
+
+        V w( 1 );
+
+        for( std::size_t i = 0; i < buffer.size(); ++i )
+        {
+            BOOST_TEST_EQ( read_binary( buffer.data(), buffer.data() + i, w ), static_cast<unsigned char const*>( nullptr ) );
+            BOOST_TEST( w == V( 1 ) );
+        }
+
+        // index out of range
+        buffer[ 0 ] = 2;
+
+        BOOST_TEST_EQ( read_binary( buffer.data(), buffer.data() + buffer.size(), w ), static_cast<unsigned char const*>( nullptr ) );
+        BOOST_TEST( w == V( 1 ) );
+
+        // overlong varint
+        std::vector<unsigned char> b2( 16, 0xFF );
+
+        BOOST_TEST_EQ( read_binary( b2.data(), b2.data() + b2.size(), w ), static_cast<unsigned char const*>( nullptr ) );
+        BOOST_TEST( w == V( 1 ) );
+    }
+
+    {
+        // only 0 and 1 are valid bools
+
+        using V = variant<int, bool>;
+
+        BOOST_TEST_EQ( binary_size( V( true ) ), 2u );
+        BOOST_TEST( roundtrip( V( true ) ) == V( true ) );
+        BOOST_TEST( roundtrip( V( false ) ) == V( false ) );
+
+        unsigned char const buffer[] = { 1, 7 };
+
+        V w( 1 );
+
+        BOOST_TEST_EQ( read_binary( buffer, buffer + 2, w ), static_cast<unsigned char const*>( nullptr ) );
+        BOOST_TEST( w == V( 1 ) );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,264 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/boxed_value.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+using namespace boost::variant2;
+
+struct Object
+{
+    int v;
+};
+
+enum class E: unsigned char
+{
+    e1 = 1,
+    e2 = 200
+};
+
+struct F
+{
+    int operator()( monostate ) const { return 0; }
+    int operator()( bool x ) const { return x? 11: 10; }
+    int operator()( int x ) const { return 100 + x; }
+    int operator()( double x ) const { return 200 + static_cast<int>( x ); }
+    int operator()( Object* p ) const { return 300 + p->v; }
+};
+
+struct G
+{
+    template<class T1, class T2> double operator()( T1 x1, T2 x2 ) const
+    {
+        return static_cast<double>( x1 ) + static_cast<double>( x2 );
+    }
+};
+
+int main()
+{
+    using V = boxed_value<monostate, bool, int, double, Object*>;
+
+    BOOST_TEST_EQ( sizeof( V ), 8u );
+    BOOST_TEST_EQ( variant_size<V>::value, 5u );
+    BOOST_TEST_TRAIT_SAME( variant_alternative_t<2, V>, int );
+    BOOST_TEST_TRAIT_SAME( variant_alternative_t<4, V const>, Object* const );
+
+    {
+        V v;
+
+        BOOST_TEST_EQ( v.index(), 0u );
+        BOOST_TEST( holds_alternative<monostate>( v ) );
+        BOOST_TEST( !v.valueless_by_exception() );
+    }
+
+    {
+        V v( true );
+
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST_EQ( get<bool>( v ), true );
+
+        v = false;
+
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST_EQ( get<1>( v ), false );
+    }
+
+    {
+        int const xs[] = { 0, 1, -1, 12345, std::numeric_limits<int>::min(), std::numeric_limits<int>::max() };
+
+        for( int x: xs )
+        {
+            V v( x );
+
+            BOOST_TEST_EQ( v.index(), 2u );
+            BOOST_TEST_EQ( get<int>( v ), x );
+            BOOST_TEST_EQ( get<2>( v ), x );
+        }
+    }
+
+    {
+        double const xs[] = { 0.0, -0.0, 1.5, -3.25, 1e300, -1e-300, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::denorm_min() };
+
+        for( double x: xs )
+        {
+            V v( x );
+
+            BOOST_TEST_EQ( v.index(), 3u );
+            BOOST_TEST_EQ( get<double>( v ), x );
+            BOOST_TEST_EQ( std::signbit( get<double>( v ) ), std::signbit( x ) );
+        }
+    }
+
+    {
+        V v( std::numeric_limits<double>::quiet_NaN() );
+
+        BOOST_TEST_EQ( v.index(), 3u );
+        BOOST_TEST( std::isnan( get<double>( v ) ) );
+
+        V w( -std::numeric_limits<double>::quiet_NaN() );
+
+        BOOST_TEST_EQ( w.index(), 3u );
+        BOOST_TEST( std::isnan( get<double>( w ) ) );
+
+        // a NaN whose bit pattern collides with a tag is canonicalized
+
+        std::uint64_t u = 0xFFFB000000000007ull;
+
+        double d;
+        std::memcpy( &d, &u, sizeof( d ) );
+
+        V z( d );
+
+        BOOST_TEST_EQ( z.index(), 3u );
+        BOOST_TEST( std::isnan( get<double>( z ) ) );
+    }
+
+    {
+        Object o{ 7 };
+
+        V v( &o );
+
+        BOOST_TEST_EQ( v.index(), 4u );
+        BOOST_TEST_EQ( get<Object*>( v ), &o );
+
+        v = static_cast<Object*>( nullptr );
+
+        BOOST_TEST_EQ( v.index(), 4u );
+        BOOST_TEST_EQ( get<Object*>( v ), static_cast<Object*>( nullptr ) );
+    }
+
+    {
+        V v( 5 );
+
+        BOOST_TEST_THROWS( get<double>( v ), bad_variant_access );
+        BOOST_TEST_THROWS( get<0>( v ), bad_variant_access );
+
+        BOOST_TEST( get_if<int>( &v ) );
+        BOOST_TEST_EQ( *get_if<int>( &v ), 5 );
+        BOOST_TEST_EQ( *get_if<2>( &v ), 5 );
+        BOOST_TEST( get_if<double>( &v ) == nullptr );
+        BOOST_TEST( get_if<3>( &v ) == nullptr );
+        BOOST_TEST( get_if<int>( static_cast<V const*>( nullptr ) ) == nullptr );
+
+        if( auto p = get_if<int>( &v ) )
+        {
+            BOOST_TEST_EQ( *p, 5 );
+        }
+        else
+        {
+            BOOST_ERROR( "get_if<int> returned null" );
+        }
+    }
+
+    {
+        V v;
+
+        BOOST_TEST_EQ( v.emplace<2>( 4 ), 4 );
+        BOOST_TEST_EQ( v.index(), 2u );
+
+        BOOST_TEST_EQ( v.emplace<double>( 0.5 ), 0.5 );
+        BOOST_TEST_EQ( v.index(), 3u );
+
+        V w( in_place_index_t<1>(), true );
+        BOOST_TEST_EQ( w.index(), 1u );
+
+        V z( in_place_type_t<int>(), 3 );
+        BOOST_TEST_EQ( z.index(), 2u );
+
+        swap( v, z );
+
+        BOOST_TEST_EQ( v.index(), 2u );
+        BOOST_TEST_EQ( z.index(), 3u );
+    }
+
+    {
+        Object o{ 4 };
+
+        BOOST_TEST_EQ( visit( F(), V() ), 0 );
+        BOOST_TEST_EQ( visit( F(), V( true ) ), 11 );
+        BOOST_TEST_EQ( visit( F(), V( 3 ) ), 103 );
+        BOOST_TEST_EQ( visit( F(), V( 2.5 ) ), 202 );
+        BOOST_TEST_EQ( visit( F(), V( &o ) ), 304 );
+
+        V v( 3 );
+        BOOST_TEST_EQ( visit<long>( F(), v ), 103 );
+
+        V const cv( 3 );
+        BOOST_TEST_EQ( visit( F(), cv ), 103 );
+    }
+
+    {
+        using W = boxed_value<int, double>;
+
+        W v1( 1 ), v2( 2.5 );
+
+        auto r = visit( G(), v1, v2 );
+
+        BOOST_TEST_TRAIT_SAME( decltype(r), double );
+        BOOST_TEST_EQ( r, 3.5 );
+    }
+
+    {
+        V v1( 1 ), v2( 1 ), v3( 2 ), v4( 1.0 );
+
+        BOOST_TEST( v1 == v2 );
+        BOOST_TEST( v1 != v3 );
+        BOOST_TEST( v1 != v4 );
+        BOOST_TEST( v1 < v3 );
+        BOOST_TEST( v3 < v4 );
+        BOOST_TEST( v4 > v1 );
+        BOOST_TEST( v1 <= v2 );
+        BOOST_TEST( v1 >= v2 );
+
+        V z1( 0.0 ), z2( -0.0 );
+        BOOST_TEST( z1 == z2 );
+
+        V n( std::numeric_limits<double>::quiet_NaN() );
+        BOOST_TEST( n != n );
+    }
+
+    {
+        using W = boxed_value<float, E, std::nullptr_t, unsigned short, char>;
+
+        BOOST_TEST_EQ( sizeof( W ), 8u );
+
+        W v( 1.5f );
+        BOOST_TEST_EQ( v.index(), 0u );
+        BOOST_TEST_EQ( get<float>( v ), 1.5f );
+
+        v = E::e2;
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST( get<E>( v ) == E::e2 );
+
+        v = nullptr;
+        BOOST_TEST_EQ( v.index(), 2u );
+
+        v.emplace<unsigned short>( 65535 );
+        BOOST_TEST_EQ( v.index(), 3u );
+        BOOST_TEST_EQ( get<3>( v ), 65535 );
+
+        v = 'x';
+        BOOST_TEST_EQ( v.index(), 4u );
+        BOOST_TEST_EQ( get<char>( v ), 'x' );
+    }
+
+    {
+        // duplicate alternatives are distinguished by index
+
+        using W = boxed_value<int, double, int>;
+
+        W v( in_place_index_t<2>(), 5 );
+
+        BOOST_TEST_EQ( v.index(), 2u );
+        BOOST_TEST_EQ( get<2>( v ), 5 );
+        BOOST_TEST_THROWS( get<0>( v ), bad_variant_access );
+    }
+
+    return boost::report_errors();
+}
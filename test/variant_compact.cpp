@@ -0,0 +1,450 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/compact_variant.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <string>
+#include <memory>
+#include <cstddef>
+
+#if !defined(BOOST_NO_CXX17_HDR_MEMORY_RESOURCE)
+# include <memory_resource>
+#endif
+
+using namespace boost::variant2;
+
+struct Huge
+{
+    int v;
+    char pad[ 508 ];
+
+    Huge(): v( 0 ), pad()
+    {
+    }
+
+    explicit Huge( int v ): v( v ), pad()
+    {
+    }
+};
+
+inline bool operator==( Huge const& x, Huge const& y )
+{
+    return x.v == y.v;
+}
+
+inline bool operator!=( Huge const& x, Huge const& y )
+{
+    return x.v != y.v;
+}
+
+inline bool operator<( Huge const& x, Huge const& y )
+{
+    return x.v < y.v;
+}
+
+inline bool operator>( Huge const& x, Huge const& y )
+{
+    return x.v > y.v;
+}
+
+inline bool operator<=( Huge const& x, Huge const& y )
+{
+    return x.v <= y.v;
+}
+
+inline bool operator>=( Huge const& x, Huge const& y )
+{
+    return x.v >= y.v;
+}
+
+static int allocations;
+static int deallocations;
+
+template<class T> struct counting_allocator
+{
+    using value_type = T;
+
+    counting_allocator() = default;
+
+    template<class U> counting_allocator( counting_allocator<U> const& ) noexcept
+    {
+    }
+
+    T* allocate( std::size_t n )
+    {
+        ++allocations;
+        return std::allocator<T>().allocate( n );
+    }
+
+    void deallocate( T* p, std::size_t n ) noexcept
+    {
+        ++deallocations;
+        std::allocator<T>().deallocate( p, n );
+    }
+};
+
+// a stateful allocator that allocates from an arena identified by id_
+
+static int arena_allocations[ 3 ];
+
+template<class T> struct arena_allocator
+{
+    using value_type = T;
+
+    int id_;
+
+    explicit arena_allocator( int id ) noexcept: id_( id )
+    {
+    }
+
+    template<class U> arena_allocator( arena_allocator<U> const& r ) noexcept: id_( r.id_ )
+    {
+    }
+
+    T* allocate( std::size_t n )
+    {
+        ++arena_allocations[ id_ ];
+        return std::allocator<T>().allocate( n );
+    }
+
+    void deallocate( T* p, std::size_t n ) noexcept
+    {
+        --arena_allocations[ id_ ];
+        std::allocator<T>().deallocate( p, n );
+    }
+};
+
+template<class T, class U> bool operator==( arena_allocator<T> const& a, arena_allocator<U> const& b ) noexcept
+{
+    return a.id_ == b.id_;
+}
+
+template<class T, class U> bool operator!=( arena_allocator<T> const& a, arena_allocator<U> const& b ) noexcept
+{
+    return a.id_ != b.id_;
+}
+
+template<class T, class U> bool operator==( counting_allocator<T> const&, counting_allocator<U> const& ) noexcept
+{
+    return true;
+}
+
+template<class T, class U> bool operator!=( counting_allocator<T> const&, counting_allocator<U> const& ) noexcept
+{
+    return false;
+}
+
+struct F
+{
+    int operator()( int x ) const { return x; }
+    int operator()( double x ) const { return static_cast<int>( x * 10 ); }
+    int operator()( Huge const& x ) const { return 1000 + x.v; }
+};
+
+struct F2
+{
+    void operator()( int& x ) const { ++x; }
+    void operator()( double& x ) const { x += 1; }
+    void operator()( Huge& x ) const { ++x.v; }
+    template<class T> void operator()( T& x ) const { ++x.h.v; }
+};
+
+struct Big
+{
+    Huge h;
+
+    explicit Big( int v ): h( v )
+    {
+    }
+};
+
+inline bool operator==( Big const& x, Big const& y )
+{
+    return x.h == y.h;
+}
+
+inline bool operator!=( Big const& x, Big const& y )
+{
+    return x.h != y.h;
+}
+
+struct H
+{
+    int operator()( int x ) const { return x; }
+    int operator()( Huge const& x ) const { return 1000 + x.v; }
+    int operator()( Big const& x ) const { return 2000 + x.h.v; }
+};
+
+struct G
+{
+    int operator()( Huge const& x, Huge const& y ) const { return x.v * 10 + y.v; }
+    template<class T1, class T2> int operator()( T1 const&, T2 const& ) const { return -1; }
+};
+
+int main()
+{
+    {
+        using V = compact_variant<16, int, double, Huge>;
+
+        BOOST_TEST_LE( sizeof( V ), 16u );
+        BOOST_TEST_GE( sizeof( variant<int, double, Huge> ), sizeof( Huge ) );
+
+        BOOST_TEST_EQ( variant_size<V>::value, 3u );
+        BOOST_TEST_TRAIT_SAME( variant_alternative_t<2, V>, Huge );
+
+        V v;
+
+        BOOST_TEST_EQ( v.index(), 0u );
+        BOOST_TEST_EQ( get<0>( v ), 0 );
+
+        v = 1.5;
+
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST_EQ( get<double>( v ), 1.5 );
+
+        v = Huge( 5 );
+
+        BOOST_TEST_EQ( v.index(), 2u );
+        BOOST_TEST( holds_alternative<Huge>( v ) );
+
+        Huge& h = get<Huge>( v );
+        BOOST_TEST_EQ( h.v, 5 );
+
+        h.v = 6;
+        BOOST_TEST_EQ( get<2>( v ).v, 6 );
+
+        v = Huge( 7 );
+        BOOST_TEST_EQ( &get<Huge>( v ), &h );
+        BOOST_TEST_EQ( h.v, 7 );
+
+        BOOST_TEST_EQ( visit( F(), v ), 1007 );
+        BOOST_TEST_EQ( visit<long>( F(), v ), 1007 );
+
+        visit( F2(), v );
+        BOOST_TEST_EQ( get<Huge>( v ).v, 8 );
+
+        V const& cv = v;
+
+        BOOST_TEST_EQ( get_if<Huge>( &cv ), &h );
+        BOOST_TEST_EQ( get_if<0>( &cv ), static_cast<int const*>( nullptr ) );
+        BOOST_TEST_THROWS( get<int>( cv ), bad_variant_access );
+
+        Huge h2 = get<2>( std::move( v ) );
+        BOOST_TEST_EQ( h2.v, 8 );
+    }
+
+    {
+        using V = compact_variant<16, int, Huge>;
+
+        V v1( in_place_type_t<Huge>(), 1 );
+        V v2( in_place_index_t<1>(), 2 );
+        V v3( 3 );
+
+        BOOST_TEST_EQ( visit( G(), v1, v2 ), 12 );
+        BOOST_TEST_EQ( visit( G(), v1, v3 ), -1 );
+
+        BOOST_TEST( v1 != v2 );
+        BOOST_TEST( v1 < v2 );
+        BOOST_TEST( v3 < v1 );
+
+        V v4( v1 );
+
+        BOOST_TEST( v4 == v1 );
+        BOOST_TEST_NE( &get<Huge>( v4 ), &get<Huge>( v1 ) );
+
+        Huge* p = &get<Huge>( v2 );
+
+        V v5( std::move( v2 ) );
+        BOOST_TEST_EQ( &get<Huge>( v5 ), p );
+
+        swap( v1, v3 );
+
+        BOOST_TEST_EQ( get<int>( v1 ), 3 );
+        BOOST_TEST_EQ( get<Huge>( v3 ).v, 1 );
+
+        v3 = v5;
+        BOOST_TEST_EQ( get<Huge>( v3 ).v, 2 );
+
+        BOOST_TEST_EQ( v3.emplace<Huge>( 9 ).v, 9 );
+        BOOST_TEST_EQ( v3.emplace<0>( 4 ), 4 );
+    }
+
+    {
+        using V = basic_compact_variant<32, counting_allocator<void>, std::string, Huge>;
+
+        {
+            V v( Huge( 1 ) );
+
+            BOOST_TEST_EQ( allocations, 1 );
+
+            V v2( v );
+
+            BOOST_TEST_EQ( allocations, 2 );
+
+            V v3( std::move( v2 ) );
+
+            BOOST_TEST_EQ( allocations, 2 );
+
+            v = std::string( "abc" );
+
+            BOOST_TEST_EQ( deallocations, 1 );
+        }
+
+        BOOST_TEST_EQ( allocations, 2 );
+        BOOST_TEST_EQ( deallocations, 2 );
+    }
+
+    {
+        // a moved-from variant remains usable
+
+        using V = compact_variant<16, int, Huge, Big>;
+
+        V v1( Huge( 1 ) );
+        V v2( std::move( v1 ) );
+
+        BOOST_TEST_EQ( v1.index(), 1u );
+        BOOST_TEST_EQ( visit( H(), v1 ), 1000 );
+        BOOST_TEST( v1 == V( Huge() ) );
+        BOOST_TEST_EQ( get<Huge>( static_cast<V const&>( v1 ) ).v, 0 );
+
+        v1 = Huge( 2 );
+
+        BOOST_TEST_EQ( get<Huge>( v1 ).v, 2 );
+        BOOST_TEST_EQ( visit( H(), v1 ), 1002 );
+
+        V v3( std::move( v2 ) );
+
+        visit( F2(), v2 );
+        BOOST_TEST_EQ( get<Huge>( v2 ).v, 1 );
+        BOOST_TEST_EQ( get<Huge>( v3 ).v, 1 );
+
+        // a type that isn't default constructible is moved without
+        // allocating too; the moved-from variant can be assigned to
+
+        BOOST_TEST( std::is_nothrow_move_constructible<V>::value );
+        BOOST_TEST( !V( 1 )._base().uses_double_storage() );
+
+        V v4( Big( 3 ) );
+
+        Big* p = &get<Big>( v4 );
+
+        V v5( std::move( v4 ) );
+
+        BOOST_TEST_EQ( &get<Big>( v5 ), p );
+        BOOST_TEST_EQ( visit( H(), v5 ), 2003 );
+
+        v4 = Big( 4 );
+
+        BOOST_TEST_EQ( visit( H(), v4 ), 2004 );
+        BOOST_TEST( v4 != v5 );
+
+        v5 = std::move( v4 );
+
+        BOOST_TEST_EQ( visit( H(), v5 ), 2004 );
+        BOOST_TEST_EQ( v4.index(), 2u );
+    }
+
+    {
+        // stateful allocators
+
+        using A = arena_allocator<void>;
+        using V = basic_compact_variant<16, A, int, Huge>;
+
+        BOOST_TEST_GT( sizeof( V ), sizeof( compact_variant<16, int, Huge> ) );
+
+        {
+            V v1( std::allocator_arg, A( 1 ), in_place_type_t<Huge>(), 1 );
+            V v2( std::allocator_arg, A( 2 ), 2 );
+
+            BOOST_TEST_EQ( v1.get_allocator().id_, 1 );
+            BOOST_TEST_EQ( v2.get_allocator().id_, 2 );
+
+            BOOST_TEST_EQ( arena_allocations[ 1 ], 1 );
+
+            v2 = Huge( 2 );
+
+            BOOST_TEST_EQ( arena_allocations[ 2 ], 1 );
+
+            v2.emplace<0>( 3 );
+
+            BOOST_TEST_EQ( arena_allocations[ 2 ], 0 );
+
+            // the allocators don't propagate; v2 allocates the copy
+
+            v2 = v1;
+
+            BOOST_TEST_EQ( get<Huge>( v2 ).v, 1 );
+            BOOST_TEST_EQ( arena_allocations[ 1 ], 1 );
+            BOOST_TEST_EQ( arena_allocations[ 2 ], 1 );
+
+            v2 = 4;
+            v2 = std::move( v1 );
+
+            BOOST_TEST_EQ( get<Huge>( v2 ).v, 1 );
+            BOOST_TEST_EQ( arena_allocations[ 2 ], 1 );
+
+            // the copy constructor copies the allocator
+
+            V v3( v2 );
+
+            BOOST_TEST_EQ( v3.get_allocator().id_, 2 );
+            BOOST_TEST_EQ( arena_allocations[ 2 ], 2 );
+
+            // a move takes the node with its allocator
+
+            V v4( std::move( v3 ) );
+
+            BOOST_TEST_EQ( v4.get_allocator().id_, 2 );
+            BOOST_TEST_EQ( arena_allocations[ 2 ], 2 );
+
+            // equal allocators exchange nodes on move assignment
+
+            V v5( std::allocator_arg, A( 2 ), in_place_index_t<1>(), 5 );
+            Huge* p = &get<Huge>( v5 );
+
+            BOOST_TEST_EQ( arena_allocations[ 2 ], 3 );
+
+            v4 = std::move( v5 );
+
+            BOOST_TEST_EQ( &get<Huge>( v4 ), p );
+            BOOST_TEST_EQ( arena_allocations[ 2 ], 2 );
+        }
+
+        BOOST_TEST_EQ( arena_allocations[ 0 ], 0 );
+        BOOST_TEST_EQ( arena_allocations[ 1 ], 0 );
+        BOOST_TEST_EQ( arena_allocations[ 2 ], 0 );
+    }
+
+#if defined(__cpp_lib_memory_resource) && __cpp_lib_memory_resource >= 201603L
+
+    {
+        using V = basic_compact_variant<16, std::pmr::polymorphic_allocator<char>, int, Huge>;
+
+        std::pmr::monotonic_buffer_resource mr;
+
+        std::pmr::memory_resource * old = std::pmr::set_default_resource( std::pmr::null_memory_resource() );
+
+        {
+            V v( std::allocator_arg, &mr, in_place_type_t<Huge>(), 1 );
+
+            BOOST_TEST_EQ( v.get_allocator().resource(), &mr );
+
+            v = 2;
+            v = Huge( 3 );
+
+            V w( std::allocator_arg, &mr, 4 );
+
+            w = std::move( v );
+
+            BOOST_TEST_EQ( get<Huge>( w ).v, 3 );
+        }
+
+        std::pmr::set_default_resource( old );
+    }
+
+#endif
+
+    return boost::report_errors();
+}
@@ -0,0 +1,122 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/algorithm.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <vector>
+#include <string>
+
+using namespace boost::variant2;
+
+struct Y
+{
+    Y( Y&& ) noexcept( false ) {}
+    Y() {}
+};
+
+template<class V> void test( std::vector<V> const& w )
+{
+    std::size_t const N = variant_size<V>::value;
+
+    for( std::size_t n = 0; n <= w.size(); ++n )
+    {
+        std::array<std::size_t, N> c = count_by_index( w.data(), n );
+        std::array<std::vector<std::size_t>, N> p = partition_by_index( w.data(), n );
+
+        std::size_t s = 0;
+
+        for( std::size_t j = 0; j < N; ++j )
+        {
+            std::size_t k = 0;
+
+            for( std::size_t i = 0; i < n; ++i )
+            {
+                if( w[ i ].index() == j )
+                {
+                    BOOST_TEST_LT( k, p[ j ].size() ) && BOOST_TEST_EQ( p[ j ][ k ], i );
+                    ++k;
+                }
+            }
+
+            BOOST_TEST_EQ( c[ j ], k );
+            BOOST_TEST_EQ( p[ j ].size(), k );
+
+            s += c[ j ];
+        }
+
+        BOOST_TEST_EQ( s, n );
+    }
+}
+
+int main()
+{
+    {
+        using V = variant<int, float, std::string>;
+
+        std::vector<V> w;
+
+        for( int i = 0; i < 29; ++i )
+        {
+            switch( i * 7 % 5 )
+            {
+            case 0: w.push_back( i ); break;
+            case 1: case 3: w.push_back( 1.0f ); break;
+            default: w.push_back( "abc" ); break;
+            }
+        }
+
+        test( w );
+    }
+
+    {
+        using V = variant<int>;
+
+        std::vector<V> w( 11 );
+        test( w );
+    }
+
+    {
+        using V = variant<int, Y>;
+
+        V v;
+        BOOST_TEST( v.uses_double_storage() );
+
+        std::vector<V> w( 13 );
+
+        for( std::size_t i = 0; i < w.size(); i += 3 )
+        {
+            w[ i ].emplace<1>();
+        }
+
+        test( w );
+    }
+
+    {
+        variant<int, float> w[ 5 ] = { 1, 2.0f, 3, 4, 5.0f };
+
+        std::array<std::size_t, 2> c = count_by_index( w, 5 );
+
+        BOOST_TEST_EQ( c[ 0 ], 3u );
+        BOOST_TEST_EQ( c[ 1 ], 2u );
+
+#if defined(BOOST_VARIANT2_HAS_SPAN)
+
+        std::span<variant<int, float>> s( w );
+        std::span<variant<int, float> const> cs( w );
+
+        BOOST_TEST( count_by_index( s ) == c );
+        BOOST_TEST( count_by_index( cs ) == c );
+        BOOST_TEST( count_by_index( s.first( 3 ) )[ 0 ] == 2u );
+
+        BOOST_TEST( partition_by_index( s )[ 1 ] == ( std::vector<std::size_t>{ 1, 4 } ) );
+        BOOST_TEST( partition_by_index( cs )[ 0 ] == ( std::vector<std::size_t>{ 0, 2, 3 } ) );
+
+        std::span<variant<int, float>, 5> fs( w );
+        BOOST_TEST( count_by_index( fs ) == c );
+
+#endif
+    }
+
+    return boost::report_errors();
+}
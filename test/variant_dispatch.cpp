@@ -0,0 +1,156 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/mp11.hpp>
+#include <string>
+#include <utility>
+
+using namespace boost::variant2;
+namespace mp11 = boost::mp11;
+
+template<int I> struct Tag
+{
+};
+
+template<int I> using V = variant<int, float, std::string, Tag<I>, long, double, char>;
+
+namespace boost
+{
+namespace variant2
+{
+
+template<> struct variant_dispatch_strategy< V<1> >
+{
+    using type = jump_table_dispatch;
+};
+
+template<> struct variant_dispatch_strategy< V<2> >
+{
+    using type = binary_search_dispatch;
+};
+
+template<> struct variant_dispatch_strategy< V<3> >
+{
+    using type = linear_dispatch<>;
+};
+
+template<> struct variant_dispatch_strategy< V<4> >
+{
+    using type = linear_dispatch<6, 2, 2, 9, 0>;
+};
+
+template<> struct variant_dispatch_strategy< V<5> >
+{
+    using type = linear_dispatch<6, 5, 4, 3, 2, 1, 0>;
+};
+
+} // namespace variant2
+} // namespace boost
+
+template<int I> bool operator==( Tag<I>, Tag<I> ) { return true; }
+template<int I> bool operator!=( Tag<I>, Tag<I> ) { return false; }
+template<int I> bool operator<( Tag<I>, Tag<I> ) { return false; }
+template<int I> bool operator>( Tag<I>, Tag<I> ) { return false; }
+template<int I> bool operator<=( Tag<I>, Tag<I> ) { return true; }
+template<int I> bool operator>=( Tag<I>, Tag<I> ) { return true; }
+template<int I> std::size_t hash_value( Tag<I> ) { return 0; }
+
+struct F
+{
+    std::size_t operator()( int ) const { return 0; }
+    std::size_t operator()( float ) const { return 1; }
+    std::size_t operator()( std::string const& ) const { return 2; }
+    template<int I> std::size_t operator()( Tag<I> ) const { return 3; }
+    std::size_t operator()( long ) const { return 4; }
+    std::size_t operator()( double ) const { return 5; }
+    std::size_t operator()( char ) const { return 6; }
+};
+
+struct G
+{
+    template<class T1, class T2> std::size_t operator()( T1 const& x1, T2 const& x2 ) const
+    {
+        return F()( x1 ) * 10 + F()( x2 );
+    }
+
+    template<class T1, class T2, class T3> std::size_t operator()( T1 const& x1, T2 const& x2, T3 const& x3 ) const
+    {
+        return F()( x1 ) * 100 + F()( x2 ) * 10 + F()( x3 );
+    }
+};
+
+template<int I> void test()
+{
+    using W = V<I>;
+
+    W const v[] = { 1, 2.0f, std::string( "abc" ), Tag<I>(), 3L, 4.0, 'x' };
+
+    for( std::size_t i = 0; i < 7; ++i )
+    {
+        BOOST_TEST_EQ( v[ i ].index(), i );
+        BOOST_TEST_EQ( visit( F(), v[ i ] ), i );
+        BOOST_TEST_EQ( visit_by_index( v[ i ], F(), F(), F(), F(), F(), F(), F() ), i );
+
+        W w( v[ i ] );
+
+        BOOST_TEST_EQ( w.index(), i );
+        BOOST_TEST( w == v[ i ] );
+        BOOST_TEST_NOT( w != v[ i ] );
+        BOOST_TEST( w <= v[ i ] );
+        BOOST_TEST_EQ( boost::hash<W>()( w ), boost::hash<W>()( v[ i ] ) );
+
+        W w2( std::move( w ) );
+
+        BOOST_TEST_EQ( w2.index(), i );
+        BOOST_TEST( w2 == v[ i ] );
+
+        for( std::size_t j = 0; j < 7; ++j )
+        {
+            BOOST_TEST_EQ( visit( G(), v[ i ], v[ j ] ), i * 10 + j );
+            BOOST_TEST_EQ( visit( G(), v[ i ], v[ j ], v[ i ] ), i * 100 + j * 10 + i );
+
+            W w3( v[ j ] );
+
+            w3 = v[ i ];
+            BOOST_TEST( w3 == v[ i ] );
+
+            w3 = v[ j ];
+            w3.swap( w2 );
+
+            BOOST_TEST( w3 == v[ i ] );
+            BOOST_TEST( w2 == v[ j ] );
+
+            w2 = v[ i ];
+
+            BOOST_TEST_EQ( v[ i ] < v[ j ], i < j );
+        }
+    }
+}
+
+int main()
+{
+    BOOST_TEST_TRAIT_SAME( variant_dispatch_strategy< V<0> >::type, BOOST_VARIANT2_DEFAULT_DISPATCH );
+    BOOST_TEST_TRAIT_SAME( variant_dispatch_strategy< V<1> >::type, jump_table_dispatch );
+    BOOST_TEST_TRAIT_SAME( variant_dispatch_strategy< V<2> >::type, binary_search_dispatch );
+    BOOST_TEST_TRAIT_SAME( variant_dispatch_strategy< V<3> >::type, linear_dispatch<> );
+
+    // probe order
+
+    BOOST_TEST_TRAIT_SAME( detail::linear_probe_order< 4, mp11::mp_list<> >, mp11::mp_list<mp11::mp_size_t<0>, mp11::mp_size_t<1>, mp11::mp_size_t<2>, mp11::mp_size_t<3>> );
+    BOOST_TEST_TRAIT_SAME( detail::linear_probe_order< 4, mp11::mp_list<mp11::mp_size_t<2>> >, mp11::mp_list<mp11::mp_size_t<2>, mp11::mp_size_t<0>, mp11::mp_size_t<1>, mp11::mp_size_t<3>> );
+    BOOST_TEST_TRAIT_SAME( detail::linear_probe_order< 4, mp11::mp_list<mp11::mp_size_t<3>, mp11::mp_size_t<7>, mp11::mp_size_t<3>, mp11::mp_size_t<1>> >, mp11::mp_list<mp11::mp_size_t<3>, mp11::mp_size_t<1>, mp11::mp_size_t<0>, mp11::mp_size_t<2>> );
+
+    test<0>();
+    test<1>();
+    test<2>();
+    test<3>();
+    test<4>();
+    test<5>();
+
+    return boost::report_errors();
+}
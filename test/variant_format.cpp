@@ -0,0 +1,113 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#if defined(__has_include)
+# if __has_include(<fmt/format.h>)
+#  define FMT_HEADER_ONLY
+#  include <fmt/format.h>
+# endif
+#endif
+
+#include <boost/variant2/format.hpp>
+#include <boost/config.hpp>
+#include <boost/config/pragma_message.hpp>
+
+#if !( defined(__cpp_lib_format) && __cpp_lib_format >= 201907L ) && !defined(FMT_VERSION)
+
+BOOST_PRAGMA_MESSAGE( "Test skipped because neither <format> nor <fmt/format.h> is available" )
+int main() {}
+
+#else
+
+#include <boost/core/lightweight_test.hpp>
+#include <string>
+
+using namespace boost::variant2;
+
+using V = variant<monostate, int, double, std::string>;
+
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+
+void test_std_format()
+{
+    BOOST_TEST_EQ( std::format( "{}", V() ), std::string( "monostate" ) );
+    BOOST_TEST_EQ( std::format( "{:>11}", V() ), std::string( "  monostate" ) );
+
+    BOOST_TEST_EQ( std::format( "{}", V( 12 ) ), std::string( "12" ) );
+    BOOST_TEST_EQ( std::format( "{:04}", V( 12 ) ), std::string( "0012" ) );
+    BOOST_TEST_EQ( std::format( "{:x}", V( 255 ) ), std::string( "ff" ) );
+
+    BOOST_TEST_EQ( std::format( "{}", V( 2.5 ) ), std::string( "2.5" ) );
+    BOOST_TEST_EQ( std::format( "{:.3f}", V( 2.5 ) ), std::string( "2.500" ) );
+
+    BOOST_TEST_EQ( std::format( "{}", V( "abc" ) ), std::string( "abc" ) );
+    BOOST_TEST_EQ( std::format( "[{:*^7}]", V( "abc" ) ), std::string( "[**abc**]" ) );
+
+    BOOST_TEST_EQ( std::format( "{0}-{0:>3}", V( 1 ) ), std::string( "1-  1" ) );
+
+    // nested replacement fields refer to the arguments of the format string
+    BOOST_TEST_EQ( std::format( "{:{}}", V( 1 ), 5 ), std::string( "    1" ) );
+    BOOST_TEST_EQ( std::format( "{:.{}f}", V( 2.5 ), 2 ), std::string( "2.50" ) );
+    BOOST_TEST_EQ( std::format( "{:{}.{}f}|{}", V( 2.5 ), 6, 1, V( 3 ) ), std::string( "   2.5|3" ) );
+    BOOST_TEST_EQ( std::format( "{0:{1}}", V( 7 ), 3 ), std::string( "  7" ) );
+
+    BOOST_TEST( std::format( L"{:>4}", variant<monostate, int>( 7 ) ) == L"   7" );
+}
+
+#endif
+
+#if defined(FMT_VERSION)
+
+void test_fmt_format()
+{
+    BOOST_TEST_EQ( fmt::format( "{}", V() ), std::string( "monostate" ) );
+    BOOST_TEST_EQ( fmt::format( "{:>11}", V() ), std::string( "  monostate" ) );
+
+    BOOST_TEST_EQ( fmt::format( "{}", V( 12 ) ), std::string( "12" ) );
+    BOOST_TEST_EQ( fmt::format( "{:04}", V( 12 ) ), std::string( "0012" ) );
+    BOOST_TEST_EQ( fmt::format( "{:x}", V( 255 ) ), std::string( "ff" ) );
+
+    BOOST_TEST_EQ( fmt::format( "{}", V( 2.5 ) ), std::string( "2.5" ) );
+    BOOST_TEST_EQ( fmt::format( "{:.3f}", V( 2.5 ) ), std::string( "2.500" ) );
+
+    BOOST_TEST_EQ( fmt::format( "{}", V( "abc" ) ), std::string( "abc" ) );
+    BOOST_TEST_EQ( fmt::format( "[{:*^7}]", V( "abc" ) ), std::string( "[**abc**]" ) );
+
+    BOOST_TEST_EQ( fmt::format( "{0}-{0:>3}", V( 1 ) ), std::string( "1-  1" ) );
+
+    // nested replacement fields refer to the arguments of the format string
+    BOOST_TEST_EQ( fmt::format( "{:{}}", V( 1 ), 5 ), std::string( "    1" ) );
+    BOOST_TEST_EQ( fmt::format( "{:.{}f}", V( 2.5 ), 2 ), std::string( "2.50" ) );
+    BOOST_TEST_EQ( fmt::format( "{:{}.{}f}|{}", V( 2.5 ), 6, 1, V( 3 ) ), std::string( "   2.5|3" ) );
+    BOOST_TEST_EQ( fmt::format( "{0:{1}}", V( 7 ), 3 ), std::string( "  7" ) );
+    BOOST_TEST_EQ( fmt::format( "{:>{}}", variant<V, char>( V( 5 ) ), 4 ), std::string( "   5" ) );
+
+    // nested variants forward the specification again
+    BOOST_TEST_EQ( fmt::format( "{:>3}", variant<V, char>( V( 5 ) ) ), std::string( "  5" ) );
+
+    std::string s;
+    fmt::format_to( std::back_inserter( s ), "{} {}", V( 1 ), V( "x" ) );
+    BOOST_TEST_EQ( s, std::string( "1 x" ) );
+}
+
+#endif
+
+int main()
+{
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+
+    test_std_format();
+
+#endif
+
+#if defined(FMT_VERSION)
+
+    test_fmt_format();
+
+#endif
+
+    return boost::report_errors();
+}
+
+#endif
@@ -0,0 +1,236 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/json_reader.hpp>
+#include <boost/variant2/json_writer.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/value_to.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <string>
+#include <vector>
+#include <limits>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+using namespace boost::variant2;
+namespace json = boost::json;
+
+struct P
+{
+    int x, y;
+};
+
+inline bool operator==( P const& p1, P const& p2 )
+{
+    return p1.x == p2.x && p1.y == p2.y;
+}
+
+json::result_for<P, json::value>::type tag_invoke( json::try_value_to_tag<P> const&, json::value const& v )
+{
+    static constexpr boost::source_location loc = BOOST_CURRENT_LOCATION;
+    auto r = json::result_from_errno<P>( EINVAL, &loc );
+
+    if( auto const* obj = v.if_object() )
+    {
+        auto ix = obj->find( "x" );
+        auto iy = obj->find( "y" );
+
+        if( ix != obj->end() && iy != obj->end() )
+        {
+            auto x = json::try_value_to<int>( ix->value() );
+            auto y = json::try_value_to<int>( iy->value() );
+
+            if( x && y ) r.emplace( P{ *x, *y } );
+        }
+    }
+
+    return r;
+}
+
+template<class V> bool from_json( char const* s, V& v )
+{
+    char const* last = s + std::strlen( s );
+    return read_json( s, last, v ) == last;
+}
+
+// read_json agrees with try_value_to on a parsed json::value
+
+template<class V> void test_equivalent( char const* s )
+{
+    V v1;
+    bool r1 = from_json( s, v1 );
+
+    auto r2 = json::try_value_to<V>( json::parse( s ) );
+
+    BOOST_TEST_EQ( r1, r2.has_value() );
+
+    if( r1 && r2.has_value() )
+    {
+        BOOST_TEST( v1 == *r2 );
+    }
+}
+
+template<class V> V parse( char const* s )
+{
+    V v;
+    BOOST_TEST( from_json( s, v ) );
+    return v;
+}
+
+int main()
+{
+    {
+        // the cases of variant_json_value_to.cpp
+
+        using V = variant<monostate, int, std::string>;
+
+        test_equivalent<V>( "null" );
+        test_equivalent<V>( "12" );
+        test_equivalent<V>( "\"test\"" );
+
+        BOOST_TEST( parse<V>( "null" ) == V() );
+        BOOST_TEST( parse<V>( "12" ) == V( 12 ) );
+        BOOST_TEST( parse<V>( "\"test\"" ) == V( "test" ) );
+
+        test_equivalent<V>( "true" );
+        test_equivalent<V>( "1.5" );
+        test_equivalent<V>( "[]" );
+        test_equivalent<V>( "{}" );
+    }
+
+    {
+        using V = variant<monostate, bool, int, std::uint64_t, double, std::string>;
+
+        char const* cases[] = {
+            " true ", "false", "-5", "4294967296", "18446744073709551615",
+            "2.0", "2.5", "-1.25e2", "1e-3", "-18446744073709551616",
+            "\"a\\\"b\\\\c\\n\\u00e9\\ud83d\\ude00\"", "\"a long string, read in parts\""
+        };
+
+        for( char const* s: cases )
+        {
+            test_equivalent<V>( s );
+        }
+
+        // too large for int
+        BOOST_TEST( parse<V>( "4294967296" ) == V( std::uint64_t( 4294967296u ) ) );
+
+        // an exact integer in floating point form goes to the first integral alternative
+        BOOST_TEST( parse<V>( "2.0" ) == V( 2 ) );
+        BOOST_TEST( parse<V>( "2.5" ) == V( 2.5 ) );
+
+        BOOST_TEST( parse<V>( "\"a\\\"b\\\\c\\n\\u00e9\\ud83d\\ude00\"" ) == V( std::string( "a\"b\\c\n\xC3\xA9\xF0\x9F\x98\x80" ) ) );
+    }
+
+    {
+        // nested vectors of variants, read as the elements arrive
+
+        using E = variant<int, std::string, std::vector<int>>;
+        using V = variant<monostate, std::vector<E>>;
+
+        char const* s = "[ 1, \"two\", [3, 4], [] ]";
+
+        test_equivalent<V>( s );
+
+        V v = parse<V>( s );
+
+        BOOST_TEST_EQ( v.index(), 1u );
+
+        std::vector<E> const& w = get<1>( v );
+
+        BOOST_TEST_EQ( w.size(), 4u );
+
+        BOOST_TEST( w[ 0 ] == E( 1 ) );
+        BOOST_TEST( w[ 1 ] == E( "two" ) );
+        BOOST_TEST( w[ 2 ] == E( std::vector<int>{ 3, 4 } ) );
+        BOOST_TEST( w[ 3 ] == E( std::vector<int>() ) );
+
+        test_equivalent<V>( "[ 1, [ \"x\" ] ]" );
+    }
+
+    {
+        // several alternatives that take arrays are tried in order
+
+        using V = variant<std::vector<int>, std::vector<std::string>>;
+
+        test_equivalent<V>( "[ 1, 2 ]" );
+        test_equivalent<V>( "[ \"a\", \"b\" ]" );
+        test_equivalent<V>( "[ 1, \"b\" ]" );
+
+        BOOST_TEST( parse<V>( "[ \"a\" ]" ) == V( std::vector<std::string>{ "a" } ) );
+    }
+
+    {
+        // user-defined alternatives go through their conversions
+
+        using V = variant<int, P>;
+
+        char const* cases[] = {
+            "{ \"y\": 2, \"z\": [ 1, { \"a\": null } ], \"x\": 1 }", "7", "{ \"x\": 1 }", "[ 1, 2 ]", "null"
+        };
+
+        for( char const* s: cases )
+        {
+            test_equivalent<V>( s );
+        }
+
+        BOOST_TEST( parse<V>( "{ \"y\": 2, \"z\": [ 1, { \"a\": null } ], \"x\": 1 }" ) == V( P{ 1, 2 } ) );
+        BOOST_TEST( parse<V>( "7" ) == V( 7 ) );
+
+        using W = variant<monostate, std::vector<P>>;
+
+        test_equivalent<W>( "[ { \"x\": 1, \"y\": 2 }, { \"y\": 4, \"x\": 3 } ]" );
+        BOOST_TEST( parse<W>( "[ { \"x\": 1, \"y\": 2 } ]" ) == W( std::vector<P>{ P{ 1, 2 } } ) );
+    }
+
+    {
+        // round trip through write_json
+
+        using V = variant<monostate, bool, long long, double, std::string, std::vector<variant<int, std::string>>>;
+
+        V vs[] = { V(), V( true ), V( -7ll ), V( 0.1 ), V( std::string( "x\ty" ) ), V( std::vector<variant<int, std::string>>{ 1, "a" } ) };
+
+        for( V const& v: vs )
+        {
+            std::string s;
+            write_json( s, v );
+
+            V w;
+
+            BOOST_TEST( from_json( s.c_str(), w ) );
+            BOOST_TEST( w == v );
+
+            test_equivalent<V>( s.c_str() );
+        }
+    }
+
+    {
+        // errors
+
+        using V = variant<monostate, int, std::string, std::vector<int>>;
+
+        // not JSON
+        char const* bad[] = { "", "nul", "tru", "01x", "-", "1.", "1e", "\"abc", "\"\\x\"", "\"\\ud800\"", "[1,]", "[,1]", "[1 2]" };
+
+        for( char const* s: bad )
+        {
+            V v;
+            BOOST_TEST( !from_json( s, v ) );
+        }
+
+        // not convertible to V
+        char const* bad2[] = { "true", "{}", "1.5", "99999999999", "[1,\"a\"]" };
+
+        for( char const* s: bad2 )
+        {
+            V v;
+            BOOST_TEST( !from_json( s, v ) );
+
+            test_equivalent<V>( s );
+        }
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,155 @@
+// Copyright 2026 Peter Dimov
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_GCC) && BOOST_GCC < 50000
+# define BOOST_ALLOW_DEPRECATED
+#endif
+
+#include <boost/variant2/variant.hpp>
+#include <boost/json/value_to.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <string>
+#include <cerrno>
+
+using namespace boost::variant2;
+namespace json = boost::json;
+
+static int conversions;
+
+struct A
+{
+    int x;
+};
+
+struct B
+{
+    int y;
+};
+
+inline bool operator==( A const& a1, A const& a2 ) { return a1.x == a2.x; }
+inline bool operator==( B const& b1, B const& b2 ) { return b1.y == b2.y; }
+
+template<class T> typename json::result_for<T, json::value>::type from_field( json::value const& v, char const* name )
+{
+    ++conversions;
+
+    if( json::object const* obj = v.if_object() )
+    {
+        auto it = obj->find( name );
+
+        if( it != obj->end() && it->value().is_int64() )
+        {
+            return T{ static_cast<int>( it->value().get_int64() ) };
+        }
+    }
+
+    static constexpr boost::source_location loc = BOOST_CURRENT_LOCATION;
+    return json::result_from_errno<T>( EINVAL, &loc );
+}
+
+json::result_for<A, json::value>::type tag_invoke( json::try_value_to_tag<A> const&, json::value const& v )
+{
+    return from_field<A>( v, "x" );
+}
+
+json::result_for<B, json::value>::type tag_invoke( json::try_value_to_tag<B> const&, json::value const& v )
+{
+    return from_field<B>( v, "y" );
+}
+
+using W = variant<A, B, double>;
+
+namespace boost
+{
+namespace variant2
+{
+
+template<> struct variant_json_discriminator<W>
+{
+    static constexpr char const* key = "type";
+
+    static std::size_t index( json::string_view name ) noexcept
+    {
+        return name == "a"? 0: name == "b"? 1: static_cast<std::size_t>( -1 );
+    }
+};
+
+} // namespace variant2
+} // namespace boost
+
+int main()
+{
+    {
+        // alternatives that can't be converted from the kind of the value are skipped
+
+        using V = variant<monostate, bool, std::string, int, A>;
+
+        conversions = 0;
+
+        {
+            auto r = json::try_value_to<V>( json::value( 5 ) );
+            BOOST_TEST( r.has_value() ) && BOOST_TEST( *r == V( 5 ) );
+        }
+
+        {
+            auto r = json::try_value_to<V>( json::value( "test" ) );
+            BOOST_TEST( r.has_value() ) && BOOST_TEST( *r == V( std::string( "test" ) ) );
+        }
+
+        {
+            auto r = json::try_value_to<V>( json::value( true ) );
+            BOOST_TEST( r.has_value() ) && BOOST_TEST( *r == V( true ) );
+        }
+
+        {
+            auto r = json::try_value_to<V>( json::value() );
+            BOOST_TEST( r.has_value() ) && BOOST_TEST( *r == V() );
+        }
+
+        // int is tried before A for numbers
+        BOOST_TEST_EQ( conversions, 0 );
+
+        {
+            auto r = json::try_value_to<V>( json::parse( R"({"x":1})" ) );
+            BOOST_TEST( r.has_value() ) && BOOST_TEST( *r == V( A{ 1 } ) );
+        }
+
+        BOOST_TEST_EQ( conversions, 1 );
+    }
+
+    {
+        // a discriminator field selects the alternative
+
+        conversions = 0;
+
+        {
+            auto r = json::try_value_to<W>( json::parse( R"({"type":"b","x":1,"y":2})" ) );
+            BOOST_TEST( r.has_value() ) && BOOST_TEST( *r == W( B{ 2 } ) );
+        }
+
+        BOOST_TEST_EQ( conversions, 1 );
+
+        {
+            auto r = json::try_value_to<W>( json::parse( R"({"type":"a","y":2})" ) );
+            BOOST_TEST( r.has_error() );
+        }
+
+        // without it, the alternatives are tried in order
+
+        {
+            auto r = json::try_value_to<W>( json::parse( R"({"x":1,"y":2})" ) );
+            BOOST_TEST( r.has_value() ) && BOOST_TEST( *r == W( A{ 1 } ) );
+        }
+
+        {
+            auto r = json::try_value_to<W>( json::value( 1.5 ) );
+            BOOST_TEST( r.has_value() ) && BOOST_TEST( *r == W( 1.5 ) );
+        }
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,109 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/json_writer.hpp>
+#include <boost/json/value_from.hpp>
+#include <boost/json/serialize.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <limits>
+#include <cstdint>
+
+using namespace boost::variant2;
+
+struct P
+{
+    int x, y;
+};
+
+void tag_invoke( boost::json::value_from_tag const&, boost::json::value& v, P const& p )
+{
+    v = { { "x", p.x }, { "y", p.y } };
+}
+
+template<class V> std::string to_json( V const& v )
+{
+    std::string s;
+    write_json( s, v );
+    return s;
+}
+
+int main()
+{
+    using V = variant<monostate, bool, int, std::uint64_t, double, std::string, std::vector<int>, P>;
+
+    BOOST_TEST_EQ( to_json( V() ), "null" );
+    BOOST_TEST_EQ( to_json( V( true ) ), "true" );
+    BOOST_TEST_EQ( to_json( V( false ) ), "false" );
+
+    BOOST_TEST_EQ( to_json( V( 0 ) ), "0" );
+    BOOST_TEST_EQ( to_json( V( -125 ) ), "-125" );
+    BOOST_TEST_EQ( to_json( V( ( std::numeric_limits<int>::min )() ) ), "-2147483648" );
+    BOOST_TEST_EQ( to_json( V( ( std::numeric_limits<std::uint64_t>::max )() ) ), "18446744073709551615" );
+
+    BOOST_TEST_EQ( to_json( V( 0.5 ) ), "0.5" );
+    BOOST_TEST_EQ( to_json( V( 0.1 ) ), "0.1" );
+    BOOST_TEST_EQ( to_json( V( -2.0 ) ), "-2" );
+    BOOST_TEST_EQ( to_json( V( 1e300 ) ), "1e+300" );
+    BOOST_TEST_EQ( to_json( V( 0.1 + 0.2 ) ), "0.30000000000000004" );
+    BOOST_TEST_EQ( to_json( V( std::numeric_limits<double>::infinity() ) ), "1e99999" );
+    BOOST_TEST_EQ( to_json( V( std::numeric_limits<double>::quiet_NaN() ) ), "null" );
+
+    BOOST_TEST_EQ( to_json( V( std::string( "abc" ) ) ), "\"abc\"" );
+    BOOST_TEST_EQ( to_json( V( std::string( "a\"b\\c\n\x01" ) ) ), "\"a\\\"b\\\\c\\n\\u0001\"" );
+    BOOST_TEST_EQ( to_json( V( std::string( "\xC3\xA9" ) ) ), "\"\xC3\xA9\"" );
+
+    BOOST_TEST_EQ( to_json( V( std::vector<int>{ 1, 2, 3 } ) ), "[1,2,3]" );
+    BOOST_TEST_EQ( to_json( V( std::vector<int>() ) ), "[]" );
+
+    BOOST_TEST_EQ( to_json( V( P{ 1, -2 } ) ), "{\"x\":1,\"y\":-2}" );
+
+    {
+        // the alternatives without a direct representation go through value_from
+
+        using W = variant<std::map<std::string, int>, std::pair<int, std::string>, std::vector<P>>;
+
+        BOOST_TEST_EQ( to_json( W( std::map<std::string, int>{ { "a", 1 }, { "b", 2 } } ) ), "{\"a\":1,\"b\":2}" );
+        BOOST_TEST_EQ( to_json( W( std::make_pair( 1, std::string( "x" ) ) ) ), "[1,\"x\"]" );
+        BOOST_TEST_EQ( to_json( W( std::vector<P>{ P{ 1, 2 }, P{ 3, 4 } } ) ), "[{\"x\":1,\"y\":2},{\"x\":3,\"y\":4}]" );
+    }
+
+    {
+        // nested variants, appended to the output
+
+        using W = variant<int, variant<std::string, monostate>>;
+
+        std::string s( "[" );
+
+        write_json( s, W( 5 ) );
+        s += ',';
+        write_json( s, W( variant<std::string, monostate>( "x" ) ) );
+        s += ']';
+
+        BOOST_TEST_EQ( s, "[5,\"x\"]" );
+    }
+
+    {
+        // fixed buffer
+
+        V v( std::string( "hello" ) );
+
+        char buffer[ 16 ] = {};
+
+        BOOST_TEST_EQ( write_json( buffer, sizeof( buffer ), v ), 7u );
+        BOOST_TEST_EQ( std::string( buffer, 7 ), "\"hello\"" );
+
+        char small[ 4 ] = {};
+
+        BOOST_TEST_EQ( write_json( small, sizeof( small ), v ), 7u );
+        BOOST_TEST_EQ( std::string( small, 4 ), "\"hel" );
+
+        BOOST_TEST_EQ( write_json( nullptr, 0, v ), 7u );
+    }
+
+    return boost::report_errors();
+}
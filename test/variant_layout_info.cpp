@@ -0,0 +1,86 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <string>
+#include <cstddef>
+
+using namespace boost::variant2;
+
+struct X
+{
+    X( X&& ) {}
+};
+
+template<class V> void test_invariants()
+{
+    using L = variant_layout_info<V>;
+
+    BOOST_TEST_EQ( L::size, sizeof( V ) );
+    BOOST_TEST_EQ( L::alignment, alignof( V ) );
+    BOOST_TEST_EQ( L::alternatives, variant_size<V>::value );
+    BOOST_TEST_EQ( L::uses_double_storage, V::uses_double_storage() );
+
+    BOOST_TEST_GE( L::size, L::max_alternative_size );
+    BOOST_TEST_EQ( L::overhead, L::size - L::max_alternative_size );
+    BOOST_TEST_EQ( L::size, L::storage_size + L::index_size + L::padding );
+
+    BOOST_TEST_EQ( L::uses_double_storage? L::storage_size >= 2 * L::max_alternative_size: L::storage_size >= L::max_alternative_size, true );
+
+    BOOST_TEST_EQ( variant_layout_info<V const>::size, L::size );
+}
+
+int main()
+{
+    {
+        using V = variant<char, int, double>;
+        using L = variant_layout_info<V>;
+
+        test_invariants<V>();
+
+        BOOST_TEST_EQ( L::alternatives, 3u );
+
+        BOOST_TEST_EQ( L::alternative_size( 0 ), sizeof( char ) );
+        BOOST_TEST_EQ( L::alternative_size( 1 ), sizeof( int ) );
+        BOOST_TEST_EQ( L::alternative_size( 2 ), sizeof( double ) );
+
+        BOOST_TEST_EQ( L::alternative_alignment( 0 ), alignof( char ) );
+        BOOST_TEST_EQ( L::alternative_alignment( 2 ), alignof( double ) );
+
+        BOOST_TEST_EQ( L::max_alternative_size, sizeof( double ) );
+        BOOST_TEST_EQ( L::max_alternative_alignment, alignof( double ) );
+
+        BOOST_TEST( !L::uses_double_storage );
+        BOOST_TEST_EQ( L::index_size, 1u );
+        BOOST_TEST_EQ( L::storage_size, sizeof( double ) );
+        BOOST_TEST_EQ( L::padding, alignof( double ) - 1 );
+    }
+
+    {
+        using V = variant<int, X>;
+        using L = variant_layout_info<V>;
+
+        test_invariants<V>();
+
+        BOOST_TEST( L::uses_double_storage );
+        BOOST_TEST_EQ( L::storage_size, 2 * sizeof( int ) );
+    }
+
+    test_invariants<variant<monostate, std::string, float>>();
+    test_invariants<variant<int>>();
+
+    {
+        // usable in constant expressions
+
+        using L = variant_layout_info<variant<int, float>>;
+
+        static_assert( L::size == sizeof( variant<int, float> ), "size" );
+        static_assert( L::alternative_size( 1 ) == sizeof( float ), "alternative_size" );
+
+        static_assert( variant_size_budget<variant<int, float>, 8>::value, "variant_size_budget" );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,233 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/mailbox.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace boost::variant2;
+
+struct X
+{
+    static int instances;
+
+    int v;
+
+    explicit X( int v ): v( v )
+    {
+        if( v < 0 ) throw std::runtime_error( "X" );
+        ++instances;
+    }
+
+    X( X const& r ): v( r.v )
+    {
+        ++instances;
+    }
+
+    ~X()
+    {
+        --instances;
+    }
+};
+
+int X::instances = 0;
+
+struct H
+{
+    std::string log;
+    int runs = 0;
+    std::size_t last = static_cast<std::size_t>( -1 );
+
+    void note( std::size_t i )
+    {
+        if( i != last ) ++runs;
+        last = i;
+    }
+
+    void operator()( int x ) { note( 0 ); log += "i" + std::to_string( x ); }
+    void operator()( std::string&& s ) { note( 1 ); log += "s" + s; }
+    void operator()( X const& x ) { note( 2 ); log += "x" + std::to_string( x.v ); }
+};
+
+// throws on X( 2 ) when fail is set
+
+struct H2
+{
+    int sum = 0;
+    bool fail = false;
+
+    void operator()( int x ) { sum += x; }
+
+    void operator()( X const& x )
+    {
+        if( fail && x.v == 2 ) throw std::runtime_error( "H2" );
+        sum += x.v * 1000;
+    }
+};
+
+struct Msg
+{
+    int producer;
+    int seq;
+};
+
+int main()
+{
+    {
+        mailbox<int, std::string, X> mb( 5 );
+
+        BOOST_TEST_EQ( mb.capacity(), 8u );
+        BOOST_TEST( mb.empty() );
+
+        BOOST_TEST( mb.try_push( 1 ) );
+        BOOST_TEST( mb.try_push( 2 ) );
+        BOOST_TEST( mb.try_push( std::string( "a" ) ) );
+        BOOST_TEST( mb.try_emplace<X>( 3 ) );
+        BOOST_TEST( mb.try_emplace<2>( 4 ) );
+        BOOST_TEST( mb.try_push( 5 ) );
+        BOOST_TEST( mb.try_push( variant<int, std::string, X>( "b" ) ) );
+        BOOST_TEST( mb.try_emplace<1>( 2, 'c' ) );
+
+        // full
+        BOOST_TEST( !mb.try_push( 9 ) );
+
+        BOOST_TEST_EQ( X::instances, 2 );
+
+        H h;
+
+        BOOST_TEST_EQ( mb.drain( h, 3 ), 3u );
+        BOOST_TEST_EQ( h.log, std::string( "i1i2sa" ) );
+
+        BOOST_TEST_EQ( mb.drain( h ), 5u );
+        BOOST_TEST_EQ( h.log, std::string( "i1i2sax3x4i5sbscc" ) );
+
+        // int, string, X, int, string
+        BOOST_TEST_EQ( h.runs, 5 );
+
+        BOOST_TEST_EQ( X::instances, 0 );
+        BOOST_TEST( mb.empty() );
+        BOOST_TEST_EQ( mb.drain( h ), 0u );
+
+        // wraps around
+        for( int i = 0; i < 20; ++i )
+        {
+            BOOST_TEST( mb.try_push( i ) );
+            BOOST_TEST_EQ( mb.drain( h ), 1u );
+        }
+
+        BOOST_TEST_EQ( h.runs, 6 );
+    }
+
+    {
+        // a message whose construction throws is skipped
+
+        mailbox<int, X> mb( 4 );
+
+        BOOST_TEST( mb.try_push( 1 ) );
+        BOOST_TEST_THROWS( mb.try_emplace<X>( -1 ), std::runtime_error );
+        BOOST_TEST( mb.try_emplace<X>( 2 ) );
+
+        H2 h;
+
+        BOOST_TEST_EQ( mb.drain( h ), 2u );
+        BOOST_TEST_EQ( h.sum, 2001 );
+        BOOST_TEST_EQ( X::instances, 0 );
+    }
+
+    {
+        // a throwing handler consumes its message
+
+        mailbox<int, X> mb( 4 );
+
+        mb.try_push( 1 );
+        mb.try_emplace<X>( 2 );
+        mb.try_emplace<X>( 3 );
+
+        H2 h;
+        h.fail = true;
+
+        BOOST_TEST_THROWS( mb.drain( h ), std::runtime_error );
+        BOOST_TEST_EQ( h.sum, 1 );
+        BOOST_TEST_EQ( X::instances, 1 );
+
+        BOOST_TEST_EQ( mb.drain( h ), 1u );
+        BOOST_TEST_EQ( h.sum, 3001 );
+        BOOST_TEST_EQ( X::instances, 0 );
+    }
+
+    {
+        // messages left in the mailbox are destroyed with it
+
+        {
+            mailbox<std::string, X> mb( 4 );
+
+            mb.try_emplace<X>( 1 );
+            mb.try_push( std::string( "abc" ) );
+        }
+
+        BOOST_TEST_EQ( X::instances, 0 );
+    }
+
+    {
+        // several producers
+
+        int const N = 4;
+        int const M = 20000;
+
+        mailbox<Msg, std::string> mb( 256 );
+
+        std::vector<std::thread> th;
+
+        for( int i = 0; i < N; ++i )
+        {
+            th.emplace_back( [&, i]{
+
+                for( int j = 0; j < M; ++j )
+                {
+                    while( !mb.try_push( Msg{ i, j } ) )
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        std::vector<int> next( N );
+
+        int received = 0;
+        int errors = 0;
+
+        struct handler
+        {
+            std::vector<int>& next;
+            int& errors;
+
+            void operator()( Msg const& m ) const
+            {
+                // the messages of each producer arrive in order
+                if( m.seq != next[ m.producer ]++ ) ++errors;
+            }
+
+            void operator()( std::string const& ) const
+            {
+                ++errors;
+            }
+        };
+
+        while( received < N * M )
+        {
+            received += static_cast<int>( mb.drain( handler{ next, errors } ) );
+        }
+
+        for( auto& t: th ) t.join();
+
+        BOOST_TEST_EQ( errors, 0 );
+        BOOST_TEST( mb.empty() );
+    }
+
+    return boost::report_errors();
+}
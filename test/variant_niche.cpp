@@ -0,0 +1,223 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_VARIANT2_ENABLE_NICHE
+
+#include <boost/variant2/variant.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <string>
+#include <cstdint>
+
+using namespace boost::variant2;
+
+struct A {};
+struct B {};
+
+bool operator==( A, A ) { return true; }
+bool operator!=( A, A ) { return false; }
+bool operator<( A, A ) { return false; }
+
+bool operator==( B, B ) { return true; }
+bool operator!=( B, B ) { return false; }
+bool operator<( B, B ) { return false; }
+
+enum class E: unsigned char { red, green, blue };
+
+namespace boost
+{
+namespace variant2
+{
+
+template<> struct niche_traits<E>: niche_enum_traits<E, E::blue>
+{
+};
+
+} // namespace variant2
+} // namespace boost
+
+struct W
+{
+    int v;
+};
+
+bool operator==( W const& w1, W const& w2 )
+{
+    return w1.v == w2.v;
+}
+
+namespace boost
+{
+namespace variant2
+{
+
+// negative values of v are never used
+
+template<> struct niche_traits<W>
+{
+    static constexpr std::size_t count = 8;
+
+    static void store( void * p, std::size_t n ) noexcept
+    {
+        int v = -1 - static_cast<int>( n );
+        std::memcpy( p, &v, sizeof(v) );
+    }
+
+    static std::size_t load( void const * p ) noexcept
+    {
+        int v;
+        std::memcpy( &v, p, sizeof(v) );
+
+        return v < 0? static_cast<std::size_t>( -1 - v ): 8;
+    }
+};
+
+} // namespace variant2
+} // namespace boost
+
+struct F
+{
+    int operator()( monostate ) const { return 0; }
+    int operator()( A ) const { return 1; }
+    int operator()( B ) const { return 2; }
+    int operator()( int* p ) const { return p? 10 + *p: 3; }
+};
+
+struct Incomplete;
+
+// Complete is completed after the layout of VC is fixed
+
+struct Complete;
+
+using VC = variant<monostate, Complete*>;
+
+static_assert( sizeof( VC ) == sizeof( Complete* ), "the layout of VC must not depend on the completeness of Complete" );
+
+struct Complete
+{
+    long x;
+};
+
+int main()
+{
+    // sizes
+
+    BOOST_TEST_EQ( sizeof( variant<monostate, int*> ), sizeof( int* ) );
+    BOOST_TEST_EQ( sizeof( variant<int*, monostate> ), sizeof( int* ) );
+    BOOST_TEST_EQ( sizeof( variant<monostate, A, int*, B> ), sizeof( int* ) );
+    BOOST_TEST_EQ( sizeof( variant<monostate, bool> ), 1u );
+    BOOST_TEST_EQ( sizeof( variant<monostate, E> ), 1u );
+    BOOST_TEST_EQ( sizeof( variant<monostate, W> ), sizeof( int ) );
+
+    // the spare values of a pointer don't depend on the pointee, which may be incomplete
+
+    BOOST_TEST_EQ( sizeof( variant<monostate, char*> ), sizeof( char* ) );
+    BOOST_TEST_EQ( sizeof( variant<monostate, A, B, std::uint16_t*> ), sizeof( std::uint16_t* ) );
+    BOOST_TEST_EQ( sizeof( variant<monostate, Incomplete*> ), sizeof( Incomplete* ) );
+    BOOST_TEST_EQ( sizeof( variant<monostate, Incomplete const*> ), sizeof( variant<monostate, Complete const*> ) );
+    BOOST_TEST_EQ( sizeof( VC ), sizeof( Complete* ) );
+
+    // no spare values, more than one alternative with data, or too few spare values
+
+    BOOST_TEST_GT( sizeof( variant<monostate, void(*)()> ), sizeof( void(*)() ) );
+    BOOST_TEST_GT( sizeof( variant<int*, long*> ), sizeof( int* ) );
+    BOOST_TEST_GT( sizeof( variant<monostate, std::string> ), sizeof( std::string ) );
+
+    {
+        using V = variant<monostate, A, int*, B>;
+
+        int x = 5;
+
+        V v;
+        BOOST_TEST_EQ( v.index(), 0u );
+        BOOST_TEST_EQ( visit( F(), v ), 0 );
+
+        v = &x;
+        BOOST_TEST_EQ( v.index(), 2u );
+        BOOST_TEST_EQ( get<2>( v ), &x );
+        BOOST_TEST_EQ( visit( F(), v ), 15 );
+
+        v = B();
+        BOOST_TEST_EQ( v.index(), 3u );
+        BOOST_TEST_EQ( visit( F(), v ), 2 );
+
+        v.emplace<A>();
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST( holds_alternative<A>( v ) );
+
+        v.emplace<int*>( nullptr );
+        BOOST_TEST_EQ( v.index(), 2u );
+        BOOST_TEST_EQ( get<int*>( v ), static_cast<int*>( nullptr ) );
+        BOOST_TEST_EQ( visit( F(), v ), 3 );
+
+        V v2( v );
+        BOOST_TEST_EQ( v2.index(), 2u );
+        BOOST_TEST( v2 == v );
+
+        v2 = V( in_place_index_t<1>() );
+        BOOST_TEST_EQ( v2.index(), 1u );
+        BOOST_TEST( v2 != v );
+        BOOST_TEST( v2 < v );
+
+        v = v2;
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST( v2 == v );
+
+        swap( v, v2 );
+        BOOST_TEST_EQ( v.index(), 1u );
+
+        variant<int*, B> v3( B{} );
+        V v4( v3 );
+        BOOST_TEST_EQ( v4.index(), 3u );
+    }
+
+    {
+        using V = variant<monostate, bool>;
+
+        V v( false );
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST_EQ( get<1>( v ), false );
+
+        v = true;
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST_EQ( get<1>( v ), true );
+
+        v = monostate();
+        BOOST_TEST_EQ( v.index(), 0u );
+    }
+
+    {
+        using V = variant<E, A, B>;
+
+        V v;
+        BOOST_TEST_EQ( v.index(), 0u );
+        BOOST_TEST( get<0>( v ) == E::red );
+
+        v = E::blue;
+        BOOST_TEST_EQ( v.index(), 0u );
+        BOOST_TEST( get<0>( v ) == E::blue );
+
+        v = B();
+        BOOST_TEST_EQ( v.index(), 2u );
+
+        v = A();
+        BOOST_TEST_EQ( v.index(), 1u );
+    }
+
+    {
+        using V = variant<monostate, W>;
+
+        V v( W{ 7 } );
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST_EQ( get<1>( v ).v, 7 );
+
+        v = monostate();
+        BOOST_TEST_EQ( v.index(), 0u );
+
+        v = W{ 0 };
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST( v == V( W{ 0 } ) );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,170 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/parallel.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace boost::variant2;
+
+using V = variant<int, double, std::string>;
+
+struct count_F
+{
+    std::atomic<long long>* counts;
+
+    void operator()( int const& ) const { ++counts[ 0 ]; }
+    void operator()( double const& ) const { ++counts[ 1 ]; }
+    void operator()( std::string const& ) const { ++counts[ 2 ]; }
+};
+
+struct increment_F
+{
+    void operator()( int& x ) const { ++x; }
+    void operator()( double& x ) const { x *= 2; }
+    void operator()( std::string& s ) const { s += '!'; }
+};
+
+struct size_F
+{
+    long long operator()( int x ) const { return x; }
+    long long operator()( double x ) const { return static_cast<long long>( x ); }
+    long long operator()( std::string const& s ) const { return static_cast<long long>( s.size() ); }
+};
+
+struct plus_Op
+{
+    long long operator()( long long x, long long y ) const { return x + y; }
+};
+
+struct throw_F
+{
+    template<class T> void operator()( T const& ) const {}
+
+    void operator()( std::string const& s ) const
+    {
+        if( s == "throw" ) throw std::runtime_error( s );
+    }
+};
+
+static std::vector<V> make( std::size_t n )
+{
+    std::vector<V> v;
+    v.reserve( n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        switch( i % 7 )
+        {
+        case 0: case 3: v.emplace_back( std::string( i % 5, 'x' ) ); break;
+        case 1: case 2: case 6: v.emplace_back( static_cast<int>( i % 11 ) ); break;
+        default: v.emplace_back( static_cast<double>( i % 13 ) ); break;
+        }
+    }
+
+    return v;
+}
+
+static long long sequential_sum( std::vector<V> const& v )
+{
+    long long r = 0;
+
+    for( auto const& x: v )
+    {
+        r += visit( size_F(), x );
+    }
+
+    return r;
+}
+
+int main()
+{
+    std::size_t const sizes[] = { 0, 1, 100, 4096, 4097, 100000 };
+    std::size_t const threads[] = { 0, 1, 3, 8 };
+
+    for( std::size_t n: sizes )
+    {
+        std::vector<V> v = make( n );
+
+        std::size_t const N = 3;
+
+        std::array<std::size_t, N> c = count_by_index( v.data(), v.size() );
+
+        for( std::size_t k: threads )
+        {
+            {
+                std::atomic<long long> counts[ N ] = {};
+
+                parallel_for_each_visit( static_cast<V const*>( v.data() ), v.size(), count_F{ counts }, k );
+
+                for( std::size_t i = 0; i < N; ++i )
+                {
+                    BOOST_TEST_EQ( counts[ i ].load(), static_cast<long long>( c[ i ] ) );
+                }
+            }
+
+            BOOST_TEST_EQ( parallel_visit_reduce( static_cast<V const*>( v.data() ), v.size(), 0ll, plus_Op(), size_F(), k ), sequential_sum( v ) );
+        }
+
+        {
+            std::vector<V> w( v );
+
+            parallel_for_each_visit( w.data(), w.size(), increment_F(), 4 );
+
+            for( std::size_t i = 0; i < n; ++i )
+            {
+                V x( v[ i ] );
+                visit( increment_F(), x );
+
+                BOOST_TEST( w[ i ] == x );
+            }
+        }
+    }
+
+    {
+        std::vector<V> v = make( 20000 );
+        v[ 12345 ] = std::string( "throw" );
+
+        BOOST_TEST_THROWS( parallel_for_each_visit( v.data(), v.size(), throw_F(), 4 ), std::runtime_error );
+        BOOST_TEST_THROWS( parallel_for_each_visit( v.data(), v.size(), throw_F(), 1 ), std::runtime_error );
+    }
+
+#if defined(BOOST_VARIANT2_HAS_SPAN)
+
+    {
+        std::vector<V> v = make( 10000 );
+
+        BOOST_TEST_EQ( parallel_visit_reduce( std::span<V const>( v ), 0ll, plus_Op(), size_F() ), sequential_sum( v ) );
+
+        parallel_for_each_visit( std::span<V>( v ), increment_F() );
+        BOOST_TEST( v[ 1 ] == V( 2 ) );
+    }
+
+#endif
+
+#if defined(BOOST_VARIANT2_USE_STD_EXECUTION)
+
+    {
+        std::vector<V> v = make( 100000 );
+
+        BOOST_TEST_EQ( parallel_visit_reduce( std::execution::par, static_cast<V const*>( v.data() ), v.size(), 0ll, plus_Op(), size_F() ), sequential_sum( v ) );
+
+        std::vector<V> w( v );
+
+        parallel_for_each_visit( std::execution::par_unseq, w.data(), w.size(), increment_F() );
+        BOOST_TEST( w[ 1 ] == V( 2 ) );
+
+        std::atomic<long long> counts[ 3 ] = {};
+        parallel_for_each_visit( std::execution::seq, static_cast<V const*>( v.data() ), v.size(), count_F{ counts } );
+        BOOST_TEST_EQ( counts[ 0 ].load() + counts[ 1 ].load() + counts[ 2 ].load(), 100000 );
+    }
+
+#endif
+
+    return boost::report_errors();
+}
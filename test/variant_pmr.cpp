@@ -0,0 +1,390 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/pmr.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <memory>
+#include <scoped_allocator>
+#include <string>
+#include <vector>
+#include <tuple>
+
+using namespace boost::variant2;
+
+template<class T> struct test_allocator
+{
+    using value_type = T;
+
+    int id;
+
+    explicit test_allocator( int id = 0 ) noexcept: id( id )
+    {
+    }
+
+    template<class U> test_allocator( test_allocator<U> const& r ) noexcept: id( r.id )
+    {
+    }
+
+    T* allocate( std::size_t n )
+    {
+        return std::allocator<T>().allocate( n );
+    }
+
+    void deallocate( T* p, std::size_t n ) noexcept
+    {
+        std::allocator<T>().deallocate( p, n );
+    }
+};
+
+template<class T, class U> bool operator==( test_allocator<T> const& a, test_allocator<U> const& b ) noexcept
+{
+    return a.id == b.id;
+}
+
+template<class T, class U> bool operator!=( test_allocator<T> const& a, test_allocator<U> const& b ) noexcept
+{
+    return a.id != b.id;
+}
+
+using A = test_allocator<char>;
+
+// the leading allocator convention
+
+struct X1
+{
+    using allocator_type = A;
+
+    int v;
+    int id;
+
+    X1( int v = 0 ): v( v ), id( -1 )
+    {
+    }
+
+    X1( std::allocator_arg_t, A const& a, int v = 0 ): v( v ), id( a.id )
+    {
+    }
+
+    X1( X1 const& r ): v( r.v ), id( -1 )
+    {
+    }
+
+    X1( std::allocator_arg_t, A const& a, X1 const& r ): v( r.v ), id( a.id )
+    {
+    }
+
+    X1& operator=( X1 const& r )
+    {
+        v = r.v;
+        return *this;
+    }
+};
+
+// the trailing allocator convention
+
+struct X2
+{
+    using allocator_type = A;
+
+    int v;
+    int id;
+
+    X2( int v = 0 ): v( v ), id( -1 )
+    {
+    }
+
+    explicit X2( A const& a ): v( 0 ), id( a.id )
+    {
+    }
+
+    X2( int v, A const& a ): v( v ), id( a.id )
+    {
+    }
+
+    X2( X2 const& r ): v( r.v ), id( -1 )
+    {
+    }
+
+    X2( X2 const& r, A const& a ): v( r.v ), id( a.id )
+    {
+    }
+
+    X2& operator=( X2 const& r )
+    {
+        v = r.v;
+        return *this;
+    }
+};
+
+struct Y
+{
+    int v;
+};
+
+struct value_F
+{
+    int operator()( int x ) const { return x; }
+    int operator()( X1 const& x ) const { return x.v; }
+    int operator()( X2 const& x ) const { return x.v; }
+};
+
+int main()
+{
+    using V = variant<int, X1, X2>;
+
+    BOOST_TEST_TRAIT_TRUE(( std::uses_allocator<V, A> ));
+    BOOST_TEST_TRAIT_TRUE(( std::uses_allocator<V, test_allocator<int>> ));
+    BOOST_TEST_TRAIT_FALSE(( std::uses_allocator<variant<int, float>, A> ));
+
+    BOOST_TEST_TRAIT_TRUE(( std::is_constructible<V, std::allocator_arg_t, A, V const&> ));
+    BOOST_TEST_TRAIT_FALSE(( std::is_constructible<V, std::allocator_arg_t, A, Y> ));
+
+    {
+        variant<X1, int> v( std::allocator_arg, A( 1 ) );
+
+        BOOST_TEST_EQ( v.index(), 0u );
+        BOOST_TEST_EQ( get<0>( v ).id, 1 );
+
+        variant<X2, int> w( std::allocator_arg, A( 2 ) );
+
+        BOOST_TEST_EQ( w.index(), 0u );
+        BOOST_TEST_EQ( get<0>( w ).id, 2 );
+
+        variant<int, X1> z( std::allocator_arg, A( 3 ) );
+
+        BOOST_TEST_EQ( z.index(), 0u );
+        BOOST_TEST_EQ( get<0>( z ), 0 );
+    }
+
+    {
+        V v1( std::allocator_arg, A( 1 ), in_place_index_t<1>(), 5 );
+
+        BOOST_TEST_EQ( get<1>( v1 ).v, 5 );
+        BOOST_TEST_EQ( get<1>( v1 ).id, 1 );
+
+        V v2( std::allocator_arg, test_allocator<int>( 2 ), in_place_type_t<X2>(), 6 );
+
+        BOOST_TEST_EQ( get<2>( v2 ).v, 6 );
+        BOOST_TEST_EQ( get<2>( v2 ).id, 2 );
+
+        V v3( std::allocator_arg, A( 3 ), 7 );
+
+        BOOST_TEST_EQ( get<0>( v3 ), 7 );
+
+        V v4( std::allocator_arg, A( 4 ), X2( 8 ) );
+
+        BOOST_TEST_EQ( get<2>( v4 ).v, 8 );
+        BOOST_TEST_EQ( get<2>( v4 ).id, 4 );
+
+        V v5( std::allocator_arg, A( 5 ), v1 );
+
+        BOOST_TEST_EQ( get<1>( v5 ).v, 5 );
+        BOOST_TEST_EQ( get<1>( v5 ).id, 5 );
+
+        V v6( std::allocator_arg, A( 6 ), std::move( v2 ) );
+
+        BOOST_TEST_EQ( get<2>( v6 ).v, 6 );
+        BOOST_TEST_EQ( get<2>( v6 ).id, 6 );
+
+        // without an allocator, the arena is lost
+        V v7( v1 );
+
+        BOOST_TEST_EQ( get<1>( v7 ).id, -1 );
+
+        v7.emplace<2>( std::allocator_arg, A( 7 ), 9 );
+
+        BOOST_TEST_EQ( get<2>( v7 ).v, 9 );
+        BOOST_TEST_EQ( get<2>( v7 ).id, 7 );
+
+        v7.emplace<X1>( std::allocator_arg, A( 8 ), 10 );
+
+        BOOST_TEST_EQ( get<1>( v7 ).v, 10 );
+        BOOST_TEST_EQ( get<1>( v7 ).id, 8 );
+
+        v7.emplace<0>( std::allocator_arg, A( 9 ), 11 );
+
+        BOOST_TEST_EQ( get<0>( v7 ), 11 );
+    }
+
+    {
+        // an alternative that is itself allocator-aware through the leading convention
+
+        using T = std::tuple<X1, int>;
+
+        variant<int, T> v( std::allocator_arg, A( 1 ), in_place_index_t<1>(), 2, 3 );
+
+        BOOST_TEST_EQ( std::get<0>( get<1>( v ) ).id, 1 );
+
+        v.emplace<1>( std::allocator_arg, A( 2 ), 4, 5 );
+
+        BOOST_TEST_EQ( std::get<0>( get<1>( v ) ).id, 2 );
+        BOOST_TEST_EQ( std::get<0>( get<1>( v ) ).v, 4 );
+    }
+
+    {
+        using W = allocator_variant<A, int, X1, X2>;
+
+        BOOST_TEST_TRAIT_TRUE(( std::uses_allocator<W, A> ));
+
+        W w( A( 1 ) );
+
+        BOOST_TEST_EQ( w.get_allocator().id, 1 );
+        BOOST_TEST_EQ( w.index(), 0u );
+
+        w = X1( 2 );
+
+        BOOST_TEST_EQ( get<1>( w ).v, 2 );
+        BOOST_TEST_EQ( get<1>( w ).id, 1 );
+
+        w.emplace<X2>( 3 );
+
+        BOOST_TEST_EQ( get<2>( w ).v, 3 );
+        BOOST_TEST_EQ( get<2>( w ).id, 1 );
+
+        w.emplace<1>();
+
+        BOOST_TEST_EQ( get<1>( w ).id, 1 );
+
+        W w2( std::allocator_arg, A( 2 ), w );
+
+        BOOST_TEST_EQ( w2.get_allocator().id, 2 );
+        BOOST_TEST_EQ( get<1>( w2 ).id, 2 );
+
+        W w3( w );
+
+        BOOST_TEST_EQ( w3.get_allocator().id, 1 );
+        BOOST_TEST_EQ( get<1>( w3 ).id, 1 );
+
+        W w4( std::move( w3 ) );
+
+        BOOST_TEST_EQ( w4.get_allocator().id, 1 );
+        BOOST_TEST_EQ( get<1>( w4 ).id, 1 );
+
+        // X1 and X2 can throw on copy
+
+        BOOST_TEST_TRAIT_FALSE(( std::is_nothrow_move_constructible<W> ));
+        BOOST_TEST_TRAIT_TRUE(( std::is_nothrow_move_constructible< allocator_variant<A, int, float> > ));
+
+        // assignment keeps the allocator of the target
+
+        w2 = V( X2( 4 ) );
+
+        BOOST_TEST_EQ( w2.get_allocator().id, 2 );
+        BOOST_TEST_EQ( get<2>( w2 ).v, 4 );
+        BOOST_TEST_EQ( get<2>( w2 ).id, 2 );
+
+        w2 = w;
+
+        BOOST_TEST_EQ( get<1>( w2 ).id, 2 );
+
+        w2 = 5;
+
+        BOOST_TEST_EQ( get<0>( w2 ), 5 );
+
+        W w5 = X2( 6 );
+
+        BOOST_TEST_EQ( w5.get_allocator().id, 0 );
+        BOOST_TEST_EQ( get<2>( w5 ).id, 0 );
+
+        W w6( in_place_index_t<1>(), 7 );
+
+        BOOST_TEST_EQ( get<1>( w6 ).v, 7 );
+        BOOST_TEST_EQ( get<1>( w6 ).id, 0 );
+
+        BOOST_TEST_EQ( visit( value_F(), static_cast<W const&>( w6 ) ), 7 );
+    }
+
+    {
+        // scoped allocators construct the elements with the allocator of the container
+
+        using W = allocator_variant<test_allocator<int>, int, X2>;
+
+        std::vector<W, std::scoped_allocator_adaptor<test_allocator<W>>> v( test_allocator<W>( 3 ) );
+
+        v.emplace_back( X2( 1 ) );
+        v.emplace_back( in_place_type_t<X2>(), 2 );
+        v.emplace_back( 3 );
+
+        BOOST_TEST_EQ( get<1>( v[ 0 ] ).id, 3 );
+        BOOST_TEST_EQ( get<1>( v[ 1 ] ).id, 3 );
+        BOOST_TEST_EQ( v[ 2 ].get_allocator().id, 3 );
+    }
+
+#if defined(BOOST_VARIANT2_HAS_MEMORY_RESOURCE)
+
+    {
+        std::pmr::monotonic_buffer_resource mr;
+
+        // nothing is allocated from the default resource
+        std::pmr::memory_resource * old = std::pmr::set_default_resource( std::pmr::null_memory_resource() );
+
+        {
+            std::pmr::string const s( "a string that is too long for the small buffer", &mr );
+
+            pmr::variant<int, std::pmr::string> v( &mr );
+
+            v = s;
+            BOOST_TEST( get<1>( v ).get_allocator().resource() == &mr );
+
+            v = "another string that is too long for the small buffer";
+            BOOST_TEST( get<1>( v ).get_allocator().resource() == &mr );
+
+            v.emplace<1>( 100u, 'x' );
+            BOOST_TEST( get<1>( v ).get_allocator().resource() == &mr );
+
+            std::pmr::vector< pmr::variant<int, std::pmr::string, std::pmr::vector<int>> > w( &mr );
+
+            w.emplace_back( 1 );
+            w.emplace_back( s );
+            w.emplace_back( in_place_index_t<2>(), 100u, 7 );
+            w.push_back( w[ 1 ] );
+            w.resize( 100 );
+
+            BOOST_TEST( w[ 0 ].get_allocator().resource() == &mr );
+            BOOST_TEST( get<1>( w[ 1 ] ).get_allocator().resource() == &mr );
+            BOOST_TEST( get<2>( w[ 2 ] ).get_allocator().resource() == &mr );
+            BOOST_TEST( get<1>( w[ 3 ] ).get_allocator().resource() == &mr );
+            BOOST_TEST( w[ 99 ].get_allocator().resource() == &mr );
+
+            // the move constructor is noexcept when the allocator-extended moves
+            // of the alternatives are, and then reallocation moves the strings
+
+            using PA = std::pmr::polymorphic_allocator<std::byte>;
+
+            bool const nothrow =
+                std::is_nothrow_constructible<std::pmr::string, std::pmr::string&&, PA const&>::value &&
+                std::is_nothrow_constructible<std::pmr::vector<int>, std::pmr::vector<int>&&, PA const&>::value;
+
+            BOOST_TEST_EQ( ( std::is_nothrow_move_constructible< pmr::variant<int, std::pmr::string, std::pmr::vector<int>> >::value ), nothrow );
+            BOOST_TEST_TRAIT_TRUE(( std::is_nothrow_move_constructible< pmr::variant<int, float> > ));
+
+            char const* p = get<1>( w[ 1 ] ).data();
+
+            w.reserve( w.capacity() + 1 );
+
+            if( nothrow )
+            {
+                BOOST_TEST_EQ( static_cast<void const*>( get<1>( w[ 1 ] ).data() ), static_cast<void const*>( p ) );
+            }
+            BOOST_TEST( get<1>( w[ 1 ] ).get_allocator().resource() == &mr );
+
+            // a plain variant is constructed with the allocator of the container as well
+
+            std::pmr::vector< variant<int, std::pmr::string> > z( &mr );
+
+            z.emplace_back( s );
+            z.emplace_back( z[ 0 ] );
+
+            BOOST_TEST( get<1>( z[ 0 ] ).get_allocator().resource() == &mr );
+            BOOST_TEST( get<1>( z[ 1 ] ).get_allocator().resource() == &mr );
+        }
+
+        std::pmr::set_default_resource( old );
+    }
+
+#endif
+
+    return boost::report_errors();
+}
@@ -0,0 +1,167 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#define BOOST_VARIANT2_ENABLE_PROFILING
+
+#include <boost/variant2/variant.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace boost::variant2;
+
+struct Y
+{
+    int v_;
+
+    Y( int v = 0 ): v_( v ) {}
+
+    Y( Y const& r ): v_( r.v_ ) {}
+    Y( Y&& r ) noexcept( false ): v_( r.v_ ) {}
+
+    ~Y() {}
+
+    Y& operator=( Y const& ) = default;
+    Y& operator=( Y&& ) = default;
+};
+
+struct F
+{
+    template<class T> void operator()( T const& ) const {}
+    template<class T1, class T2> void operator()( T1 const&, T2 const& ) const {}
+    template<class T1, class T2, class T3> void operator()( T1 const&, T2 const&, T3 const& ) const {}
+};
+
+int main()
+{
+    using V1 = variant<int, float>;
+    using V2 = variant<int, std::string>;
+    using V3 = variant<int, Y>;
+
+    {
+        V1 v1( 1 );
+        V1 v2( 1.0f );
+
+        v1 = 2.0f;
+        v1.emplace<0>( 3 );
+
+        visit( F(), v1 );
+        visit( F(), v1 );
+        visit( F(), v2 );
+        visit( F(), v1, v2 );
+        visit( F(), v2, v1, v2 );
+
+        variant_profile_record const& r = variant_profile<V1>();
+
+        BOOST_TEST_EQ( r.size, 2u );
+
+        BOOST_TEST_EQ( r.constructed[ 0 ], 1u );
+        BOOST_TEST_EQ( r.constructed[ 1 ], 1u );
+
+        BOOST_TEST_EQ( r.emplaced[ 0 ], 1u );
+        BOOST_TEST_EQ( r.emplaced[ 1 ], 1u );
+
+        BOOST_TEST_EQ( r.visited[ 0 ], 4u );
+        BOOST_TEST_EQ( r.visited[ 1 ], 4u );
+
+        BOOST_TEST_EQ( r.buffer_flips, 0u );
+    }
+
+    {
+        V2 v1( "abc" );
+        V2 v2( v1 );
+
+        v2 = 1;
+        v2 = v1;
+
+        visit_by_index( v2, F(), F() );
+
+        variant_profile_record const& r = variant_profile<V2>();
+
+        BOOST_TEST_EQ( r.constructed[ 0 ], 0u );
+        BOOST_TEST_EQ( r.constructed[ 1 ], 2u );
+
+        BOOST_TEST_EQ( r.emplaced[ 0 ], 1u );
+        BOOST_TEST_EQ( r.emplaced[ 1 ], 1u );
+
+        BOOST_TEST_EQ( r.visited[ 0 ], 0u );
+        BOOST_TEST_EQ( r.visited[ 1 ], 1u );
+
+        BOOST_TEST_EQ( r.destroyed[ 0 ], 1u );
+        BOOST_TEST_EQ( r.destroyed[ 1 ], 1u );
+    }
+
+    {
+        variant_profile_record const& r = variant_profile<V2>();
+
+        BOOST_TEST_EQ( r.destroyed[ 0 ], 1u );
+        BOOST_TEST_EQ( r.destroyed[ 1 ], 3u );
+    }
+
+    {
+        V3 v;
+
+        v.emplace<Y>( 1 );
+        v.emplace<int>( 2 );
+
+        variant_profile_record const& r = variant_profile<V3>();
+
+        BOOST_TEST( v.uses_double_storage() );
+
+        BOOST_TEST_EQ( r.constructed[ 0 ], 1u );
+        BOOST_TEST_EQ( r.emplaced[ 0 ], 1u );
+        BOOST_TEST_EQ( r.emplaced[ 1 ], 1u );
+        BOOST_TEST_EQ( r.destroyed[ 0 ], 1u );
+        BOOST_TEST_EQ( r.destroyed[ 1 ], 1u );
+        BOOST_TEST_EQ( r.buffer_flips, 2u );
+    }
+
+    {
+        int n = 0;
+
+        for( variant_profile_record const* p = variant_profile_first(); p; p = p->next )
+        {
+            ++n;
+        }
+
+        BOOST_TEST_EQ( n, 3 );
+
+        std::ostringstream os;
+        variant_profile_dump( os );
+
+        BOOST_TEST_NE( os.str().find( "buffer flips 2\n" ), std::string::npos );
+        BOOST_TEST_NE( os.str().find( "  1: constructed 2, emplaced 1, visited 1, destroyed 3\n" ), std::string::npos );
+    }
+
+    {
+        // counters are per thread
+
+        std::thread th( []{
+
+            V1 v( 1 );
+            visit( F(), v );
+
+            BOOST_TEST_EQ( variant_profile<V1>().constructed[ 0 ], 1u );
+            BOOST_TEST_EQ( variant_profile<V1>().visited[ 0 ], 1u );
+
+        });
+
+        th.join();
+
+        BOOST_TEST_EQ( variant_profile<V1>().visited[ 0 ], 4u );
+    }
+
+    variant_profile_reset();
+
+    {
+        variant_profile_record const& r = variant_profile<V2>();
+
+        BOOST_TEST_EQ( r.constructed[ 1 ], 0u );
+        BOOST_TEST_EQ( r.destroyed[ 1 ], 0u );
+        BOOST_TEST_EQ( variant_profile<V3>().buffer_flips, 0u );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,333 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/recursive.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace boost::variant2;
+
+// a trivially destructible expression tree
+
+struct Binary;
+
+using Expr = variant<long, recursive<Binary>>;
+
+struct Binary
+{
+    char op;
+    Expr lhs;
+    Expr rhs;
+};
+
+bool operator==( Binary const& x, Binary const& y )
+{
+    return x.op == y.op && x.lhs == y.lhs && x.rhs == y.rhs;
+}
+
+bool operator!=( Binary const& x, Binary const& y )
+{
+    return !( x == y );
+}
+
+struct eval_F
+{
+    long operator()( long x ) const
+    {
+        return x;
+    }
+
+    long operator()( Binary const& b ) const
+    {
+        long x = visit( *this, b.lhs );
+        long y = visit( *this, b.rhs );
+
+        return b.op == '+'? x + y: x * y;
+    }
+};
+
+static Expr make_tree( bump_arena& a, int depth, long& next )
+{
+    if( depth == 0 ) return ++next;
+
+    Expr lhs = make_tree( a, depth - 1, next );
+    Expr rhs = make_tree( a, depth - 1, next );
+
+    return recursive<Binary>( a, Binary{ '+', std::move( lhs ), std::move( rhs ) } );
+}
+
+// a node with a non-trivial destructor
+
+struct Call;
+
+using Expr2 = variant<std::string, recursive<Call>>;
+
+struct Call
+{
+    static int instances;
+
+    std::string name;
+    std::vector<Expr2> args;
+
+    explicit Call( std::string const& name ): name( name )
+    {
+        ++instances;
+    }
+
+    Call( Call const& r ): name( r.name ), args( r.args )
+    {
+        ++instances;
+    }
+
+    ~Call()
+    {
+        --instances;
+    }
+};
+
+int Call::instances = 0;
+
+struct count_F
+{
+    int operator()( std::string const& ) const
+    {
+        return 1;
+    }
+
+    int operator()( Call const& c ) const
+    {
+        int r = 1;
+
+        for( auto const& x: c.args )
+        {
+            r += visit( *this, x );
+        }
+
+        return r;
+    }
+};
+
+// move-only, and not default constructible
+
+struct M
+{
+    int v;
+
+    explicit M( int v ): v( v )
+    {
+    }
+
+    M( M const& ) = delete;
+    M( M&& ) = default;
+};
+
+struct alignas(64) Over
+{
+    unsigned char data[ 64 ];
+};
+
+int main()
+{
+    BOOST_TEST_TRAIT_TRUE(( std::is_trivially_destructible<recursive<Binary>> ));
+    BOOST_TEST_TRAIT_TRUE(( std::is_trivially_destructible<Expr> ));
+    BOOST_TEST_TRAIT_TRUE(( std::is_trivially_destructible<Binary> ));
+    BOOST_TEST_TRAIT_TRUE(( is_trivially_relocatable<recursive<Call>> ));
+    BOOST_TEST_EQ( sizeof( recursive<Binary> ), sizeof( void* ) );
+
+    {
+        bump_arena a( 64 );
+
+        long next = 0;
+        Expr e = make_tree( a, 10, next );
+
+        BOOST_TEST_EQ( next, 1024 );
+        BOOST_TEST_EQ( visit( eval_F(), e ), 1024L * 1025 / 2 );
+
+        // a copy is deep, and comes from the same arena
+
+        Expr e2 = e;
+
+        BOOST_TEST( e2 == e );
+        BOOST_TEST( &*get<1>( e2 ) != &*get<1>( e ) );
+        BOOST_TEST_EQ( get<1>( e2 ).arena(), &a );
+
+        get<1>( e2 )->op = '*';
+
+        BOOST_TEST( e2 != e );
+        BOOST_TEST_EQ( visit( eval_F(), e ), 1024L * 1025 / 2 );
+
+        // a move transfers the node
+
+        Binary* p = &*get<1>( e );
+
+        Expr e3 = std::move( e );
+
+        BOOST_TEST_EQ( &*get<1>( e3 ), p );
+
+        // a moved-from box holds a value-initialized value, and allocates
+        // its own node when it's modified
+
+        BOOST_TEST_EQ( e.index(), 1u );
+        BOOST_TEST( *get<1>( e ) == Binary() );
+        BOOST_TEST_EQ( get<1>( e ).arena(), &a );
+
+        get<1>( e )->op = '*';
+
+        BOOST_TEST( &*get<1>( e ) != p );
+        BOOST_TEST_EQ( get<1>( e ).arena(), &a );
+        BOOST_TEST_EQ( visit( eval_F(), e ), 0 );
+
+        BOOST_TEST_EQ( &*get<1>( e3 ), p );
+        BOOST_TEST_EQ( get<1>( e3 )->op, '+' );
+        BOOST_TEST_EQ( visit( eval_F(), e3 ), 1024L * 1025 / 2 );
+
+        e = e3;
+
+        BOOST_TEST( e == e3 );
+
+        e = 5L;
+        BOOST_TEST_EQ( visit( eval_F(), e ), 5 );
+
+        a.release();
+
+        // the arena is reused after release
+
+        next = 0;
+        e = make_tree( a, 4, next );
+
+        BOOST_TEST_EQ( visit( eval_F(), e ), 16L * 17 / 2 );
+    }
+
+    {
+        bump_arena a;
+
+        {
+            Expr2 e( in_place_index_t<1>(), a, "f" );
+
+            recursive<Call>& c = get<1>( e );
+
+            c->args.push_back( "x" );
+            c->args.push_back( recursive<Call>( a, "g" ) );
+            get<1>( c->args.back() )->args.push_back( "y" );
+
+            BOOST_TEST_EQ( Call::instances, 2 );
+            BOOST_TEST_EQ( visit( count_F(), e ), 4 );
+
+            Expr2 e2( e );
+
+            BOOST_TEST_EQ( Call::instances, 4 );
+            BOOST_TEST_EQ( visit( count_F(), e2 ), 4 );
+        }
+
+        // the nodes belong to the arena and are destroyed by it
+
+        BOOST_TEST_EQ( Call::instances, 4 );
+
+        a.release();
+
+        BOOST_TEST_EQ( Call::instances, 0 );
+
+        {
+            recursive<Call> c( a, "h" );
+            c->args.push_back( recursive<Call>( a, "i" ) );
+        }
+
+        BOOST_TEST_EQ( Call::instances, 2 );
+    }
+
+    BOOST_TEST_EQ( Call::instances, 0 );
+
+    {
+        bump_arena a;
+
+        recursive<Binary> r1( a, Binary{ '+', 1L, 2L } );
+        recursive<Binary> r2( std::move( r1 ) );
+
+        BOOST_TEST( r1 != r2 );
+        BOOST_TEST( r1 == recursive<Binary>( a ) );
+        BOOST_TEST_EQ( r1.arena(), &a );
+
+        r1 = r2;
+
+        BOOST_TEST( r1 == r2 );
+
+        r1->op = '*';
+
+        BOOST_TEST_EQ( r2->op, '+' );
+        BOOST_TEST_EQ( r1.arena(), &a );
+
+        recursive<Binary> r3( std::move( r2 ) );
+        r2 = std::move( r1 );
+
+        BOOST_TEST_EQ( r2->op, '*' );
+        BOOST_TEST_EQ( visit( eval_F(), Expr( r1 ) ), 0 );
+
+        // a moved-from box doesn't see the writes to the box it was moved to
+
+        recursive<int> x( a, 5 );
+        recursive<int> y( std::move( x ) );
+
+        *y = 7;
+
+        BOOST_TEST_EQ( *static_cast<recursive<int> const&>( x ), 0 );
+        BOOST_TEST_EQ( *x, 0 );
+        BOOST_TEST_EQ( *y, 7 );
+
+        x = std::move( y );
+
+        *static_cast<recursive<int>&>( y ) = 8;
+
+        BOOST_TEST_EQ( *x, 7 );
+        BOOST_TEST_EQ( *y, 8 );
+
+        // the same holds for move-only values
+
+        recursive<std::unique_ptr<int>> m1( a, new int( 5 ) );
+        recursive<std::unique_ptr<int>> m2( std::move( m1 ) );
+
+        BOOST_TEST_EQ( **m2, 5 );
+        BOOST_TEST( *static_cast<recursive<std::unique_ptr<int>> const&>( m1 ) == nullptr );
+        BOOST_TEST( *m1 == nullptr );
+        BOOST_TEST_EQ( **m2, 5 );
+
+        // a value that is neither copyable nor default constructible
+
+        recursive<M> n1( a, 3 );
+
+        n1->v = 4;
+        BOOST_TEST_EQ( ( *n1 ).v, 4 );
+
+        recursive<M> n2( std::move( n1 ) );
+
+        BOOST_TEST_EQ( n2->v, 4 );
+        BOOST_TEST_EQ( n1.arena(), &a );
+
+        n1 = std::move( n2 );
+
+        BOOST_TEST_EQ( n1->v, 4 );
+    }
+
+    {
+        bump_arena a( 16 );
+
+        for( int i = 0; i < 100; ++i )
+        {
+            void* p = a.allocate( 1, 1 );
+            BOOST_TEST( p != 0 );
+
+            recursive<Over> r( a );
+            BOOST_TEST_EQ( reinterpret_cast<std::uintptr_t>( &*r ) % 64, 0u );
+        }
+
+        // larger than the next chunk
+        void* p = a.allocate( 100000, 8 );
+        BOOST_TEST_EQ( reinterpret_cast<std::uintptr_t>( p ) % 8, 0u );
+    }
+
+    return boost::report_errors();
+}
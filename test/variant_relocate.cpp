@@ -0,0 +1,207 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/relocate.hpp>
+#include <boost/variant2/compact_variant.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <stdexcept>
+#include <string>
+#include <new>
+
+using namespace boost::variant2;
+
+// Y owns a heap allocation and opts in to trivial relocation
+
+struct Y
+{
+    static int instances;
+
+    int* p_;
+
+    explicit Y( int v ): p_( new int( v ) )
+    {
+        ++instances;
+    }
+
+    Y( Y const& r ): p_( new int( *r.p_ ) )
+    {
+        ++instances;
+    }
+
+    Y( Y&& r ) noexcept: p_( r.p_ )
+    {
+        r.p_ = 0;
+        ++instances;
+    }
+
+    ~Y()
+    {
+        delete p_;
+        --instances;
+    }
+
+    Y& operator=( Y const& ) = delete;
+};
+
+int Y::instances = 0;
+
+namespace boost
+{
+namespace variant2
+{
+
+template<> struct is_trivially_relocatable<Y>: std::true_type
+{
+};
+
+} // namespace variant2
+} // namespace boost
+
+// Z counts moves and may throw from its move constructor
+
+struct Z
+{
+    static int instances;
+    static int moves;
+    static int throw_on;
+
+    int v;
+
+    explicit Z( int v ): v( v )
+    {
+        ++instances;
+    }
+
+    Z( Z&& r ): v( r.v )
+    {
+        if( moves++ == throw_on ) throw std::runtime_error( "Z" );
+        ++instances;
+    }
+
+    ~Z()
+    {
+        --instances;
+    }
+};
+
+int Z::instances = 0;
+int Z::moves = 0;
+int Z::throw_on = -1;
+
+template<class T> struct raw_buffer
+{
+    alignas( T ) unsigned char data_[ 8 * sizeof( T ) ];
+
+    T* get() noexcept
+    {
+        return reinterpret_cast<T*>( data_ );
+    }
+};
+
+int main()
+{
+    BOOST_TEST_TRAIT_TRUE(( is_trivially_relocatable<int> ));
+    BOOST_TEST_TRAIT_TRUE(( is_trivially_relocatable<Y> ));
+    BOOST_TEST_TRAIT_FALSE(( is_trivially_relocatable<Z> ));
+
+    BOOST_TEST_TRAIT_TRUE(( is_trivially_relocatable<variant<int, float>> ));
+    BOOST_TEST_TRAIT_TRUE(( is_trivially_relocatable<variant<int, Y>> ));
+    BOOST_TEST_TRAIT_FALSE(( is_trivially_relocatable<variant<int, Z>> ));
+
+    BOOST_TEST_TRAIT_TRUE(( is_trivially_relocatable<compact_variant<8, int, Y>> ));
+    BOOST_TEST_TRAIT_TRUE(( is_trivially_relocatable<compact_variant<8, int, std::string>> ));
+    BOOST_TEST_TRAIT_FALSE(( is_trivially_relocatable<compact_variant<8, int, Z>> ));
+
+    {
+        using V = variant<int, Y>;
+
+        raw_buffer<V> b1, b2;
+
+        ::new( b1.get() + 0 ) V( 1 );
+        ::new( b1.get() + 1 ) V( Y( 2 ) );
+        ::new( b1.get() + 2 ) V( Y( 3 ) );
+
+        BOOST_TEST_EQ( Y::instances, 2 );
+
+        V* r = uninitialized_relocate( b1.get(), b1.get() + 3, b2.get() );
+
+        BOOST_TEST_EQ( r, b2.get() + 3 );
+        BOOST_TEST_EQ( Y::instances, 2 );
+
+        BOOST_TEST_EQ( get<int>( b2.get()[ 0 ] ), 1 );
+        BOOST_TEST_EQ( *get<Y>( b2.get()[ 1 ] ).p_, 2 );
+        BOOST_TEST_EQ( *get<Y>( b2.get()[ 2 ] ).p_, 3 );
+
+        for( int i = 0; i < 3; ++i ) b2.get()[ i ].~V();
+
+        BOOST_TEST_EQ( Y::instances, 0 );
+    }
+
+    {
+        using V = variant<int, Z>;
+
+        raw_buffer<V> b1, b2;
+
+        ::new( b1.get() + 0 ) V( in_place_type_t<Z>(), 1 );
+        ::new( b1.get() + 1 ) V( 2 );
+        ::new( b1.get() + 2 ) V( in_place_type_t<Z>(), 3 );
+
+        Z::moves = 0;
+
+        V* r = uninitialized_relocate_n( b1.get(), 3, b2.get() );
+
+        BOOST_TEST_EQ( r, b2.get() + 3 );
+        BOOST_TEST_EQ( Z::moves, 2 );
+        BOOST_TEST_EQ( Z::instances, 2 );
+
+        BOOST_TEST_EQ( get<Z>( b2.get()[ 0 ] ).v, 1 );
+        BOOST_TEST_EQ( get<int>( b2.get()[ 1 ] ), 2 );
+        BOOST_TEST_EQ( get<Z>( b2.get()[ 2 ] ).v, 3 );
+
+        for( int i = 0; i < 3; ++i ) b2.get()[ i ].~V();
+
+        BOOST_TEST_EQ( Z::instances, 0 );
+    }
+
+    {
+        using V = variant<int, Z>;
+
+        raw_buffer<V> b1, b2;
+
+        ::new( b1.get() + 0 ) V( in_place_type_t<Z>(), 1 );
+        ::new( b1.get() + 1 ) V( in_place_type_t<Z>(), 2 );
+        ::new( b1.get() + 2 ) V( in_place_type_t<Z>(), 3 );
+
+        Z::moves = 0;
+        Z::throw_on = 1;
+
+        BOOST_TEST_THROWS( uninitialized_relocate( b1.get(), b1.get() + 3, b2.get() ), std::runtime_error );
+
+        // both ranges have been destroyed
+        BOOST_TEST_EQ( Z::instances, 0 );
+
+        Z::throw_on = -1;
+    }
+
+    {
+        using V = compact_variant<8, int, std::string>;
+
+        raw_buffer<V> b1, b2;
+
+        ::new( b1.get() + 0 ) V( std::string( "a long string that does not fit in the small buffer" ) );
+        ::new( b1.get() + 1 ) V( 5 );
+
+        std::string const* p = &get<std::string>( b1.get()[ 0 ] );
+
+        uninitialized_relocate_n( b1.get(), 2, b2.get() );
+
+        BOOST_TEST_EQ( &get<std::string>( b2.get()[ 0 ] ), p );
+        BOOST_TEST_EQ( get<int>( b2.get()[ 1 ] ), 5 );
+
+        for( int i = 0; i < 2; ++i ) b2.get()[ i ].~V();
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,161 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/shared_variant.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace boost::variant2;
+
+// a quote whose fields all carry the same sequence number
+
+struct Q
+{
+    long long seq;
+    double bid;
+    double ask;
+    long long volume[ 4 ];
+
+    explicit Q( long long s = 0 ): seq( s ), bid( static_cast<double>( s ) ), ask( static_cast<double>( s ) ), volume{ s, s, s, s }
+    {
+    }
+
+    bool consistent() const
+    {
+        return bid == static_cast<double>( seq ) && ask == static_cast<double>( seq ) && volume[ 0 ] == seq && volume[ 1 ] == seq && volume[ 2 ] == seq && volume[ 3 ] == seq;
+    }
+};
+
+struct Trade
+{
+    long long seq;
+    long long price;
+};
+
+// trivially copyable, but not default constructible
+
+struct Price
+{
+    long long value;
+
+    explicit Price( long long v ): value( v )
+    {
+    }
+};
+
+using V = variant<monostate, Q, Trade>;
+
+struct consistent_L
+{
+    bool operator()( monostate ) const { return true; }
+    bool operator()( Q const& q ) const { return q.consistent(); }
+    bool operator()( Trade const& t ) const { return t.price == t.seq * 10; }
+};
+
+struct seq_L
+{
+    long long operator()( monostate ) const { return 0; }
+    long long operator()( Q const& q ) const { return q.seq; }
+    long long operator()( Trade const& t ) const { return t.seq; }
+};
+
+int main()
+{
+    {
+        shared_variant<monostate, Q, Trade> s;
+
+        BOOST_TEST_EQ( s.load().index(), 0u );
+
+        s.store( Q( 5 ) );
+
+        V v = s.load();
+
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST_EQ( get<Q>( v ).seq, 5 );
+
+        s = Trade{ 6, 60 };
+
+        BOOST_TEST_EQ( s.visit( seq_L() ), 6 );
+        BOOST_TEST( s.visit( consistent_L() ) );
+
+        s = Q( 7 );
+
+        BOOST_TEST_EQ( s.visit( seq_L() ), 7 );
+    }
+
+    {
+        shared_variant<int, double> s( 2.5 );
+
+        BOOST_TEST( s.load() == ( variant<int, double>( 2.5 ) ) );
+    }
+
+    {
+        // an alternative without a default constructor
+
+        shared_variant<Price, double> s( Price( 4 ) );
+
+        BOOST_TEST_EQ( get<0>( s.load() ).value, 4 );
+
+        s.store( 0.5 );
+
+        BOOST_TEST_EQ( get<1>( s.load() ), 0.5 );
+    }
+
+    {
+        // one writer, several readers
+
+        int const N = 4;
+        long long const M = 20000;
+
+        shared_variant<monostate, Q, Trade> s;
+
+        std::atomic<bool> done( false );
+        std::atomic<int> errors( 0 );
+
+        std::vector<std::thread> th;
+
+        for( int i = 0; i < N; ++i )
+        {
+            th.emplace_back( [&]{
+
+                long long last = 0;
+
+                while( !done.load( std::memory_order_acquire ) )
+                {
+                    V v = s.load();
+
+                    long long k = visit( seq_L(), v );
+
+                    // values are consistent, and are seen in order
+                    if( !visit( consistent_L(), v ) || k < last ) ++errors;
+
+                    last = k;
+                }
+            });
+        }
+
+        for( long long k = 1; k <= M; ++k )
+        {
+            if( k % 3 == 0 )
+            {
+                s.store( Trade{ k, k * 10 } );
+            }
+            else
+            {
+                s.store( Q( k ) );
+            }
+        }
+
+        done.store( true, std::memory_order_release );
+
+        for( auto& t: th ) t.join();
+
+        BOOST_TEST_EQ( errors.load(), 0 );
+        BOOST_TEST_EQ( s.visit( seq_L() ), M );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,247 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <stdexcept>
+#include <string>
+
+using namespace boost::variant2;
+
+// X has a move constructor that can throw
+
+struct X
+{
+    static int instances;
+    static bool move_throws;
+
+    int v;
+
+    explicit X( int v ): v( v )
+    {
+        if( v < 0 ) throw std::runtime_error( "X" );
+        ++instances;
+    }
+
+    X( X const& r ): v( r.v )
+    {
+        ++instances;
+    }
+
+    X( X&& r ): v( r.v )
+    {
+        if( move_throws ) throw std::runtime_error( "X(X&&)" );
+        ++instances;
+    }
+
+    X& operator=( X const& ) = default;
+    X& operator=( X&& ) = default;
+
+    ~X()
+    {
+        --instances;
+    }
+};
+
+int X::instances = 0;
+bool X::move_throws = false;
+
+// Y is trivially destructible with a move constructor that can throw
+
+struct Y
+{
+    static bool move_throws;
+
+    int v;
+
+    explicit Y( int v ): v( v )
+    {
+        if( v < 0 ) throw std::runtime_error( "Y" );
+    }
+
+    Y( Y const& ) = default;
+    Y( Y&& r ): v( r.v )
+    {
+        if( move_throws ) throw std::runtime_error( "Y(Y&&)" );
+    }
+
+    Y& operator=( Y const& ) = default;
+    Y& operator=( Y&& ) = default;
+};
+
+bool Y::move_throws = false;
+
+using V1 = variant<monostate, X, std::string>;
+using V2 = variant<int, X, std::string>;
+using V3 = variant<Y, monostate, int>;
+using V4 = variant<X, int>;
+
+namespace boost
+{
+namespace variant2
+{
+
+template<> struct variant_storage_policy<V1>
+{
+    using type = single_buffer_storage;
+};
+
+template<> struct variant_storage_policy<V2>
+{
+    using type = single_buffer_storage;
+};
+
+template<> struct variant_storage_policy<V3>
+{
+    using type = single_buffer_storage;
+};
+
+} // namespace variant2
+} // namespace boost
+
+int main()
+{
+    BOOST_TEST( !V1::uses_double_storage() );
+    BOOST_TEST( !V2::uses_double_storage() );
+    BOOST_TEST( !V3::uses_double_storage() );
+    BOOST_TEST( V4::uses_double_storage() );
+
+    BOOST_TEST_LT( sizeof( V1 ), sizeof( variant<monostate, X, std::string, float> ) );
+
+    {
+        V1 v( in_place_type_t<X>(), 1 );
+
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST_EQ( get<X>( v ).v, 1 );
+
+        v.emplace<X>( 2 );
+
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST_EQ( get<X>( v ).v, 2 );
+        BOOST_TEST_EQ( X::instances, 1 );
+
+        v = std::string( "abc" );
+
+        BOOST_TEST_EQ( v.index(), 2u );
+        BOOST_TEST_EQ( X::instances, 0 );
+
+        // the construction throws, the variant is unchanged
+        BOOST_TEST_THROWS( v.emplace<X>( -1 ), std::runtime_error );
+        BOOST_TEST_EQ( v.index(), 2u );
+
+        X::move_throws = true;
+
+        // the move throws, reset to monostate
+        BOOST_TEST_THROWS( v.emplace<X>( 1 ), std::runtime_error );
+        BOOST_TEST_EQ( v.index(), 0u );
+
+        X::move_throws = false;
+
+        V1 w( in_place_type_t<X>(), 3 );
+
+        v = w;
+
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST_EQ( get<X>( v ).v, 3 );
+
+        v = std::move( w );
+
+        BOOST_TEST_EQ( get<X>( v ).v, 3 );
+
+        BOOST_TEST_THROWS( v.emplace<X>( -1 ), std::runtime_error );
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST_EQ( get<X>( v ).v, 3 );
+
+        // the arguments may refer to the contained value
+
+        v = v;
+
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST_EQ( get<X>( v ).v, 3 );
+
+        v.emplace<1>( get<1>( v ) );
+
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST_EQ( get<X>( v ).v, 3 );
+
+        v.emplace<X>( get<X>( v ).v + 1 );
+
+        BOOST_TEST_EQ( get<X>( v ).v, 4 );
+        BOOST_TEST_EQ( X::instances, 2 ); // v and w
+
+        v = std::string( 100, 'x' );
+        v.emplace<2>( get<2>( v ) );
+
+        BOOST_TEST_EQ( get<2>( v ), std::string( 100, 'x' ) );
+        BOOST_TEST_EQ( X::instances, 1 );
+    }
+
+    BOOST_TEST_EQ( X::instances, 0 );
+
+    {
+        V2 v( std::string( "abc" ) );
+
+        X::move_throws = true;
+        BOOST_TEST_THROWS( v.emplace<1>( 1 ), std::runtime_error );
+        X::move_throws = false;
+
+        // reset to the first nothrow default constructible alternative
+        BOOST_TEST_EQ( v.index(), 0u );
+        BOOST_TEST_EQ( get<int>( v ), 0 );
+
+        V2 w( in_place_index_t<1>(), 4 );
+
+        swap( v, w );
+
+        BOOST_TEST_EQ( v.index(), 1u );
+        BOOST_TEST_EQ( get<1>( v ).v, 4 );
+        BOOST_TEST_EQ( w.index(), 0u );
+    }
+
+    BOOST_TEST_EQ( X::instances, 0 );
+
+    {
+        V3 v( Y( 1 ) );
+
+        BOOST_TEST_EQ( v.index(), 0u );
+
+        v = 5;
+
+        BOOST_TEST_EQ( v.index(), 2u );
+
+        v.emplace<Y>( 2 );
+
+        BOOST_TEST_EQ( v.index(), 0u );
+        BOOST_TEST_EQ( get<Y>( v ).v, 2 );
+
+        BOOST_TEST_THROWS( v.emplace<Y>( -1 ), std::runtime_error );
+
+        BOOST_TEST_EQ( v.index(), 0u );
+        BOOST_TEST_EQ( get<Y>( v ).v, 2 );
+
+        v.emplace<Y>( get<Y>( v ) );
+
+        BOOST_TEST_EQ( get<Y>( v ).v, 2 );
+
+        Y::move_throws = true;
+        BOOST_TEST_THROWS( v.emplace<Y>( 3 ), std::runtime_error );
+        Y::move_throws = false;
+
+        BOOST_TEST_EQ( v.index(), 1u );
+    }
+
+    {
+        // the default double buffered layout keeps the strong guarantee
+
+        V4 v( in_place_type_t<X>(), 1 );
+
+        BOOST_TEST_THROWS( v.emplace<X>( -1 ), std::runtime_error );
+
+        BOOST_TEST_EQ( v.index(), 0u );
+        BOOST_TEST_EQ( get<X>( v ).v, 1 );
+    }
+
+    return boost::report_errors();
+}
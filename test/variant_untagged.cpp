@@ -0,0 +1,127 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/untagged_variant.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <type_traits>
+#include <string>
+#include <array>
+#include <cstdint>
+
+using namespace boost::variant2;
+
+using Q = std::array<std::uint64_t, 3>;
+
+struct record
+{
+    std::uint8_t tag;
+    std::uint8_t other;
+    untagged_variant<char, Q> value;
+};
+
+struct record2
+{
+    std::uint8_t other;
+    variant<char, Q> value;
+};
+
+struct F
+{
+    int operator()( char c ) const { return c; }
+    int operator()( Q const& q ) const { return static_cast<int>( q[ 0 ] + q[ 1 ] + q[ 2 ] ); }
+};
+
+struct F2
+{
+    std::size_t operator()( int x ) const { return static_cast<std::size_t>( x ); }
+    std::size_t operator()( std::string const& s ) const { return s.size(); }
+};
+
+struct G
+{
+    void operator()( int& x ) const { ++x; }
+    void operator()( std::string& s ) const { s += "!"; }
+};
+
+int main()
+{
+    BOOST_TEST_EQ( sizeof( untagged_variant<char, Q> ), sizeof( Q ) );
+    BOOST_TEST_LT( sizeof( record ), sizeof( record2 ) );
+
+    BOOST_TEST_TRAIT_TRUE(( std::is_trivially_copyable< untagged_variant<char, Q> > ));
+    BOOST_TEST_TRAIT_TRUE(( std::is_trivially_destructible< untagged_variant<char, Q> > ));
+
+    BOOST_TEST_TRAIT_FALSE(( std::is_copy_constructible< untagged_variant<int, std::string> > ));
+
+    {
+        record r;
+
+        r.tag = 1;
+        r.other = 7;
+        r.value.emplace<1>( Q{{ 1, 2, 3 }} );
+
+        BOOST_TEST_EQ( r.value.get<1>()[ 1 ], 2u );
+        BOOST_TEST_EQ( r.value.visit( r.tag, F() ), 6 );
+
+        record r2 = r;
+
+        BOOST_TEST_EQ( r2.value.visit( r2.tag, F() ), 6 );
+
+        r.tag = 0;
+        r.value.emplace<0>( 'a' );
+
+        BOOST_TEST_EQ( r.value.visit( r.tag, F() ), 'a' );
+
+        variant<char, Q> v = r.value.to_variant( r.tag );
+
+        BOOST_TEST_EQ( v.index(), 0u );
+        BOOST_TEST_EQ( get<0>( v ), 'a' );
+    }
+
+    {
+        using U = untagged_variant<int, std::string>;
+
+        std::size_t i = 1;
+        U u( in_place_index_t<1>(), "abc" );
+
+        BOOST_TEST_EQ( u.get<1>(), std::string( "abc" ) );
+
+        u.visit( i, G() );
+
+        U const& cu = u;
+
+        BOOST_TEST_EQ( cu.visit( i, F2() ), 4u );
+
+        U u2;
+        u2.copy_from( i, u );
+
+        BOOST_TEST_EQ( u2.get<1>(), std::string( "abc!" ) );
+
+        U u3;
+        u3.move_from( i, std::move( u2 ) );
+
+        BOOST_TEST_EQ( u3.get<1>(), std::string( "abc!" ) );
+
+        variant<int, std::string> v = u3.to_variant( i );
+
+        BOOST_TEST_EQ( get<1>( v ), std::string( "abc!" ) );
+
+        u.destroy( i );
+        u2.destroy( i );
+        u3.destroy( i );
+
+        i = 0;
+        u.emplace<0>( 5 );
+
+        u.visit( i, G() );
+
+        BOOST_TEST_EQ( u.get<0>(), 6 );
+        BOOST_TEST_EQ( u.visit( i, F2() ), 6u );
+
+        u.destroy( i );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,163 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant_vector.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+using namespace boost::variant2;
+
+struct F1
+{
+    std::vector<int>& r;
+
+    void operator()( int x ) const { r.push_back( x ); }
+    void operator()( double x ) const { r.push_back( static_cast<int>( x * 10 ) ); }
+    void operator()( std::string const& x ) const { r.push_back( static_cast<int>( x.size() ) * 100 ); }
+};
+
+struct F2
+{
+    int sum;
+
+    void operator()( int& x ) { sum += x; ++x; }
+    void operator()( float& x ) { x += 0.5f; }
+};
+
+struct Y
+{
+    static int throw_on;
+
+    int v_;
+
+    explicit Y( int v ): v_( v )
+    {
+        if( v == throw_on ) throw std::runtime_error( "Y" );
+    }
+};
+
+int Y::throw_on = -1;
+
+int main()
+{
+    {
+        variant_vector<int, double, std::string> v;
+
+        BOOST_TEST( v.empty() );
+        BOOST_TEST_EQ( v.size(), 0u );
+
+        v.push_back( 1 );
+        v.push_back( 0.5 );
+        v.push_back( std::string( "abc" ) );
+        v.push_back( 2 );
+
+        variant<int, double, std::string> const w( 1.5 );
+        v.push_back( w );
+
+        v.emplace_back<std::string>( 2, 'x' );
+        v.emplace_back<0>( 3 );
+
+        BOOST_TEST( !v.empty() );
+        BOOST_TEST_EQ( v.size(), 7u );
+
+        BOOST_TEST_EQ( v.index( 0 ), 0u );
+        BOOST_TEST_EQ( v.index( 1 ), 1u );
+        BOOST_TEST_EQ( v.index( 2 ), 2u );
+        BOOST_TEST_EQ( v.index( 3 ), 0u );
+        BOOST_TEST_EQ( v.index( 4 ), 1u );
+        BOOST_TEST_EQ( v.index( 5 ), 2u );
+        BOOST_TEST_EQ( v.index( 6 ), 0u );
+
+        BOOST_TEST_EQ( v.segment<0>().size(), 3u );
+        BOOST_TEST_EQ( v.segment<1>().size(), 2u );
+        BOOST_TEST_EQ( v.segment<2>().size(), 2u );
+
+        {
+            std::vector<int> r;
+            for_each_visit( F1{ r }, v );
+
+            std::vector<int> const expected = { 1, 2, 3, 5, 15, 300, 200 };
+            BOOST_TEST_ALL_EQ( r.begin(), r.end(), expected.begin(), expected.end() );
+        }
+
+        {
+            std::vector<int> r;
+            for_each_visit_in_order( F1{ r }, v );
+
+            std::vector<int> const expected = { 1, 5, 300, 2, 15, 200, 3 };
+            BOOST_TEST_ALL_EQ( r.begin(), r.end(), expected.begin(), expected.end() );
+        }
+
+        {
+            variant_vector<int, double, std::string> const& cv = v;
+
+            std::vector<int> r;
+            for_each_visit_in_order( F1{ r }, cv );
+
+            BOOST_TEST_EQ( r.size(), 7u );
+        }
+
+        v.clear();
+
+        BOOST_TEST( v.empty() );
+        BOOST_TEST_EQ( v.segment<0>().size(), 0u );
+        BOOST_TEST_EQ( v.segment<1>().size(), 0u );
+        BOOST_TEST_EQ( v.segment<2>().size(), 0u );
+    }
+
+    {
+        variant_vector<int, float> v;
+
+        v.reserve( 4 );
+
+        v.push_back( 1 );
+        v.push_back( 1.0f );
+        v.push_back( 2 );
+
+        F2 f{ 0 };
+        for_each_visit( f, v );
+
+        BOOST_TEST_EQ( f.sum, 3 );
+        BOOST_TEST_EQ( v.segment<0>()[ 0 ], 2 );
+        BOOST_TEST_EQ( v.segment<0>()[ 1 ], 3 );
+        BOOST_TEST_EQ( v.segment<1>()[ 0 ], 1.5f );
+    }
+
+    {
+        variant_vector<int, int> v;
+
+        v.emplace_back<1>( 1 );
+        v.emplace_back<0>( 2 );
+
+        variant<int, int> w( in_place_index_t<1>(), 3 );
+        v.push_back( std::move( w ) );
+
+        BOOST_TEST_EQ( v.index( 0 ), 1u );
+        BOOST_TEST_EQ( v.index( 1 ), 0u );
+        BOOST_TEST_EQ( v.index( 2 ), 1u );
+
+        BOOST_TEST_EQ( v.segment<0>().size(), 1u );
+        BOOST_TEST_EQ( v.segment<1>().size(), 2u );
+    }
+
+    {
+        variant_vector<int, Y> v;
+
+        v.emplace_back<Y>( 1 );
+        v.push_back( 2 );
+
+        Y::throw_on = 3;
+
+        BOOST_TEST_THROWS( v.emplace_back<Y>( 3 ), std::runtime_error );
+
+        BOOST_TEST_EQ( v.size(), 2u );
+        BOOST_TEST_EQ( v.segment<1>().size(), 1u );
+
+        Y::throw_on = -1;
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,104 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <boost/mp11.hpp>
+#include <utility>
+
+using namespace boost::variant2;
+
+template<std::size_t I> struct X
+{
+    int v;
+};
+
+struct F
+{
+    template<std::size_t I, std::size_t J> int operator()( X<I> const& x1, X<J> const& x2 ) const
+    {
+        return static_cast<int>( I * 100 + J ) * 1000 + x1.v * 10 + x2.v;
+    }
+};
+
+struct F2
+{
+    template<std::size_t I, std::size_t J> int operator()( X<I>& x1, X<J>&& x2 ) const
+    {
+        x1.v = static_cast<int>( I * 100 + J );
+        return x2.v;
+    }
+
+    template<std::size_t I, std::size_t J> int operator()( X<I> const&, X<J> const& ) const
+    {
+        return -1;
+    }
+};
+
+struct G
+{
+    template<class T1, class T2> float operator()( T1 x1, T2 x2 ) const
+    {
+        return static_cast<float>( x1 + x2 );
+    }
+};
+
+template<class V1, class V2> struct test_L1
+{
+    template<class I> void operator()( I ) const
+    {
+        boost::mp11::mp_for_each< boost::mp11::mp_iota<boost::mp11::mp_size<V2>> >( test_L3<I>() );
+    }
+
+    template<class I> struct test_L3
+    {
+        template<class J> void operator()( J ) const
+        {
+            V1 v1( in_place_index_t<I::value>(), X<I::value>{ 1 } );
+            V2 const v2( in_place_index_t<J::value>(), X<J::value>{ 2 } );
+
+            int const r = static_cast<int>( I::value * 100 + J::value ) * 1000 + 12;
+
+            BOOST_TEST_EQ( visit( F(), v1, v2 ), r );
+            BOOST_TEST_EQ( visit<long>( F(), v1, v2 ), r );
+
+            V2 v3( v2 );
+
+            BOOST_TEST_EQ( visit( F2(), v1, std::move( v3 ) ), 2 );
+            BOOST_TEST_EQ( unsafe_get<I::value>( v1 ).v, static_cast<int>( I::value * 100 + J::value ) );
+
+            BOOST_TEST_EQ( visit( F2(), v2, v2 ), -1 );
+        }
+    };
+};
+
+template<class V1, class V2> void test()
+{
+    boost::mp11::mp_for_each< boost::mp11::mp_iota<boost::mp11::mp_size<V1>> >( test_L1<V1, V2>() );
+}
+
+int main()
+{
+    using V3 = variant< X<0>, X<1>, X<2> >;
+    using V8 = variant< X<0>, X<1>, X<2>, X<3>, X<4>, X<5>, X<6>, X<7> >;
+    using V9 = variant< X<0>, X<1>, X<2>, X<3>, X<4>, X<5>, X<6>, X<7>, X<8> >;
+
+    test<V3, V8>();
+    test<V8, V3>();
+    test<V8, V8>();
+    test<V9, V9>();
+
+    {
+        variant<int, float> v1( 1 );
+        variant<int, float> v2( 2.0f );
+
+        auto r = visit( G(), v1, v2 );
+
+        BOOST_TEST_TRAIT_SAME( decltype(r), float );
+        BOOST_TEST_EQ( r, 3.0f );
+    }
+
+    return boost::report_errors();
+}
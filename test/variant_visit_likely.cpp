@@ -0,0 +1,86 @@
+// Copyright 2026 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/variant2/variant.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <string>
+#include <utility>
+
+using namespace boost::variant2;
+
+struct F
+{
+    int operator()( int x ) const { return x; }
+    int operator()( float x ) const { return static_cast<int>( x ) * 10; }
+    int operator()( std::string const& x ) const { return static_cast<int>( x.size() ) * 100; }
+    int operator()( char ) const { return -1; }
+};
+
+struct F2
+{
+    int operator()( std::string& x ) const { x += '!'; return 1; }
+    int operator()( std::string&& x ) const { std::string y( std::move( x ) ); return 2; }
+    template<class T> int operator()( T const& ) const { return 0; }
+};
+
+struct G
+{
+    template<class T> T operator()( T const& x ) const { return x; }
+};
+
+int main()
+{
+    using V = variant<int, float, std::string, char>;
+
+    {
+        V v1( 1 ), v2( 2.0f ), v3( "abc" ), v4( 'x' );
+
+        BOOST_TEST_EQ( visit_likely<>( F(), v1 ), 1 );
+        BOOST_TEST_EQ( visit_likely<>( F(), v2 ), 20 );
+
+        BOOST_TEST_EQ( visit_likely<0>( F(), v1 ), 1 );
+        BOOST_TEST_EQ( visit_likely<0>( F(), v2 ), 20 );
+        BOOST_TEST_EQ( visit_likely<0>( F(), v3 ), 300 );
+        BOOST_TEST_EQ( visit_likely<0>( F(), v4 ), -1 );
+
+        BOOST_TEST_EQ( (visit_likely<2, 1>( F(), v1 )), 1 );
+        BOOST_TEST_EQ( (visit_likely<2, 1>( F(), v2 )), 20 );
+        BOOST_TEST_EQ( (visit_likely<2, 1>( F(), v3 )), 300 );
+        BOOST_TEST_EQ( (visit_likely<2, 1>( F(), v4 )), -1 );
+
+        BOOST_TEST_EQ( (visit_likely<3, 2, 1, 0>( F(), v1 )), 1 );
+        BOOST_TEST_EQ( (visit_likely<3, 2, 1, 0>( F(), v4 )), -1 );
+
+        V const& cv3 = v3;
+        BOOST_TEST_EQ( visit_likely<2>( F(), cv3 ), 300 );
+    }
+
+    {
+        V v( "abc" );
+
+        BOOST_TEST_EQ( visit_likely<2>( F2(), v ), 1 );
+        BOOST_TEST_EQ( get<2>( v ), std::string( "abc!" ) );
+
+        BOOST_TEST_EQ( visit_likely<2>( F2(), std::move( v ) ), 2 );
+        BOOST_TEST_EQ( get<2>( v ), std::string() );
+
+        V w( 5 );
+        BOOST_TEST_EQ( visit_likely<2>( F2(), w ), 0 );
+    }
+
+    {
+        variant<int, float> v( 1.5f );
+
+        BOOST_TEST_TRAIT_SAME( decltype( visit_likely<1>( F(), v ) ), int );
+        BOOST_TEST_TRAIT_SAME( decltype( visit_likely<long, 1>( F(), v ) ), long );
+        BOOST_TEST_TRAIT_SAME( decltype( visit_likely<double, 0, 1>( G(), v ) ), double );
+
+        BOOST_TEST_EQ( (visit_likely<long, 1>( F(), v )), 10L );
+        BOOST_TEST_EQ( (visit_likely<double, 0>( G(), v )), 1.5 );
+        BOOST_TEST_EQ( (visit_likely<double, 1>( G(), v )), 1.5 );
+    }
+
+    return boost::report_errors();
+}